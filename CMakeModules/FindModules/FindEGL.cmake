@@ -0,0 +1,4 @@
+SET (WANTED_MODULE_NAME     EGL)
+SET (WANTED_INCLUDES        EGL/egl.h)
+SET (WANTED_LIBRARIES       EGL)
+INCLUDE (FindCommonModule)
@@ -28,6 +28,10 @@ ELSE (SIMPLE_GL_ANDROID)
 	OPTION_DEPENDENT_ON_PACKAGE (SIMPLE_GL_USE_DEVIL "Set to ON to build SimpleGL using DevIL library." DEVIL_FOUND)
 	MESSAGE ("Use DevIL: " ${SIMPLE_GL_USE_DEVIL})
 
+	# offscreen devices
+	OPTION_DEPENDENT_ON_PACKAGE (SIMPLE_GL_USE_EGL "Set to ON to allow creating offscreen devices without X server through EGL." EGL_FOUND)
+	MESSAGE ("Use EGL: " ${SIMPLE_GL_USE_EGL})
+
 	# check settings
 	IF (NOT SDL_FOUND AND BUILD_EXAMPLES)
 		MESSAGE (FATAL_ERROR "Can't build examples without SDL.") 
@@ -63,6 +67,10 @@ ELSE (SIMPLE_GL_ANDROID)
 
 ENDIF (SIMPLE_GL_ANDROID)
 
+# per frame counters of the gl calls
+OPTION (SIMPLE_GL_FRAME_STATISTICS "Set to ON to collect per frame statistics of the draw calls, binds and uploads" OFF)
+MESSAGE ("Collect frame statistics: " ${SIMPLE_GL_FRAME_STATISTICS})
+
 # check settings
 IF (BUILD_EXAMPLES AND NOT SDL_FOUND AND NOT SIMPLE_GL_ANDROID)
 	MESSAGE (FATAL_ERROR "Examples can't be built without SDL library on PC.") 
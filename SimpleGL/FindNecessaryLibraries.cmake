@@ -5,6 +5,7 @@ ELSE (SIMPLE_GL_ANDROID)
 	FIND_PACKAGE (SDL)
 	FIND_PACKAGE (SDL_image)
 	FIND_PACKAGE (DevIL)
+	FIND_PACKAGE (EGL)
 
 	SET(GLEW_USE_STATIC_LIB OFF)
 	FIND_PACKAGE (Glew      REQUIRED)
@@ -186,7 +186,7 @@ void CreateJuliaScene()
         int posLoc = juliaProgram->AttributeLocation("vp_position");
         VertexLayout::ELEMENT elements[] =
         {
-            {posLoc, 2, 0, 8, FLOAT, VertexLayout::ATTRIBUTE},
+            {posLoc, 2, 0, 8, FLOAT, VertexLayout::ATTRIBUTE, false, false},
         };
         vertexLayout.reset( device->CreateVertexLayout(1, elements) );
     }
@@ -235,7 +235,7 @@ void CreateTailorScene()
         int posLoc = tailorProgram->AttributeLocation("vp_position");
         VertexLayout::ELEMENT elements[] =
         {
-            {posLoc, 2, 0, 8, FLOAT, VertexLayout::ATTRIBUTE},
+            {posLoc, 2, 0, 8, FLOAT, VertexLayout::ATTRIBUTE, false, false},
         };
         vertexLayout.reset( device->CreateVertexLayout(1, elements) );
 
@@ -63,7 +63,7 @@ GUICube::GUICube(sgl::Device* device)
     {
         sgl::VertexLayout::ELEMENT elements[] =
         {
-            {0, 3, 0, 12, sgl::FLOAT, sgl::VertexLayout::VERTEX},
+            {0, 3, 0, 12, sgl::FLOAT, sgl::VertexLayout::VERTEX, false, false},
         };
 
         vlayout.reset( device->CreateVertexLayout(1, elements) );
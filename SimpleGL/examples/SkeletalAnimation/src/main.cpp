@@ -5,6 +5,7 @@
 #include "SDL.h"
 #include "SDL_main.h"
 #include <GL/glew.h>
+#include <cstring>
 #include <sstream>
 
 bool	working;
@@ -137,10 +138,10 @@ public:
             {
                 VertexLayout::ELEMENT elements[4] =
                 {
-                    {0, 4, 0,  64, FLOAT, VertexLayout::ATTRIBUTE},
-                    {1, 4, 16, 64, FLOAT, VertexLayout::ATTRIBUTE},
-                    {2, 4, 32, 64, FLOAT, VertexLayout::ATTRIBUTE},
-                    {3, 4, 48, 64, FLOAT, VertexLayout::ATTRIBUTE}
+                    {0, 4, 0,  64, FLOAT, VertexLayout::ATTRIBUTE, false, false},
+                    {1, 4, 16, 64, FLOAT, VertexLayout::ATTRIBUTE, false, false},
+                    {2, 4, 32, 64, FLOAT, VertexLayout::ATTRIBUTE, false, false},
+                    {3, 4, 48, 64, FLOAT, VertexLayout::ATTRIBUTE, false, false}
                 };
                 vertexLayout.reset( device->CreateVertexLayout(4, elements) );
             }
@@ -152,12 +153,18 @@ public:
             {
                 VertexLayout::ELEMENT elements[1] =
                 {
-                    {0, 3, 0, 12, FLOAT, VertexLayout::VERTEX}
+                    {0, 3, 0, 12, FLOAT, VertexLayout::VERTEX, false, false}
                 };
                 skeletonVertexLayout.reset( device->CreateVertexLayout(1, elements) );
             }
 
             skeletonVertexBuffer.reset( device->CreateVertexBuffer() );
+
+            // bones are updated every frame, stream them without waiting for the GPU
+            StreamingBuffer::DESC desc;
+            desc.size       = 3 * 64 * 1024;
+            desc.numRegions = 3;
+            skeletonStream.reset( device->CreateStreamingBuffer(skeletonVertexBuffer.get(), desc) );
         }
 
         // create programs
@@ -274,11 +281,19 @@ public:
         {
             mvpMatrixUniform[1]->Set(mvpMatrix);
             colorUniform[1]->Set( math::Vector4f(1.0f, 1.0f, 0.0f, 1.0f) );
-            skeletonVertexBuffer->SetData(boneOrigins.size() * sizeof(math::Vector3f), &boneOrigins[0].x);
-            skeletonVertexBuffer->Bind( skeletonVertexLayout.get() );
-            device->Draw( LINE_STRIP, 0, boneOrigins.size() );
+            unsigned size   = boneOrigins.size() * sizeof(math::Vector3f);
+            unsigned offset = 0;
+            if ( void* data = skeletonStream->Allocate(size, sizeof(math::Vector3f), offset) )
+            {
+                memcpy(data, &boneOrigins[0].x, size);
+                skeletonStream->Commit();
+
+                skeletonVertexBuffer->Bind( skeletonVertexLayout.get() );
+                device->Draw( LINE_STRIP, offset / sizeof(math::Vector3f), boneOrigins.size() );
+            }
         }
         transformProgram->Unbind();
+        skeletonStream->EndFrame();
     }
 
 private:
@@ -304,6 +319,7 @@ private:
     ref_ptr<VertexBuffer>   vertexBuffer;
     ref_ptr<VertexLayout>   skeletonVertexLayout;
     ref_ptr<VertexBuffer>   skeletonVertexBuffer;
+    ref_ptr<StreamingBuffer> skeletonStream;
 
     // setrtings
     float                   length;
@@ -1,7 +1,7 @@
 #ifndef SIMPLE_GL_BUFFER_H
 #define SIMPLE_GL_BUFFER_H
 
-#include "Resource.h"
+#include "ReadbackRequest.h"
 
 namespace sgl {
 
@@ -32,6 +32,15 @@ public:
     #endif
 	};
 
+    /// Strategy of updating buffer which may still be used by the GPU
+    enum UPDATE_POLICY
+    {
+        UPDATE_IN_PLACE,        /// update storage in place, driver may stall or shadow copy the data
+        UPDATE_ORPHAN,          /// allocate new storage on updates of the whole buffer, partial updates are in place
+        UPDATE_ROUND_ROBIN,     /// switch to the next of several storages on every update, buffer must be rebound after update
+        UPDATE_UNSYNCHRONIZED   /// write without synchronization if the GPU finished frames using the buffer, orphan otherwise
+    };
+
 public:
 #ifndef SIMPLE_GL_ES
     /** Gain access to the buffer data. Force buffer to be binded.
@@ -68,6 +77,9 @@ public:
     /** Get buffer usage */
     virtual USAGE SGL_DLLCALL Usage() const = 0;
 
+    /** Get policy applied by the SetSubData and write mapping of the buffer */
+    virtual UPDATE_POLICY SGL_DLLCALL UpdatePolicy() const = 0;
+
     /** Send data in the GPU buffer.
      * @param dataSize - size of the data
      * @param data - data to store in the buffer
@@ -98,6 +110,14 @@ public:
                                              unsigned int  offset,
                                              unsigned int  dataSize ) const = 0;
 
+    /** Start asynchronous readback of the buffer data.
+     * @param offset - offset from the beginning of the buffer for retrieving data.
+     * @param dataSize - size of the buffer chunk for retrieving.
+     * @return readback request or 0 if pixel buffer objects are not supported.
+     */
+    virtual ReadbackRequest* SGL_DLLCALL Readback( unsigned int  offset,
+                                                   unsigned int  dataSize ) const = 0;
+
     /** Copy content of the buffer to another buffer. Resize target buffer to the size of this buffer.
      * @param target - buffer where to copy data.
      * @return the result of the operation. Can be SGLERR_OUT_OF_VIDEO_MEMORY if can't allocate
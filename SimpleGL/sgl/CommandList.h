@@ -0,0 +1,153 @@
+#ifndef SIMPLE_GL_COMMAND_LIST_H
+#define SIMPLE_GL_COMMAND_LIST_H
+
+#include "BlendState.h"
+#include "DepthStencilState.h"
+#include "RasterizerState.h"
+#include "Program.h"
+#include "RenderTarget.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+
+namespace sgl {
+
+/** Command list records device commands into memory stream, so they can be
+ * executed later using Device::Execute. Recording doesn't touch the graphics
+ * context, therefore command list could be filled from any thread, but one list
+ * must not be recorded from several threads simultaneously. Recorded objects are
+ * not referenced, user must keep them alive until the list is executed.
+ */
+class CommandList :
+    public Resource
+{
+public:
+    // ============================ STATES ============================ //
+
+    /** Record BlendState::Bind */
+    virtual void SGL_DLLCALL BindBlendState(const BlendState* blendState) = 0;
+
+    /** Record DepthStencilState::Bind */
+    virtual void SGL_DLLCALL BindDepthStencilState(const DepthStencilState* depthStencilState) = 0;
+
+    /** Record RasterizerState::Bind */
+    virtual void SGL_DLLCALL BindRasterizerState(const RasterizerState* rasterizerState) = 0;
+
+    /** Record Program::Bind. If program is 0 records unbind of the current program. */
+    virtual void SGL_DLLCALL BindProgram(const Program* program) = 0;
+
+    /** Record Texture::Bind
+     * @param stage - texture stage.
+     * @param texture - texture to bind. If 0 records unbind of the texture bound to the stage.
+     */
+    virtual void SGL_DLLCALL BindTexture(unsigned int stage, const Texture* texture) = 0;
+
+    /** Record VertexBuffer::Bind. If vertex buffer is 0 records unbind of the current vertex buffer. */
+    virtual void SGL_DLLCALL BindVertexBuffer(const VertexBuffer* vertexBuffer, const VertexLayout* vertexLayout) = 0;
+
+    /** Record IndexBuffer::Bind. If index buffer is 0 records unbind of the current index buffer. */
+    virtual void SGL_DLLCALL BindIndexBuffer(const IndexBuffer* indexBuffer, IndexBuffer::INDEX_TYPE format) = 0;
+
+    /** Record RenderTarget::Bind. If render target is 0 records unbind of the current render target. */
+    virtual void SGL_DLLCALL BindRenderTarget(const RenderTarget* renderTarget) = 0;
+
+    /** Record Device::SetViewport */
+    virtual void SGL_DLLCALL SetViewport(const rectangle& vp) = 0;
+
+    // ============================ DATA ============================ //
+
+    /** Record Uniform::Set. Values are copied into the command list.
+     * @param uniform - uniform to setup, must not be sampler uniform.
+     * @param values - array of uniform values of the uniform type.
+     * @param count - number of values in the array.
+     */
+    virtual void SGL_DLLCALL SetUniform( AbstractUniform* uniform,
+                                         const void*      values,
+                                         unsigned int     count ) = 0;
+
+    /** Record SamplerUniform::Set.
+     * @param uniform - sampler uniform to setup.
+     * @param stage - texture stage.
+     * @param texture - texture to setup, must match sampler type. Can be 0.
+     */
+    virtual void SGL_DLLCALL SetSamplerUniform( AbstractUniform* uniform,
+                                                unsigned int     stage,
+                                                const Texture*   texture ) = 0;
+
+    /** Record Buffer::SetSubData. Data is copied into the command list.
+     * @param buffer - buffer to update.
+     * @param offset - offset in the buffer in bytes.
+     * @param dataSize - size of the data in bytes.
+     * @param data - data to copy into the buffer.
+     */
+    virtual void SGL_DLLCALL SetBufferSubData( Buffer*         buffer,
+                                               unsigned int    offset,
+                                               unsigned int    dataSize,
+                                               const void*     data ) = 0;
+
+    // ============================ DRAW ============================ //
+
+    /** Record Device::Draw */
+    virtual void SGL_DLLCALL Draw( PRIMITIVE_TYPE primType,
+                                   unsigned       firstVertex,
+                                   unsigned       numVertices ) = 0;
+
+    /** Record Device::DrawIndexed */
+    virtual void SGL_DLLCALL DrawIndexed( PRIMITIVE_TYPE primType,
+                                          unsigned       firstIndex,
+                                          unsigned       numIndices ) = 0;
+
+#ifndef SIMPLE_GL_ES
+    /** Record Device::DrawInstanced */
+    virtual void SGL_DLLCALL DrawInstanced( PRIMITIVE_TYPE primType,
+                                            unsigned       firstVertex,
+                                            unsigned       numVertices,
+                                            unsigned       numInstances ) = 0;
+
+    /** Record Device::DrawIndexedInstanced */
+    virtual void SGL_DLLCALL DrawIndexedInstanced( PRIMITIVE_TYPE primType,
+                                                   unsigned       firstIndex,
+                                                   unsigned       numIndices,
+                                                   unsigned       numInstances ) = 0;
+#endif // !defined(SIMPLE_GL_ES)
+
+    /** Record Device::Clear */
+    virtual void SGL_DLLCALL Clear(bool colorBuffer = true, bool depthBuffer = true, bool stencilBuffer = true) = 0;
+
+    // ============================ OTHER ============================ //
+
+    /** Remove all recorded commands. Allocated memory is kept for the next recording. */
+    virtual void SGL_DLLCALL Reset() = 0;
+
+    /** Get number of recorded commands. */
+    virtual unsigned int SGL_DLLCALL NumCommands() const = 0;
+
+    /** Get size of the recorded command stream in bytes. */
+    virtual unsigned int SGL_DLLCALL Size() const = 0;
+
+    virtual ~CommandList() {}
+};
+
+/** Record uniform setup */
+template<typename T>
+inline void SetUniform(CommandList& commandList, Uniform<T>* uniform, const T& value)
+{
+    commandList.SetUniform(uniform, &value, 1);
+}
+
+/** Record uniform array setup */
+template<typename T>
+inline void SetUniform(CommandList& commandList, Uniform<T>* uniform, const T* values, unsigned int count)
+{
+    commandList.SetUniform(uniform, values, count);
+}
+
+/** Record sampler uniform setup */
+template<typename T>
+inline void SetUniform(CommandList& commandList, SamplerUniform<T>* uniform, unsigned int stage, const T* texture)
+{
+    commandList.SetSamplerUniform(uniform, stage, texture);
+}
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_COMMAND_LIST_H
@@ -20,6 +20,8 @@
 #cmakedefine SIMPLE_GL_ANDROID
 #cmakedefine SIMPLE_GL_USE_SDL_IMAGE
 #cmakedefine SIMPLE_GL_USE_DEVIL
+#cmakedefine SIMPLE_GL_USE_EGL
+#cmakedefine SIMPLE_GL_FRAME_STATISTICS
 #cmakedefine SIMPLE_GL_USE_SSE2
 #cmakedefine SIMPLE_GL_USE_SSE3
 #cmakedefine SIMPLE_GL_USE_SSE4
@@ -4,6 +4,7 @@
 #include <memory>
 #include <cassert>
 #include "BlendState.h"
+#include "CommandList.h"
 #include "DepthStencilState.h"
 #include "RasterizerState.h"
 #include "SamplerState.h"
@@ -12,12 +13,16 @@
 #include "State.h"
 #include "Shader.h"
 #include "Program.h"
+#include "Query.h"
+#include "StreamingBuffer.h"
+#include "StreamOut.h"
 #include "FFPProgram.h"
 #include "Font.h"
 #include "Image.h"
 #include "Texture1D.h"
 #include "Texture2D.h"
 #include "Texture3D.h"
+#include "TextureBuffer.h"
 #include "TextureCube.h"
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
@@ -47,6 +52,9 @@ struct device_traits<DV_OPENGL_1_3>
 	static const bool support_display_lists			= true;
     static const bool support_render_target			= false;
     static const bool support_buffer_copies			= false;
+    static const bool support_multi_draw			= false;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 template<>
@@ -60,6 +68,9 @@ struct device_traits<DV_OPENGL_1_4>
 	static const bool support_display_lists			= true;
     static const bool support_render_target			= false;
     static const bool support_buffer_copies			= false;
+    static const bool support_multi_draw			= true;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 template<>
@@ -73,6 +84,9 @@ struct device_traits<DV_OPENGL_1_5>
 	static const bool support_display_lists			= true;
     static const bool support_render_target			= false;
     static const bool support_buffer_copies			= false;
+    static const bool support_multi_draw			= true;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 template<>
@@ -86,6 +100,9 @@ struct device_traits<DV_OPENGL_2_0>
 	static const bool support_display_lists			= true;
     static const bool support_render_target			= true;
     static const bool support_buffer_copies			= false;
+    static const bool support_multi_draw			= true;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 template<>
@@ -99,6 +116,9 @@ struct device_traits<DV_OPENGL_2_1>
 	static const bool support_display_lists			= true;
     static const bool support_render_target			= true;
     static const bool support_buffer_copies			= false;
+    static const bool support_multi_draw			= true;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 template<>
@@ -112,6 +132,9 @@ struct device_traits<DV_OPENGL_3_0>
 	static const bool support_display_lists			= false;
     static const bool support_render_target			= true;
     static const bool support_buffer_copies			= false;
+    static const bool support_multi_draw			= true;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 template<>
@@ -125,6 +148,9 @@ struct device_traits<DV_OPENGL_3_1>
 	static const bool support_display_lists			= false;
     static const bool support_render_target			= true;
     static const bool support_buffer_copies			= true;
+    static const bool support_multi_draw			= true;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 template<>
@@ -138,6 +164,9 @@ struct device_traits<DV_OPENGL_3_2>
 	static const bool support_display_lists			= false;
     static const bool support_render_target			= true;
     static const bool support_buffer_copies			= true;
+    static const bool support_multi_draw			= true;
+    static const bool support_base_vertex			= true;
+    static const bool support_draw_indirect			= false;
 };
 
 #else // SIMPLE_GL_ES
@@ -153,6 +182,9 @@ struct device_traits<DV_OPENGL_ES_1_0>
     static const bool support_display_lists			= false;
     static const bool support_render_target			= true;
     static const bool support_buffer_copies			= false;
+    static const bool support_multi_draw			= false;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 template<>
@@ -166,6 +198,9 @@ struct device_traits<DV_OPENGL_ES_1_1>
     static const bool support_display_lists			= false;
     static const bool support_render_target			= true;
     static const bool support_buffer_copies			= false;
+    static const bool support_multi_draw			= false;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 template<>
@@ -179,6 +214,9 @@ struct device_traits<DV_OPENGL_ES_2_0>
     static const bool support_display_lists			= false;
     static const bool support_render_target			= true;
     static const bool support_buffer_copies			= false;
+    static const bool support_multi_draw			= false;
+    static const bool support_base_vertex			= false;
+    static const bool support_draw_indirect			= false;
 };
 
 #endif // SIMPLE_GL_ES
@@ -197,6 +235,7 @@ public:
         bool            vsync;              /// wait for vsync
         Texture::FORMAT colorBufferFormat;  /// back buffer format
         Texture::FORMAT dsBufferFormat;     /// depth stencil buffer format
+        bool            offscreen;          /// (Linux, requires SIMPLE_GL_USE_EGL) render into offscreen framebuffer without window and X server
 
         VIDEO_DESC() :
             width(0),
@@ -205,7 +244,8 @@ public:
             fullscreen(false),
             vsync(false),
             colorBufferFormat(Texture::RGBA8),
-            dsBufferFormat(Texture::D24S8)
+            dsBufferFormat(Texture::D24S8),
+            offscreen(false)
         {}
     };
 
@@ -215,6 +255,61 @@ public:
         NUM_TEXTURE_STAGES  = 16
     };
 
+    /// How GL errors are detected. Has no effect if SimpleGL is built with SGL_NO_STATUS_CHECK.
+    enum VALIDATION_MODE
+    {
+        VALIDATION_DISABLED,        /// GL errors are not checked
+        VALIDATION_GET_ERROR,       /// glGetError is polled after GL calls, each poll may stall the pipeline
+        VALIDATION_DEBUG_OUTPUT     /// GL errors are reported through the debug output (KHR_debug, ARB_debug_output) callback
+    };
+
+#ifndef SIMPLE_GL_ES
+    /// Layout of the command for DrawIndirect and MultiDrawIndirect in the buffer
+    struct DRAW_INDIRECT_COMMAND
+    {
+        unsigned int    numVertices;
+        unsigned int    numInstances;
+        unsigned int    firstVertex;
+        unsigned int    baseInstance;       /// must be 0 if indirect draws are emulated
+    };
+
+    /// Layout of the command for DrawIndexedIndirect and MultiDrawIndexedIndirect in the buffer
+    struct DRAW_INDEXED_INDIRECT_COMMAND
+    {
+        unsigned int    numIndices;
+        unsigned int    numInstances;
+        unsigned int    firstIndex;
+        int             baseVertex;
+        unsigned int    baseInstance;       /// must be 0 if indirect draws are emulated
+    };
+#endif // !defined(SIMPLE_GL_ES)
+
+    /// Counters of the work submitted to GL during the frame. Collected only if SimpleGL is built with SIMPLE_GL_FRAME_STATISTICS.
+    struct FRAME_STATISTICS
+    {
+        unsigned int        numDrawCalls;       /// number of GL draw calls, emulated multi draws are counted per draw
+        unsigned long long  numPrimitives;      /// number of primitives passed to the draw calls, unknown for indirect draws
+        unsigned int        numProgramBinds;
+        unsigned int        numTextureBinds;
+        unsigned int        numStateBinds;      /// blend, depth stencil and rasterizer state binds
+        unsigned int        numUniformCalls;    /// glUniform* calls
+        unsigned long long  numBytesUploaded;   /// bytes passed to buffer and texture SetData/SetSubData
+        unsigned int        numGetQueries;      /// glGet* calls stalling the pipeline
+        unsigned int        numStallsAvoided;   /// buffer updates which skipped synchronization with the GPU due to the update policy
+
+        FRAME_STATISTICS() :
+            numDrawCalls(0),
+            numPrimitives(0),
+            numProgramBinds(0),
+            numTextureBinds(0),
+            numStateBinds(0),
+            numUniformCalls(0),
+            numBytesUploaded(0),
+            numGetQueries(0),
+            numStallsAvoided(0)
+        {}
+    };
+
 public:
     /** Take screenshot of the device
      * @param image - image to store screenshot. Image is stored using back buffer format.
@@ -309,21 +404,135 @@ public:
                                                               unsigned       numInstances ) const = 0;
 #endif // !defined(SIMPLE_GL_ES)
 
+    /** Draw several ranges of vertices using one call. Emulated by the loop if multi draw is not supported. 
+     * Semantic is the following:
+     * \code
+     * for(int i=0; i<numDraws; i++) {
+     *     Draw(primType, firstVertices[i], numVertices[i]);
+     * }
+     * \uncode
+     * @param primType - type of the primitives.
+     * @param firstVertices - offsets in the vertex buffer to fetch vertices for every range.
+     * @param numVertices - number of vertices in every range.
+     * @param numDraws - number of ranges.
+     */
+    virtual void            SGL_DLLCALL MultiDraw( PRIMITIVE_TYPE   primType,
+                                                   const unsigned*  firstVertices,
+                                                   const unsigned*  numVertices,
+                                                   unsigned         numDraws ) const = 0;
+
+    /** Draw several ranges of indices using one call. Emulated by the loop if multi draw is not supported.
+     * Semantic is the following:
+     * \code
+     * for(int i=0; i<numDraws; i++) {
+     *     DrawIndexed(primType, firstIndices[i], numIndices[i]);
+     * }
+     * \uncode
+     * @param primType - type of the primitives.
+     * @param firstIndices - first index of every range.
+     * @param numIndices - number of indices in every range.
+     * @param numDraws - number of ranges.
+     */
+    virtual void            SGL_DLLCALL MultiDrawIndexed( PRIMITIVE_TYPE   primType,
+                                                          const unsigned*  firstIndices,
+                                                          const unsigned*  numIndices,
+                                                          unsigned         numDraws ) const = 0;
+
+#ifndef SIMPLE_GL_ES
+    /** (N/A in GLES). Draw vertices indexed, baseVertex is added to every index before fetching vertex.
+     * Allows drawing several meshes packed into one vertex buffer without rebasing their indices.
+     * Nonzero base vertex sets SGLERR_UNSUPPORTED error if neither GL 3.2 nor ARB_draw_elements_base_vertex is available.
+     * @param primType - type of the primitives.
+     * @param firstIndex - first index for primitive construction.
+     * @param numIndices - number of indices for primitive construction.
+     * @param baseVertex - value added to every index.
+     */
+    virtual void            SGL_DLLCALL DrawIndexedBaseVertex( PRIMITIVE_TYPE primType,
+                                                               unsigned       firstIndex,
+                                                               unsigned       numIndices,
+                                                               int            baseVertex ) const = 0;
+
+    /** (N/A in GLES). MultiDrawIndexed with base vertex for every range. See DrawIndexedBaseVertex. */
+    virtual void            SGL_DLLCALL MultiDrawIndexedBaseVertex( PRIMITIVE_TYPE   primType,
+                                                                    const unsigned*  firstIndices,
+                                                                    const unsigned*  numIndices,
+                                                                    const int*       baseVertices,
+                                                                    unsigned         numDraws ) const = 0;
+
+    /** (N/A in GLES). Draw vertices with parameters stored in the buffer as DRAW_INDIRECT_COMMAND. If indirect
+     * draws are not supported, command is read back from the buffer and drawn using DrawInstanced.
+     * @param primType - type of the primitives.
+     * @param buffer - buffer with the command.
+     * @param offset - offset of the command in the buffer in bytes.
+     */
+    virtual void            SGL_DLLCALL DrawIndirect( PRIMITIVE_TYPE primType,
+                                                      const Buffer*  buffer,
+                                                      unsigned       offset ) const = 0;
+
+    /** (N/A in GLES). Draw vertices indexed with parameters stored in the buffer as DRAW_INDEXED_INDIRECT_COMMAND.
+     * See DrawIndirect.
+     */
+    virtual void            SGL_DLLCALL DrawIndexedIndirect( PRIMITIVE_TYPE primType,
+                                                             const Buffer*  buffer,
+                                                             unsigned       offset ) const = 0;
+
+    /** (N/A in GLES). Perform several DrawIndirect calls for the commands stored in the buffer.
+     * @param primType - type of the primitives.
+     * @param buffer - buffer with the commands.
+     * @param offset - offset of the first command in the buffer in bytes.
+     * @param numDraws - number of commands.
+     * @param stride - distance between commands in bytes, 0 means commands are tightly packed.
+     */
+    virtual void            SGL_DLLCALL MultiDrawIndirect( PRIMITIVE_TYPE primType,
+                                                           const Buffer*  buffer,
+                                                           unsigned       offset,
+                                                           unsigned       numDraws,
+                                                           unsigned       stride = 0 ) const = 0;
+
+    /** (N/A in GLES). Perform several DrawIndexedIndirect calls for the commands stored in the buffer.
+     * See MultiDrawIndirect.
+     */
+    virtual void            SGL_DLLCALL MultiDrawIndexedIndirect( PRIMITIVE_TYPE primType,
+                                                                  const Buffer*  buffer,
+                                                                  unsigned       offset,
+                                                                  unsigned       numDraws,
+                                                                  unsigned       stride = 0 ) const = 0;
+#endif // !defined(SIMPLE_GL_ES)
+
     /** Clear framebuffer | depth buffer | stencil buffer. */
     virtual void            SGL_DLLCALL Clear(bool colorBuffer = true, bool depthBuffer = true, bool stencilBuffer = true) const = 0;
 
+    /** Replay commands recorded into the command list. Must be called from the thread owning device.
+     * @param commandList - list to execute. List is not modified, so it could be executed several times.
+     * @return result of the operation. Stops on the first failed command.
+     */
+    virtual SGL_HRESULT     SGL_DLLCALL Execute(const CommandList* commandList) = 0;
+
 #ifndef __ANDROID__
     /** Swap back & front buffers. N/A on Anroid, override GLSurfaceView.Renderer.onDrawFrame(...) in jave code. */
     virtual void            SGL_DLLCALL SwapBuffers() const = 0;
 #endif
 
+    /** Get statistics of the frame in progress. Statistics are reset by SwapBuffers, all counters are
+     * zero if SimpleGL is built without SIMPLE_GL_FRAME_STATISTICS.
+     */
+    virtual const FRAME_STATISTICS& SGL_DLLCALL FrameStatistics() const = 0;
+
+    /** Get statistics of the last frame finished by SwapBuffers or ResetFrameStatistics. */
+    virtual const FRAME_STATISTICS& SGL_DLLCALL LastFrameStatistics() const = 0;
+
+    /** Finish statistics of the current frame, e.g. on Android where SwapBuffers is not available. */
+    virtual void            SGL_DLLCALL ResetFrameStatistics() = 0;
+
     // ============================ TEXTURES ============================ //
 
     /** Create generic image */
     virtual Image*              SGL_DLLCALL CreateImage() = 0;
 
-    /** Create texture buffer*/
-    //virtual TextureBuffer*      SGL_DLLCALL CreateTextureBuffer(const Texture::TEXTURE_BUFFER_DESC& desc) = 0;
+    /** Create texture buffer. Buffer of the description may be 0 and set later. N/A in GLES.
+     * @return created texture buffer or 0 if texture buffers are not supported or description is invalid.
+     */
+    virtual TextureBuffer*      SGL_DLLCALL CreateTextureBuffer(const TextureBuffer::DESC& desc) = 0;
   
     /** Create 1d texture */
     //virtual Texture1D*          SGL_DLLCALL CreateTexture1D(const Texture::TEXTURE_1D_DESC& desc) = 0;
@@ -345,18 +554,33 @@ public:
 
     // ============================ BUFFERS ============================ //
 
-    /** Create layout of vertex buffer. */
+    /** Create layout of vertex buffer.
+     * @return created layout or 0 if format of some element is invalid or unsupported.
+     */
     virtual VertexLayout*       SGL_DLLCALL CreateVertexLayout( unsigned int                 numElements, 
                                                                 const VertexLayout::ELEMENT* elements ) = 0;
 
-    /** Create vertex buffer object. */
-    virtual VertexBuffer*       SGL_DLLCALL CreateVertexBuffer() = 0;
+    /** Create vertex buffer object.
+     * @param policy - policy of the buffer updates.
+     * @param numBuffers - number of storages for the UPDATE_ROUND_ROBIN policy.
+     */
+    virtual VertexBuffer*       SGL_DLLCALL CreateVertexBuffer( Buffer::UPDATE_POLICY policy = Buffer::UPDATE_IN_PLACE,
+                                                                unsigned              numBuffers = 3 ) = 0;
 
-    /** Create index buffer object. */
-    virtual IndexBuffer*        SGL_DLLCALL CreateIndexBuffer() = 0;
+    /** Create index buffer object.
+     * @param policy - policy of the buffer updates.
+     * @param numBuffers - number of storages for the UPDATE_ROUND_ROBIN policy.
+     */
+    virtual IndexBuffer*        SGL_DLLCALL CreateIndexBuffer( Buffer::UPDATE_POLICY policy = Buffer::UPDATE_IN_PLACE,
+                                                               unsigned              numBuffers = 3 ) = 0;
 
-    /** Create uniform buffer object. */
-    //virtual UniformBuffer*      SGL_DLLCALL CreateUniformBuffer() = 0;
+    /** Create uniform buffer object. N/A in GLES.
+     * @param policy - policy of the buffer updates.
+     * @param numBuffers - number of storages for the UPDATE_ROUND_ROBIN policy.
+     * @return created buffer or 0 if uniform buffers are not supported.
+     */
+    virtual UniformBuffer*      SGL_DLLCALL CreateUniformBuffer( Buffer::UPDATE_POLICY policy = Buffer::UPDATE_IN_PLACE,
+                                                                 unsigned              numBuffers = 3 ) = 0;
 
     // ============================ STATES ============================ //
 
@@ -414,11 +638,45 @@ public:
     /** Create render target. */
     virtual RenderTarget*   SGL_DLLCALL CreateRenderTarget() = 0;
 
+    /** Create command list for the deferred command recording. */
+    virtual CommandList*    SGL_DLLCALL CreateCommandList() = 0;
+
+    /** Create asynchronous query.
+     * @return pointer to query object or 0 if query type is not supported.
+     */
+    virtual Query*          SGL_DLLCALL CreateQuery(const Query::DESC& desc) = 0;
+
+    /** Create streaming buffer over the buffer. Buffer storage is reallocated, buffer
+     * must not be resized while it is used by the streaming buffer.
+     * @return pointer to streaming buffer or 0 if buffer is not created by this device
+     * or its update policy is not UPDATE_IN_PLACE.
+     */
+    virtual StreamingBuffer* SGL_DLLCALL CreateStreamingBuffer(Buffer* buffer, const StreamingBuffer::DESC& desc) = 0;
+
+    /** Create stream output capturing varyings of the programs into vertex buffers.
+     * @return pointer to stream output or 0 if stream output is not supported. N/A in GLES.
+     */
+    virtual StreamOut*      SGL_DLLCALL CreateStreamOut() = 0;
+
     /** Create shader.
      * @return pointer to shader object or 0 if not supported.
      */
     virtual Shader*         SGL_DLLCALL CreateShader(const Shader::DESC& desc) = 0;
 
+    /** Create shader without waiting for the compilation. Compilation errors are reported
+     * when the program using the shader is linked, see Program::DirtyAsync.
+     * @return pointer to shader object or 0 if not supported.
+     */
+    virtual Shader*         SGL_DLLCALL CreateShaderAsync(const Shader::DESC& desc) = 0;
+
+    /** Complete linking of the programs started by Program::DirtyAsync. Programs already linked
+     * by the driver are completed without waiting if KHR_parallel_shader_compile is supported,
+     * other programs are completed waiting for the driver, no more than maxBlockingLinks per call.
+     * Call it once per frame to spread compilation stalls across the frames.
+     * @return number of programs which are still being linked.
+     */
+    virtual unsigned        SGL_DLLCALL ProcessCompilation(unsigned maxBlockingLinks = 1) = 0;
+
     /** Create shader program.
      * @return pointer to shader program or 0 if not supported.
      */
@@ -441,6 +699,87 @@ public:
     /** Check whether device is valid. If not it is useless (lost). */
     virtual bool			SGL_DLLCALL Valid() const = 0;
 
+    /** Forget cached GL state, so next state binds will resend all values. Call it after
+     * changing blend, depth stencil, rasterizer states or buffer bindings directly via OpenGL.
+     */
+    virtual void			SGL_DLLCALL ResetStateCache() = 0;
+
+    /** Set the way GL errors are detected. Debug output is chosen by default if it is available.
+     * Errors from the debug output are passed to the installed ErrorHandler, they can be reported
+     * asynchronously and are not returned by the functions which caused them.
+     * @return SGLERR_UNSUPPORTED if debug output is requested but unavailable.
+     */
+    virtual SGL_HRESULT     SGL_DLLCALL SetValidationMode(VALIDATION_MODE mode) = 0;
+
+    /** Get the way GL errors are detected. */
+    virtual VALIDATION_MODE SGL_DLLCALL ValidationMode() const = 0;
+
+    // ============================ TRANSFERS ============================ //
+
+    /** Copy range of the buffer into another buffer. Data doesn't leave the GPU if device supports
+     * buffer copies (ARB_copy_buffer), otherwise it is read back and uploaded again. N/A in GLES.
+     * @param target - buffer where to copy data.
+     * @param targetOffset - offset in the target buffer in bytes.
+     * @param source - buffer where to copy data from. May be the same as target if ranges don't overlap.
+     * @param sourceOffset - offset in the source buffer in bytes.
+     * @param size - number of bytes to copy.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if ranges are out of the buffers,
+     * overlap or one of the buffers is mapped.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL CopyBuffer( Buffer*         target,
+                                                unsigned        targetOffset,
+                                                const Buffer*   source,
+                                                unsigned        sourceOffset,
+                                                unsigned        size ) = 0;
+
+    /** Upload texture region from the buffer through the pixel unpack binding. Pixels in the buffer
+     * are tightly packed and have format of the texture. Data doesn't leave the GPU if pixel buffer
+     * objects are supported. N/A in GLES.
+     * @param target - texture where to copy data.
+     * @param mipmap - mipmap level of the texture.
+     * @param offsetx - x offset of the texture region.
+     * @param offsety - y offset of the texture region.
+     * @param width - width of the texture region.
+     * @param height - height of the texture region.
+     * @param source - buffer containing the pixels.
+     * @param sourceOffset - offset of the pixels in the buffer in bytes.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if pixels are out of the buffer.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL CopyBufferToTexture2D( Texture2D*      target,
+                                                           unsigned        mipmap,
+                                                           unsigned        offsetx,
+                                                           unsigned        offsety,
+                                                           unsigned        width,
+                                                           unsigned        height,
+                                                           const Buffer*   source,
+                                                           unsigned        sourceOffset ) = 0;
+
+    /** Copy mipmap of the texture into the buffer through the pixel pack binding. Pixels are
+     * tightly packed and have format of the texture. N/A in GLES.
+     * @param target - buffer where to copy pixels.
+     * @param targetOffset - offset in the target buffer in bytes.
+     * @param source - texture to copy. Can't be multisampled.
+     * @param mipmap - mipmap level of the texture.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if pixels don't fit the buffer.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL CopyTexture2DToBuffer( Buffer*         target,
+                                                           unsigned        targetOffset,
+                                                           Texture2D*      source,
+                                                           unsigned        mipmap ) = 0;
+
+    /** Copy region of the bound framebuffer, back buffer if render target is not bound, into the buffer
+     * through the pixel pack binding. Pixels are tightly packed. N/A in GLES.
+     * @param target - buffer where to copy pixels.
+     * @param targetOffset - offset in the target buffer in bytes.
+     * @param rect - region of the framebuffer.
+     * @param format - format of the pixels in the buffer. Can't be compressed.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if pixels don't fit the buffer.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL CopyFramebufferToBuffer( Buffer*            target,
+                                                             unsigned           targetOffset,
+                                                             const rectangle&   rect,
+                                                             Texture::FORMAT    format = Texture::RGBA8 ) = 0;
+
     // ============================ RETRIEVE ============================ //
 
     /** Copy content of color attachment or depth stencil attachment ot the texture.
@@ -460,6 +799,16 @@ public:
                                                    unsigned       offsety,
                                                    unsigned       width,
                                                    unsigned       height ) const = 0;
+
+    /** Start asynchronous readback of the bound framebuffer region, back buffer if
+     * render target is not bound.
+     * @param rect - region of the framebuffer.
+     * @param format - format of the retrieved pixels.
+     * @return readback request or 0 if readback is not supported.
+     */
+    virtual ReadbackRequest* SGL_DLLCALL Readback( const rectangle&   rect,
+                                                   Texture::FORMAT    format = Texture::RGBA8 ) const = 0;
+
     virtual ~Device() {}
 };
 
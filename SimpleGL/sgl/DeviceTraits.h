@@ -40,6 +40,26 @@ public:
     /** Get maximum texture height supported by the device. */
     virtual unsigned int SGL_DLLCALL MaxTextureHeight() const = 0;
 
+    /** Get number of the uniform buffer binding points. 0 if uniform buffers are not supported. */
+    virtual unsigned int SGL_DLLCALL NumberOfUniformBufferBindings() const = 0;
+
+    /** Get alignment of the offset of the uniform buffer range bound to the binding point. */
+    virtual unsigned int SGL_DLLCALL UniformBufferOffsetAlignment() const = 0;
+
+    /** Get maximum number of the stream output buffers and separate varyings. 0 if stream output is not supported. */
+    virtual unsigned int SGL_DLLCALL NumberOfStreamOutBuffers() const = 0;
+
+    /** Get maximum number of the texels in the texture buffer. 0 if texture buffers are not supported. */
+    virtual unsigned int SGL_DLLCALL MaxTextureBufferSize() const = 0;
+
+    /** Get alignment of the offset of the buffer range attached to the texture buffer. */
+    virtual unsigned int SGL_DLLCALL TextureBufferOffsetAlignment() const = 0;
+
+    /** Get vendor, renderer and version strings of the driver separated by new lines.
+     * Program binaries are valid only for the driver with the same identity.
+     */
+    virtual const char* SGL_DLLCALL DriverIdentity() const = 0;
+
     virtual SGL_DLLCALL ~DeviceTraits() {}
 };
 
@@ -3,8 +3,10 @@
 
 #include "GLCommon.h"
 #include "GLDevice.h"
+#include "GLReadbackRequest.h"
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 namespace sgl {
 
@@ -23,26 +25,57 @@ const GLuint BIND_GL_USAGE[] =
 #endif
 };
 
-inline GLint GuardedBind(GLuint glTarget, GLuint glBuffer)
+/* Binds buffer to the target using device binding cache, restores previous binding on destruction */
+class guarded_buffer_binding
 {
-    GLint oldBuffer;
-    if ( glTarget == GL_ELEMENT_ARRAY_BUFFER ) {
-        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &oldBuffer);
-    }
-    else if ( glTarget == GL_ARRAY_BUFFER ) {
-        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &oldBuffer);
+public:
+    guarded_buffer_binding( GLDevice*  device_,
+                            GLenum     glTarget_,
+                            GLuint     glBuffer ) :
+        device(device_),
+        glTarget(glTarget_),
+        oldBuffer( device_->BoundBuffer(glTarget_) )
+    {
+        device->BindBuffer(glTarget, glBuffer);
     }
-    else {
-        oldBuffer = 0; // do nothing
+
+    ~guarded_buffer_binding()
+    {
+        device->BindBuffer(glTarget, oldBuffer);
     }
 
-    glBindBuffer(glTarget, glBuffer);
-    return oldBuffer;
+private:
+    GLDevice*   device;
+    GLenum      glTarget;
+    GLuint      oldBuffer;
+};
+
+/* Non template part of the buffer, allows retrieving buffer object through the Buffer interface */
+class GLBufferHandle
+{
+public:
+    GLuint Handle() const { return glBuffer; }
+
+protected:
+    GLBufferHandle() :
+        glBuffer(0)
+    {}
+
+protected:
+    GLuint  glBuffer;
+};
+
+/* Get buffer object of the buffer created by the GLDevice */
+inline GLuint BufferHandle(const Buffer* buffer)
+{
+    const GLBufferHandle* handle = dynamic_cast<const GLBufferHandle*>(buffer);
+    return handle ? handle->Handle() : 0;
 }
 
 template<typename Interface>
 class GLBuffer :
-    public ReferencedImpl<Interface>
+    public ReferencedImpl<Interface>,
+    public GLBufferHandle
 {
 protected:
     typedef ReferencedImpl<Interface> base_type;
@@ -53,27 +86,62 @@ protected:
         device(_device),
         glTarget(_glTarget),
         usage(Buffer::STATIC_DRAW),
-	    glBuffer(0),
-        dataSize(0)
+        updatePolicy(Buffer::UPDATE_IN_PLACE),
+        dataSize(0),
+        currentStorage(0),
+        usedFrames(0),
+        mapped(false)
     {
         glGenBuffers(1, &glBuffer);
     }
 
     ~GLBuffer()
     {
-    	if ( device->Valid() ) {
-    		glDeleteBuffers(1, &glBuffer);
+    	if ( device->Valid() ) 
+        {
+            if ( storages.empty() ) {
+                storages.push_back(glBuffer);
+            }
+
+            for (size_t i = 0; i < storages.size(); ++i) {
+                device->ReleaseBuffer(storages[i]);
+            }
+    		glDeleteBuffers(storages.size(), &storages[0]);
     	}
     }
 
 public:
+    /** Set policy of the buffer updates. Must be called before buffer data is specified. */
+    void SetUpdatePolicy(Buffer::UPDATE_POLICY policy, unsigned numBuffers)
+    {
+        assert( dataSize == 0 && storages.empty() );
+
+        updatePolicy = policy;
+        if (policy == Buffer::UPDATE_ROUND_ROBIN && numBuffers > 1)
+        {
+            storages.resize(numBuffers);
+            storages[0] = glBuffer;
+            glGenBuffers(numBuffers - 1, &storages[1]);
+            storageSizes.resize(numBuffers, 0);
+        }
+    }
+
+    /** Remember that buffer is used by the commands of the current frame. */
+    void MarkUsed() const
+    {
+        usedFrames = device->FrameIndex() + 1;
+    }
+
+    Buffer::UPDATE_POLICY SGL_DLLCALL UpdatePolicy() const
+    {
+        return updatePolicy;
+    }
+
 #ifdef SIMPLE_GL_ES
 #else // !defined(SIMPLE_GL_ES)
     SGL_HRESULT SGL_DLLCALL Map(int     hint, 
                                 void**  data)
     {
-        GLuint oldBuffer = GuardedBind(glTarget, glBuffer);
-
         GLuint glHint = 0;
         if (hint == Buffer::MAP_READ_BIT) {
             glHint = GL_READ_ONLY;
@@ -88,12 +156,21 @@ public:
             assert(!"Invalid hint. Can be only MAP_READ_BIT, MAP_WRITE_BIT, MAP_READ_BIT | MAP_WRITE_BIT");
         }
 
-        (*data) = glMapBuffer(glTarget, glHint);
-    #ifndef SGL_NO_STATUS_CHECK
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) 
+        if (hint == Buffer::MAP_WRITE_BIT && updatePolicy == Buffer::UPDATE_ROUND_ROBIN) {
+            NextStorage(true);
+        }
+
+        if ( device->DirectStateAccess() ) {
+            (*data) = glMapNamedBufferEXT(glBuffer, glHint);
+        }
+        else 
         {
-            glBindBuffer(glTarget, oldBuffer);
+            guarded_buffer_binding binding(device, glTarget, glBuffer);
+            (*data) = glMapBuffer(glTarget, glHint);
+        }
+    #ifndef SGL_NO_STATUS_CHECK
+        GLenum error = device->PollError();
+        if (error != GL_NO_ERROR) {
             return CheckGLError("GLBuffer::Map failed: ", error);
         }
     #endif
@@ -107,7 +184,9 @@ public:
                                      int        hint, 
                                      void**     data)
     {
-        GLuint oldBuffer = GuardedBind(glTarget, glBuffer);
+        if ( (hint & Buffer::MAP_WRITE_BIT) && !(hint & Buffer::MAP_READ_BIT) ) {
+            hint = ApplyUpdatePolicy(offset, size, hint);
+        }
 
         GLuint glHint = (hint & Buffer::MAP_READ_BIT) * GL_MAP_READ_BIT
                       | (hint & Buffer::MAP_WRITE_BIT) * GL_MAP_WRITE_BIT
@@ -115,66 +194,65 @@ public:
                       | (hint & Buffer::MAP_INVALIDATE_BUFFER_BIT) * GL_MAP_INVALIDATE_BUFFER_BIT
                       | (hint & Buffer::MAP_UNSYNCHRONIZED_BIT) * GL_MAP_UNSYNCHRONIZED_BIT;
 
-        (*data) = glMapBufferRange(glTarget, offset, size, glHint);
-    #ifndef SGL_NO_STATUS_CHECK
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) 
+        if ( device->DirectStateAccess() ) {
+            (*data) = glMapNamedBufferRangeEXT(glBuffer, offset, size, glHint);
+        }
+        else 
         {
-            glBindBuffer(glTarget, oldBuffer);
+            guarded_buffer_binding binding(device, glTarget, glBuffer);
+            (*data) = glMapBufferRange(glTarget, offset, size, glHint);
+        }
+    #ifndef SGL_NO_STATUS_CHECK
+        GLenum error = device->PollError();
+        if (error != GL_NO_ERROR) {
             return CheckGLError("GLBuffer::MapRange failed: ", error);
         }
     #endif
-        mapped = true;
 
-        // restore
-        if (oldBuffer != glBuffer) {
-            glBindBufferARB(glTarget, oldBuffer);
-        }
+        mapped = true;
         return SGL_OK;
     }
 
     SGL_HRESULT SGL_DLLCALL FlushMappedRange(unsigned offset, unsigned size)
     {
         assert(mapped);
-        GLuint oldBuffer = GuardedBind(glTarget, glBuffer);
-
-        glFlushMappedBufferRange(glTarget, offset, size);
-    #ifndef SGL_NO_STATUS_CHECK
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) 
+        if ( device->DirectStateAccess() ) {
+            glFlushMappedNamedBufferRangeEXT(glBuffer, offset, size);
+        }
+        else 
         {
-            glBindBuffer(glTarget, oldBuffer);
+            guarded_buffer_binding binding(device, glTarget, glBuffer);
+            glFlushMappedBufferRange(glTarget, offset, size);
+        }
+    #ifndef SGL_NO_STATUS_CHECK
+        GLenum error = device->PollError();
+        if (error != GL_NO_ERROR) {
             return CheckGLError("GLBuffer::FlushMappedRange failed: ", error);
         }
     #endif
 
-        // restore
-        if (oldBuffer != glBuffer) {
-            glBindBufferARB(glTarget, oldBuffer);
-        }
         return SGL_OK;
     }
 
     SGL_HRESULT SGL_DLLCALL Unmap()
     {
         assert(mapped);
-        GLuint oldBuffer = GuardedBind(glTarget, glBuffer);
-
-        glUnmapBuffer(glTarget);
-    #ifndef SGL_NO_STATUS_CHECK
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) 
+        if ( device->DirectStateAccess() ) {
+            glUnmapNamedBufferEXT(glBuffer);
+        }
+        else 
         {
-            glBindBuffer(glTarget, oldBuffer);
+            guarded_buffer_binding binding(device, glTarget, glBuffer);
+            glUnmapBuffer(glTarget);
+        }
+    #ifndef SGL_NO_STATUS_CHECK
+        GLenum error = device->PollError();
+        if (error != GL_NO_ERROR) {
             return CheckGLError("GLBuffer::Unmap failed: ", error);
         }
     #endif
-        mapped = false;
 
-        // restore
-        if (oldBuffer != glBuffer) {
-            glBindBufferARB(glTarget, oldBuffer);
-        }
+        mapped = false;
         return SGL_OK;
     }
 #endif
@@ -194,24 +272,20 @@ public:
                                      const void*    data,
                                      Buffer::USAGE  usage_ )
     {
-        // set buffer data
-        GLuint oldBuffer = GuardedBind(glTarget, glBuffer);
-        glBufferData(glTarget, _dataSize, data, BIND_GL_USAGE[usage = usage_]);
-    
+        usage = usage_;
+        BufferData(glBuffer, _dataSize, data);
+        if ( !storageSizes.empty() ) {
+            storageSizes[currentStorage] = _dataSize;
+        }
+        SGL_FRAME_STATISTICS(device, numBytesUploaded, data ? _dataSize : 0);
     #ifndef SGL_NO_STATUS_CHECK
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) 
-        {
-            glBindBuffer(glTarget, oldBuffer);
+        GLenum error = device->PollError();
+        if (error != GL_NO_ERROR) {
             return CheckGLError("GLBuffer::SetData failed: ", error);
         }
     #endif
-	    dataSize = _dataSize;
 
-        // restore
-        if (oldBuffer != glBuffer) {
-            glBindBuffer(glTarget, oldBuffer);
-        }
+	    dataSize = _dataSize;
 	    return SGL_OK;
     }
 
@@ -219,23 +293,66 @@ public:
                                         unsigned int    chunkSize,
                                         const void*     data )
     {
-        // set buffer data
-        GLuint oldBuffer = GuardedBind(glTarget, glBuffer);
-        glBufferSubData(glTarget, offset, chunkSize, data);
-    
-    #ifndef SGL_NO_STATUS_CHECK
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) 
+        // new storage is specified at once, driver needn't synchronize
+        bool whole = (offset == 0 && chunkSize == dataSize);
+        switch (updatePolicy)
         {
-            glBindBuffer(glTarget, oldBuffer);
+            case Buffer::UPDATE_ORPHAN:
+                if (whole)
+                {
+                    SGL_FRAME_STATISTICS(device, numStallsAvoided, 1);
+                    return SetData(chunkSize, data, usage);
+                }
+                break;
+
+            case Buffer::UPDATE_ROUND_ROBIN:
+                NextStorage(!whole);
+                break;
+
+            case Buffer::UPDATE_UNSYNCHRONIZED:
+            #ifndef SIMPLE_GL_ES
+                if ( Idle() && (GLEW_VERSION_3_0 || GLEW_ARB_map_buffer_range) )
+                {
+                    void*       mappedData = 0;
+                    SGL_HRESULT result     = MapRange(offset, chunkSize, Buffer::MAP_WRITE_BIT | Buffer::MAP_INVALIDATE_RANGE_BIT, &mappedData);
+                    if (SGL_OK != result) {
+                        return result;
+                    }
+
+                    memcpy(mappedData, data, chunkSize);
+                    SGL_FRAME_STATISTICS(device, numBytesUploaded, chunkSize);
+                    return Unmap();
+                }
+            #endif
+                if (whole)
+                {
+                    SGL_FRAME_STATISTICS(device, numStallsAvoided, 1);
+                    return SetData(chunkSize, data, usage);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+    #ifndef SIMPLE_GL_ES
+        if ( device->DirectStateAccess() ) {
+            glNamedBufferSubDataEXT(glBuffer, offset, chunkSize, data);
+        }
+        else
+    #endif
+        {
+            guarded_buffer_binding binding(device, glTarget, glBuffer);
+            glBufferSubData(glTarget, offset, chunkSize, data);
+        }
+        SGL_FRAME_STATISTICS(device, numBytesUploaded, chunkSize);
+    #ifndef SGL_NO_STATUS_CHECK
+        GLenum error = device->PollError();
+        if (error != GL_NO_ERROR) {
             return CheckGLError("GLBuffer::SetSubData failed: ", error);
         }
     #endif
 
-        // restore
-        if (oldBuffer != glBuffer) {
-            glBindBuffer(glTarget, oldBuffer);
-        }
 	    return SGL_OK;
     }
 
@@ -246,39 +363,58 @@ public:
     {
         assert(data);
 
-        // get buffer data
-        GLuint oldBuffer = GuardedBind(glTarget, glBuffer);
-
-        // try to map
-        void* mappedData = glMapBufferRange(glTarget, offset, dataSize, GL_MAP_READ_BIT);
-    #ifndef SGL_NO_STATUS_CHECK
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) 
+        if ( device->DirectStateAccess() ) {
+            glGetNamedBufferSubDataEXT(glBuffer, offset, dataSize, data);
+        }
+        else
         {
-            glBindBuffer(glTarget, oldBuffer);
+            guarded_buffer_binding binding(device, glTarget, glBuffer);
+            glGetBufferSubData(glTarget, offset, dataSize, data);
+        }
+        SGL_FRAME_STATISTICS(device, numGetQueries, 1);
+    #ifndef SGL_NO_STATUS_CHECK
+        GLenum error = device->PollError();
+        if (error != GL_NO_ERROR) {
             return CheckGLError("GLBuffer::GetData failed: ", error);
         }
     #endif
 
-        // copy
-        memcpy(data, mappedData, dataSize);
+        return SGL_OK;
+    }
+
+    ReadbackRequest* SGL_DLLCALL Readback( unsigned int  offset,
+                                           unsigned int  chunkSize ) const
+    {
+        if ( !GLReadbackRequest::Supported() )
+        {
+            sglSetError(SGLERR_UNSUPPORTED, "GLBuffer::Readback failed. Pixel buffer objects are not supported.");
+            return 0;
+        }
 
-        // try to unmap
-        glUnmapBuffer(glTarget);
-    #ifndef SGL_NO_STATUS_CHECK
-        error = glGetError();
-        if (error != GL_NO_ERROR) 
+        GLReadbackRequest* request = new GLReadbackRequest(device, chunkSize);
+        if (GLEW_VERSION_3_1 || GLEW_ARB_copy_buffer)
         {
-            glBindBuffer(glTarget, oldBuffer);
-            return CheckGLError("GLBuffer::GetData failed: ", error);
+            guarded_buffer_binding readBinding(device, GL_COPY_READ_BUFFER, glBuffer);
+            guarded_buffer_binding writeBinding(device, GL_COPY_WRITE_BUFFER, request->PackBuffer());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, 0, chunkSize);
         }
-    #endif
+        else if (chunkSize > 0)
+        {
+            // can't copy on the GPU, read synchronously
+            std::vector<char> data(chunkSize);
+            GetData(&data[0], offset, chunkSize);
 
-        // restore
-        if (oldBuffer != glBuffer) {
-            glBindBuffer(glTarget, oldBuffer);
+            guarded_buffer_binding binding(device, GL_PIXEL_PACK_BUFFER, request->PackBuffer());
+            glBufferSubData(GL_PIXEL_PACK_BUFFER, 0, chunkSize, &data[0]);
         }
-        return SGL_OK;
+
+        if ( SGL_OK != request->Issue() )
+        {
+            delete request;
+            return 0;
+        }
+
+        return request;
     }
 #endif // defined(SIMPLE_GL_ES)
 
@@ -287,16 +423,126 @@ public:
         return dataSize;
     }
 
+protected:
+    /* Specify storage of the buffer object */
+    void BufferData(GLuint buffer, unsigned size, const void* data)
+    {
+    #ifndef SIMPLE_GL_ES
+        if ( device->DirectStateAccess() ) {
+            glNamedBufferDataEXT(buffer, size, data, BIND_GL_USAGE[usage]);
+        }
+        else
+    #endif
+        {
+            guarded_buffer_binding binding(device, glTarget, buffer);
+            glBufferData(glTarget, size, data, BIND_GL_USAGE[usage]);
+        }
+    }
+
+    /* Check whether GPU finished every frame which used the buffer */
+    bool Idle() const
+    {
+        return usedFrames == 0 || device->FrameCompleted(usedFrames - 1);
+    }
+
+    /* Switch to the next storage of the round robin policy. Content of the previous storage
+     * is copied on the GPU if it is kept, if copies are unsupported storage isn't switched.
+     */
+    bool NextStorage(bool keepContent)
+    {
+        if (storages.size() < 2) {
+            return false;
+        }
+
+    #ifdef SIMPLE_GL_ES
+        if (keepContent) {
+            return false;
+        }
+    #else
+        if ( keepContent && !(GLEW_VERSION_3_1 || GLEW_ARB_copy_buffer) ) {
+            return false;
+        }
+    #endif
+
+        GLuint prevBuffer = glBuffer;
+        currentStorage    = (currentStorage + 1) % storages.size();
+        glBuffer          = storages[currentStorage];
+        if (storageSizes[currentStorage] != dataSize)
+        {
+            BufferData(glBuffer, dataSize, 0);
+            storageSizes[currentStorage] = dataSize;
+        }
+
+    #ifndef SIMPLE_GL_ES
+        if (keepContent && dataSize > 0)
+        {
+            guarded_buffer_binding readBinding(device, GL_COPY_READ_BUFFER, prevBuffer);
+            guarded_buffer_binding writeBinding(device, GL_COPY_WRITE_BUFFER, glBuffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, dataSize);
+        }
+    #endif
+
+        SGL_FRAME_STATISTICS(device, numStallsAvoided, 1);
+        return true;
+    }
+
+#ifndef SIMPLE_GL_ES
+    /* Modify write mapping hint according to the update policy */
+    int ApplyUpdatePolicy(unsigned offset, unsigned size, int hint)
+    {
+        bool invalidate = (hint & Buffer::MAP_INVALIDATE_BUFFER_BIT)
+                          || ( (hint & Buffer::MAP_INVALIDATE_RANGE_BIT) && offset == 0 && size == dataSize );
+        switch (updatePolicy)
+        {
+            case Buffer::UPDATE_ORPHAN:
+                if (invalidate)
+                {
+                    BufferData(glBuffer, dataSize, 0);
+                    SGL_FRAME_STATISTICS(device, numStallsAvoided, 1);
+                    return hint & ~Buffer::MAP_INVALIDATE_BUFFER_BIT;
+                }
+                break;
+
+            case Buffer::UPDATE_ROUND_ROBIN:
+                NextStorage(!invalidate);
+                break;
+
+            case Buffer::UPDATE_UNSYNCHRONIZED:
+                if ( Idle() )
+                {
+                    SGL_FRAME_STATISTICS(device, numStallsAvoided, 1);
+                    return hint | Buffer::MAP_UNSYNCHRONIZED_BIT;
+                }
+                else if (invalidate) {
+                    return hint | Buffer::MAP_INVALIDATE_BUFFER_BIT;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        return hint;
+    }
+#endif // !defined(SIMPLE_GL_ES)
+
+protected:
+    typedef std::vector<GLuint>     buffer_vector;
+    typedef std::vector<unsigned>   size_vector;
+
 protected:
     GLDevice*      device;
 
     // data
-    GLuint         glTarget;
-    Buffer::USAGE  usage;
-    GLuint         glBuffer;
-    GLuint         oldBuffer;
-    size_t         dataSize;
-    bool           mapped;
+    GLuint                  glTarget;
+    Buffer::USAGE           usage;
+    Buffer::UPDATE_POLICY   updatePolicy;
+    size_t                  dataSize;
+    buffer_vector           storages;       // storages of the round robin policy
+    size_vector             storageSizes;
+    unsigned                currentStorage;
+    mutable unsigned        usedFrames;     // index of the last frame using the buffer + 1, 0 if unused
+    bool                    mapped;
 };
 
 #ifndef SIMPLE_GL_ES
@@ -332,18 +578,30 @@ public:
                                     unsigned int offsetDst,
                                     unsigned int size ) const
     {
-        // hack
-        GLBufferModern<Interface>* targetBuf = static_cast<GLBufferModern<Interface>*>(target);
-
-        glBindBuffer(GL_COPY_READ_BUFFER, GLBuffer<Interface>::glBuffer);
-        glBindBuffer(GL_COPY_WRITE_BUFFER, targetBuf->glBuffer);
-        glCopyBufferSubData( GL_COPY_READ_BUFFER, 
-                             GL_COPY_WRITE_BUFFER,
-                             offsetSrc,
-                             offsetDst,
-                             size );
+        // target may have different interface, e.g. vertex data copied into index buffer
+        GLuint      glTargetBuffer = BufferHandle(target);
+        GLDevice*   device         = GLBuffer<Interface>::device;
+
+        if ( device->DirectStateAccess() )
+        {
+            glNamedCopyBufferSubDataEXT( GLBuffer<Interface>::glBuffer,
+                                         glTargetBuffer,
+                                         offsetSrc,
+                                         offsetDst,
+                                         size );
+        }
+        else
+        {
+            device->BindBuffer(GL_COPY_READ_BUFFER, GLBuffer<Interface>::glBuffer);
+            device->BindBuffer(GL_COPY_WRITE_BUFFER, glTargetBuffer);
+            glCopyBufferSubData( GL_COPY_READ_BUFFER, 
+                                 GL_COPY_WRITE_BUFFER,
+                                 offsetSrc,
+                                 offsetDst,
+                                 size );
+        }
 #ifndef SGL_NO_STATUS_CHECK
-        GLenum error = glGetError();
+        GLenum error = device->PollError();
         if (error != GL_NO_ERROR) {
             return CheckGLError("GLBuffer::CopyTo failed: ", error);
         }
@@ -393,17 +651,18 @@ public:
         assert(target);
         assert( (offsetSrc + size <= GLBuffer<Interface>::dataSize) && (offsetDst + size <= target->Size()) );
 
-        void* data = 0;
-        SGL_HRESULT hr = const_cast<GLBufferDefault*>(this)->Map(Buffer::MAP_READ_BIT, &data);
-        {
-            if (hr != SGL_OK) {
-                return hr;
-            }
-            hr = target->SetData(GLBuffer<Interface>::dataSize, data);
+        if (size == 0) {
+            return SGL_OK;
         }
-        const_cast<GLBufferDefault*>(this)->Unmap();
 
-        return hr;
+        // can't copy on the GPU, pass the range through the client memory
+        std::vector<char> data(size);
+        SGL_HRESULT hr = GLBuffer<Interface>::GetData(&data[0], offsetSrc, size);
+        if (hr != SGL_OK) {
+            return hr;
+        }
+
+        return target->SetSubData(offsetDst, size, &data[0]);
     }
 #endif // !defined(SIMPLE_GL_ES)
 };
@@ -0,0 +1,88 @@
+#ifndef SIMPLE_GL_GL_COMMAND_LIST_H
+#define SIMPLE_GL_GL_COMMAND_LIST_H
+
+#include "GLForward.h"
+#include "../CommandList.h"
+#include "../Utility/Aligned.h"
+#include <vector>
+
+namespace sgl {
+
+/* Command list storing commands in the 16 byte aligned memory stream */
+class GLCommandList :
+    public ResourceImpl<CommandList>
+{
+public:
+    /* Stream is composed of blocks, so uniform data is always properly aligned */
+    struct block
+    {
+        unsigned char data[16];
+    };
+
+    typedef std::vector< block, aligned_allocator<block> > block_vector;
+
+public:
+    GLCommandList(GLDevice* device);
+    ~GLCommandList();
+
+    // Override CommandList
+    void SGL_DLLCALL BindBlendState(const BlendState* blendState);
+    void SGL_DLLCALL BindDepthStencilState(const DepthStencilState* depthStencilState);
+    void SGL_DLLCALL BindRasterizerState(const RasterizerState* rasterizerState);
+    void SGL_DLLCALL BindProgram(const Program* program);
+    void SGL_DLLCALL BindTexture(unsigned int stage, const Texture* texture);
+    void SGL_DLLCALL BindVertexBuffer(const VertexBuffer* vertexBuffer, const VertexLayout* vertexLayout);
+    void SGL_DLLCALL BindIndexBuffer(const IndexBuffer* indexBuffer, IndexBuffer::INDEX_TYPE format);
+    void SGL_DLLCALL BindRenderTarget(const RenderTarget* renderTarget);
+    void SGL_DLLCALL SetViewport(const rectangle& vp);
+
+    void SGL_DLLCALL SetUniform( AbstractUniform* uniform,
+                                 const void*      values,
+                                 unsigned int     count );
+    void SGL_DLLCALL SetSamplerUniform( AbstractUniform* uniform,
+                                        unsigned int     stage,
+                                        const Texture*   texture );
+    void SGL_DLLCALL SetBufferSubData( Buffer*         buffer,
+                                       unsigned int    offset,
+                                       unsigned int    dataSize,
+                                       const void*     data );
+
+    void SGL_DLLCALL Draw( PRIMITIVE_TYPE primType,
+                           unsigned       firstVertex,
+                           unsigned       numVertices );
+    void SGL_DLLCALL DrawIndexed( PRIMITIVE_TYPE primType,
+                                  unsigned       firstIndex,
+                                  unsigned       numIndices );
+#ifndef SIMPLE_GL_ES
+    void SGL_DLLCALL DrawInstanced( PRIMITIVE_TYPE primType,
+                                    unsigned       firstVertex,
+                                    unsigned       numVertices,
+                                    unsigned       numInstances );
+    void SGL_DLLCALL DrawIndexedInstanced( PRIMITIVE_TYPE primType,
+                                           unsigned       firstIndex,
+                                           unsigned       numIndices,
+                                           unsigned       numInstances );
+#endif // !defined(SIMPLE_GL_ES)
+    void SGL_DLLCALL Clear(bool colorBuffer, bool depthBuffer, bool stencilBuffer);
+
+    void         SGL_DLLCALL Reset();
+    unsigned int SGL_DLLCALL NumCommands() const { return numCommands; }
+    unsigned int SGL_DLLCALL Size() const        { return stream.size() * sizeof(block); }
+
+    /** Replay recorded commands. Must be called from the thread owning context. */
+    SGL_HRESULT Execute() const;
+
+private:
+    /* Append command with additional data to the stream. */
+    template<typename Command>
+    Command* Append(unsigned int type, unsigned int dataSize = 0);
+
+private:
+    GLDevice*       device;
+    block_vector    stream;
+    unsigned int    numCommands;
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_GL_COMMAND_LIST_H
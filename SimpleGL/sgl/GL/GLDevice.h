@@ -10,12 +10,28 @@
 #   undef DEVICE_TYPE
 #endif
 
+#include <map>
 #include <stack>
+#include <vector>
 #include "Device.h"
 #include "Utility/Referenced.h"
 
+#if defined(__linux__) && !defined(__ANDROID__) && defined(SIMPLE_GL_USE_EGL)
+#   include <EGL/egl.h>
+#   include <EGL/eglext.h>
+#endif
+
+/* Increment counter of the device frame statistics, expands to nothing without SIMPLE_GL_FRAME_STATISTICS */
+#ifdef SIMPLE_GL_FRAME_STATISTICS
+#   define SGL_FRAME_STATISTICS(device, counter, value) ( static_cast<const sgl::GLDevice*>(device)->MutableFrameStatistics().counter += (value) )
+#else
+#   define SGL_FRAME_STATISTICS(device, counter, value) ( (void)0 )
+#endif
+
 namespace sgl {
 
+class GLProgram;
+
 /* GLDevice class wraps gl functions */
 class GLDevice :
 	public ReferencedImpl<Device>
@@ -24,6 +40,86 @@ protected:
     typedef std::stack< ref_ptr<const State> > state_stack;
 
 public:
+    /* Buffer targets which bindings are tracked by the device */
+    enum BUFFER_TARGET
+    {
+        ARRAY_BUFFER,
+        ELEMENT_ARRAY_BUFFER,
+    #ifndef SIMPLE_GL_ES
+        COPY_READ_BUFFER,
+        COPY_WRITE_BUFFER,
+        PIXEL_PACK_BUFFER,
+        PIXEL_UNPACK_BUFFER,
+        UNIFORM_BUFFER,
+        TEXTURE_BUFFER,
+        TRANSFORM_FEEDBACK_BUFFER,
+    #endif
+        __NUMBER_OF_BUFFER_TARGETS__
+    };
+
+    /* Number of uniform buffer binding points tracked by the device, minimum required by GL 3.1 */
+    static const unsigned NUM_CACHED_UNIFORM_BUFFER_BINDINGS = 36;
+
+    /* Shadow copy of the fixed function gl state. Value -1 means unknown state. */
+    struct STATE_CACHE
+    {
+        // blend
+        GLint   blendEnable;
+        GLint   blendSrc;
+        GLint   blendDest;
+        GLint   blendSrcAlpha;
+        GLint   blendDestAlpha;
+        GLint   blendOp;
+        GLint   blendOpAlpha;
+
+        // depth
+        GLint   depthEnable;
+        GLint   depthFunc;
+        GLint   depthWriteMask;
+
+        // stencil, face arrays are indexed as [front, back]
+        GLint   stencilEnable;
+        GLint   stencilWriteMask;
+        GLint   stencilReadMask[2];
+        GLint   stencilFunc[2];
+        GLint   stencilFailOp[2];
+        GLint   stencilDepthFailOp[2];
+        GLint   stencilPassOp[2];
+
+        // rasterizer
+        GLint   cullEnable;
+        GLint   cullFace;
+        GLint   fillMode;
+        GLint   colorMask;
+
+        // buffers
+        GLint   boundBuffer[__NUMBER_OF_BUFFER_TARGETS__];
+    #ifndef SIMPLE_GL_ES
+        GLint   uniformBufferBinding[NUM_CACHED_UNIFORM_BUFFER_BINDINGS][3];  // [buffer, offset, size]
+    #endif
+    };
+
+    /* Key of the vertex array object: layout with the buffers it captures */
+    struct VERTEX_ARRAY_DESC
+    {
+        const VertexLayout* vertexLayout;
+        GLuint              vertexBuffer;
+        GLuint              indexBuffer;
+
+        bool operator < (const VERTEX_ARRAY_DESC& rhs) const
+        {
+            if (vertexLayout != rhs.vertexLayout) {
+                return vertexLayout < rhs.vertexLayout;
+            }
+            if (vertexBuffer != rhs.vertexBuffer) {
+                return vertexBuffer < rhs.vertexBuffer;
+            }
+            return indexBuffer < rhs.indexBuffer;
+        }
+    };
+
+    typedef std::map<VERTEX_ARRAY_DESC, GLuint> vertex_array_map;
+
     GLDevice();
 #ifndef __ANDROID__
     GLDevice(const Device::VIDEO_DESC& desc);
@@ -55,6 +151,12 @@ public:
     void                        SGL_DLLCALL SetProgram(const Program* program);
     void                        SGL_DLLCALL SetRenderTarget(const RenderTarget* renderTarget);
 
+    /** Remember current program having uniforms queued for the upload */
+    void                        SetUniformsDirty(const GLProgram* program) const            { dirtyUniformsProgram = program; }
+
+    /** Upload queued uniforms of the current program. Called before draws and program changes. */
+    void                        FlushUniforms() const;
+
     // ============================ DRAW ============================ //
     void                SGL_DLLCALL Draw( PRIMITIVE_TYPE primType, 
                                           unsigned       firstVertex, 
@@ -76,8 +178,53 @@ public:
                                                           unsigned       numInstances ) const;
 #endif // !defined(SIMPLE_GL_ES)
 
+    void                SGL_DLLCALL MultiDraw( PRIMITIVE_TYPE   primType,
+                                               const unsigned*  firstVertices,
+                                               const unsigned*  numVertices,
+                                               unsigned         numDraws ) const;
+
+    void                SGL_DLLCALL MultiDrawIndexed( PRIMITIVE_TYPE   primType,
+                                                      const unsigned*  firstIndices,
+                                                      const unsigned*  numIndices,
+                                                      unsigned         numDraws ) const;
+
+#ifndef SIMPLE_GL_ES
+    void                SGL_DLLCALL DrawIndexedBaseVertex( PRIMITIVE_TYPE primType,
+                                                           unsigned       firstIndex,
+                                                           unsigned       numIndices,
+                                                           int            baseVertex ) const;
+
+    void                SGL_DLLCALL MultiDrawIndexedBaseVertex( PRIMITIVE_TYPE   primType,
+                                                                const unsigned*  firstIndices,
+                                                                const unsigned*  numIndices,
+                                                                const int*       baseVertices,
+                                                                unsigned         numDraws ) const;
+
+    void                SGL_DLLCALL DrawIndirect( PRIMITIVE_TYPE primType,
+                                                  const Buffer*  buffer,
+                                                  unsigned       offset ) const;
+
+    void                SGL_DLLCALL DrawIndexedIndirect( PRIMITIVE_TYPE primType,
+                                                         const Buffer*  buffer,
+                                                         unsigned       offset ) const;
+
+    void                SGL_DLLCALL MultiDrawIndirect( PRIMITIVE_TYPE primType,
+                                                       const Buffer*  buffer,
+                                                       unsigned       offset,
+                                                       unsigned       numDraws,
+                                                       unsigned       stride ) const;
+
+    void                SGL_DLLCALL MultiDrawIndexedIndirect( PRIMITIVE_TYPE primType,
+                                                              const Buffer*  buffer,
+                                                              unsigned       offset,
+                                                              unsigned       numDraws,
+                                                              unsigned       stride ) const;
+#endif // !defined(SIMPLE_GL_ES)
+
     void                SGL_DLLCALL Clear(bool colorBuffer = true, bool depthBuffer = true, bool stencilBuffer = true) const;
 
+    SGL_HRESULT         SGL_DLLCALL Execute(const CommandList* commandList);
+
     void                SGL_DLLCALL SwapBuffers() const;
 
     SGL_HRESULT         SGL_DLLCALL Sync() const;
@@ -86,6 +233,75 @@ public:
 
     bool				SGL_DLLCALL Valid() const { return valid; }
 
+    void				SGL_DLLCALL ResetStateCache();
+
+    SGL_HRESULT         SGL_DLLCALL SetValidationMode(VALIDATION_MODE mode);
+    VALIDATION_MODE     SGL_DLLCALL ValidationMode() const { return validationMode; }
+
+    unsigned            SGL_DLLCALL ProcessCompilation(unsigned maxBlockingLinks = 1);
+
+    /** Get GL error if errors are polled, GL_NO_ERROR otherwise. Use it instead of glGetError in the frequently called functions. */
+    GLenum              SGL_DLLCALL PollError() const { return (validationMode == VALIDATION_GET_ERROR) ? glGetError() : GL_NO_ERROR; }
+
+    STATE_CACHE&        SGL_DLLCALL StateCache() { return stateCache; }
+
+    const FRAME_STATISTICS& SGL_DLLCALL FrameStatistics() const     { return frameStatistics; }
+    const FRAME_STATISTICS& SGL_DLLCALL LastFrameStatistics() const { return lastFrameStatistics; }
+    void                SGL_DLLCALL ResetFrameStatistics()          { FinishFrameStatistics(); }
+
+    /** Get statistics of the current frame for update, use SGL_FRAME_STATISTICS macro instead. */
+    FRAME_STATISTICS&   SGL_DLLCALL MutableFrameStatistics() const { return frameStatistics; }
+
+    /** Bind buffer to the target if it is not bound already. */
+    void                SGL_DLLCALL BindBuffer(GLenum glTarget, GLuint glBuffer);
+
+    /** Get buffer bound to the target. GL is queried only if the cached binding is unknown. */
+    GLuint              SGL_DLLCALL BoundBuffer(GLenum glTarget) const;
+
+    /** Forget bindings of the buffer, must be called when buffer is deleted. */
+    void                SGL_DLLCALL ReleaseBuffer(GLuint glBuffer);
+
+#ifndef SIMPLE_GL_ES
+    /** Bind range of the buffer to the uniform buffer binding point if it is not bound already. Zero size binds whole buffer. */
+    void                SGL_DLLCALL BindUniformBuffer(GLuint bindingPoint, GLuint glBuffer, unsigned offset, unsigned size);
+
+    /** Get buffer bound to the uniform buffer binding point without querying GL. Unknown binding is reported as 0. */
+    GLuint              SGL_DLLCALL BoundUniformBuffer(GLuint bindingPoint) const;
+#endif
+
+    /** Get index of the current frame, incremented by SwapBuffers. */
+    unsigned            SGL_DLLCALL FrameIndex() const { return frameIndex; }
+
+    /** Check whether GPU finished commands of the frame. Doesn't stall, always false if fences are not supported. */
+    bool                SGL_DLLCALL FrameCompleted(unsigned frame) const;
+
+    /** Get framebuffer used when no render target is bound. Nonzero for the surfaceless offscreen device. */
+    GLuint              SGL_DLLCALL DefaultFramebuffer() const { return defaultFramebuffer; }
+
+    /** Check whether EXT_direct_state_access is available. */
+    bool                SGL_DLLCALL DirectStateAccess() const { return directStateAccess; }
+
+    /** Check whether KHR_parallel_shader_compile lets poll linking without waiting for the driver. */
+    bool                SGL_DLLCALL ParallelShaderCompile() const { return parallelShaderCompile; }
+
+    /** Track program linked asynchronously until Device::ProcessCompilation completes it. */
+    void                SGL_DLLCALL AddLinkingProgram(GLProgram* program);
+
+    /** Stop tracking program, must be called when linking is completed or program is deleted. */
+    void                SGL_DLLCALL RemoveLinkingProgram(GLProgram* program);
+
+    /** Check whether vertex layouts are stored in the cached vertex array objects. */
+    bool                SGL_DLLCALL VertexArrayObjects() const { return vertexArrayObjects; }
+
+    /** Set layout of the vertex array for the next draw. Captures buffer bound to the GL_ARRAY_BUFFER. */
+    void                SGL_DLLCALL SetVertexArrayLayout(const VertexLayout* vertexLayout);
+
+    /** Set index buffer of the vertex array for the next draw. */
+    void                SGL_DLLCALL SetVertexArrayIndexBuffer(GLuint glBuffer);
+
+    /** Delete vertex array objects using the layout, must be called when layout is deleted. */
+    void                SGL_DLLCALL ReleaseVertexArrays(const VertexLayout* vertexLayout);
+
     // ============================ STATES ============================ //
 
 	void                SGL_DLLCALL PushState(State::TYPE type);
@@ -102,6 +318,33 @@ public:
     FFPProgram*         SGL_DLLCALL FixedPipelineProgram()          { return ffpProgram.get(); }
     DeviceTraits*       SGL_DLLCALL Traits() const                  { return deviceTraits.get(); }
 
+    // ============================ TRANSFERS ============================ //
+
+    SGL_HRESULT         SGL_DLLCALL CopyBuffer( Buffer*         target,
+                                                unsigned        targetOffset,
+                                                const Buffer*   source,
+                                                unsigned        sourceOffset,
+                                                unsigned        size );
+
+    SGL_HRESULT         SGL_DLLCALL CopyBufferToTexture2D( Texture2D*      target,
+                                                           unsigned        mipmap,
+                                                           unsigned        offsetx,
+                                                           unsigned        offsety,
+                                                           unsigned        width,
+                                                           unsigned        height,
+                                                           const Buffer*   source,
+                                                           unsigned        sourceOffset );
+
+    SGL_HRESULT         SGL_DLLCALL CopyTexture2DToBuffer( Buffer*         target,
+                                                           unsigned        targetOffset,
+                                                           Texture2D*      source,
+                                                           unsigned        mipmap );
+
+    SGL_HRESULT         SGL_DLLCALL CopyFramebufferToBuffer( Buffer*            target,
+                                                             unsigned           targetOffset,
+                                                             const rectangle&   rect,
+                                                             Texture::FORMAT    format );
+
     // ============================ RETRIEVE ============================ //
 
     SGL_HRESULT         SGL_DLLCALL CopyTexture2D( Texture2D*     texture,
@@ -110,16 +353,61 @@ public:
                                                    unsigned       offsety,
                                                    unsigned       width,
                                                    unsigned       height ) const;
+
+    ReadbackRequest*    SGL_DLLCALL Readback(const rectangle& rect, Texture::FORMAT format) const;
 protected:
 	virtual ~GLDevice();
 
 private:
     virtual SGL_HRESULT InitOpenGL();
 
+#if defined(__linux__) && !defined(__ANDROID__) && defined(SIMPLE_GL_USE_EGL)
+    /* Create EGL context rendering into pbuffer or surfaceless context if pbuffers are not supported */
+    void InitOffscreenContext(const Device::VIDEO_DESC& desc);
+
+    /* Create framebuffer replacing window framebuffer for the surfaceless context */
+    void CreateDefaultFramebuffer(const Device::VIDEO_DESC& desc);
+#endif
+
+    /* Bind vertex array object if vertex array bindings changed, upload changed uniforms */
+    void PrepareDraw() const
+    {
+        if (vertexArrayDirty && vertexArrayObjects) {
+            BindVertexArray();
+        }
+
+        if (dirtyUniformsProgram) {
+            FlushUniforms();
+        }
+    }
+
+    /* Bind vertex array object for the current vertex array desc, create it if needed */
+    void BindVertexArray() const;
+
+#ifndef SIMPLE_GL_ES
+    /* Read commands of the emulated indirect draw from the buffer into the indirectCommands */
+    bool ReadIndirectCommands( const Buffer*  buffer,
+                               unsigned       offset,
+                               unsigned       numDraws,
+                               unsigned       stride,
+                               unsigned       commandSize ) const;
+#endif
+
+    /* Delete vertex array objects using the layout or the buffer */
+    void DeleteVertexArrays(const VertexLayout* vertexLayout, GLuint glBuffer);
+
+    /* Keep statistics of the finished frame and start new one */
+    void FinishFrameStatistics() const
+    {
+        lastFrameStatistics = frameStatistics;
+        frameStatistics     = FRAME_STATISTICS();
+    }
+
 protected:
     // current state
     const RenderTarget*     currentRenderTarget;
     const Program*          currentProgram;
+    mutable const GLProgram*    dirtyUniformsProgram;
     const IndexBuffer*      currentIndexBuffer;
     const VertexBuffer*     currentVertexBuffer;
     const VertexLayout*     currentVertexLayout;
@@ -133,6 +421,32 @@ protected:
     GLuint                      glIndexType;
     GLsizei                     glIndexSize;
     sgl::rectangle              viewport;
+    mutable STATE_CACHE         stateCache;
+    mutable FRAME_STATISTICS    frameStatistics;
+    mutable FRAME_STATISTICS    lastFrameStatistics;
+
+    // vertex array objects
+    mutable vertex_array_map    vertexArrays;
+    VERTEX_ARRAY_DESC           vertexArrayDesc;
+    mutable GLuint              boundVertexArray;
+    mutable bool                vertexArrayDirty;
+
+    // fences at the end of the last frames, GLsync
+    static const unsigned NUM_FRAME_FENCES = 4;
+
+    mutable void*               frameFences[NUM_FRAME_FENCES];
+    mutable unsigned            frameIndex;
+    mutable unsigned            numCompletedFrames;
+
+    // scratch memory for the multi draw calls
+    mutable std::vector<GLvoid*>            multiDrawOffsets;
+    mutable std::vector<unsigned char>      indirectCommands;
+
+    // scratch memory for the transfers without GPU copies
+    std::vector<unsigned char>              transferData;
+
+    // programs linked asynchronously, in the order of submission
+    std::vector<GLProgram*>                 linkingPrograms;
 
     // states
     state_stack					stateStack[State::__NUMBER_OF_STATES_WITH_SAMPLERS__];
@@ -151,9 +465,27 @@ protected:
     GLXDrawable glxDrawable;
     GLXWindow   glxWindow;
     GLXContext  glxContext;
+#   ifdef SIMPLE_GL_USE_EGL
+    EGLDisplay  eglDisplay;
+    EGLSurface  eglSurface;
+    EGLContext  eglContext;
+    GLuint      defaultRenderbuffers[2];
+#   endif
 #endif
+    GLuint      defaultFramebuffer;
 
     // settings
+    VALIDATION_MODE validationMode;
+    bool    directStateAccess;
+    bool    parallelShaderCompile;
+    bool    vertexArrayObjects;
+    bool    multiDraw;
+    bool    baseVertex;
+    bool    instancing;
+    bool    drawIndirect;
+    bool    multiDrawIndirect;
+    bool    bufferCopies;
+    bool    frameFencing;
     bool    makeCleanup;
     bool	valid;
 };
@@ -172,7 +504,7 @@ public:
 
 	Image*              SGL_DLLCALL CreateImage();
 	//Texture1D*          SGL_DLLCALL CreateTexture1D(const Texture::TEXTURE_1D_DESC& desc);
-	//TextureBuffer*      SGL_DLLCALL CreateTextureBuffer(const Texture::TEXTURE_BUFFER_DESC& desc);
+	TextureBuffer*      SGL_DLLCALL CreateTextureBuffer(const TextureBuffer::DESC& desc);
 	Texture2D*          SGL_DLLCALL CreateTexture2D(const Texture2D::DESC& desc);
 	Texture2D*          SGL_DLLCALL CreateTexture2DMS(const Texture2D::DESC_MS& desc);
 	Texture3D*          SGL_DLLCALL CreateTexture3D(const Texture3D::DESC& desc);
@@ -184,8 +516,9 @@ public:
 	VertexLayout*       SGL_DLLCALL CreateVertexLayout(unsigned int                 numElements, 
 													   const VertexLayout::ELEMENT* elements);
 
-	VertexBuffer*       SGL_DLLCALL CreateVertexBuffer();
-	IndexBuffer*        SGL_DLLCALL CreateIndexBuffer();
+	VertexBuffer*       SGL_DLLCALL CreateVertexBuffer(Buffer::UPDATE_POLICY policy = Buffer::UPDATE_IN_PLACE, unsigned numBuffers = 3);
+	IndexBuffer*        SGL_DLLCALL CreateIndexBuffer(Buffer::UPDATE_POLICY policy = Buffer::UPDATE_IN_PLACE, unsigned numBuffers = 3);
+	UniformBuffer*      SGL_DLLCALL CreateUniformBuffer(Buffer::UPDATE_POLICY policy = Buffer::UPDATE_IN_PLACE, unsigned numBuffers = 3);
 
 	// ============================ STATES ============================ //
 
@@ -197,9 +530,14 @@ public:
 	// ============================ OTHER ============================ //
 
 	Shader*             SGL_DLLCALL CreateShader(const Shader::DESC& desc);
+	Shader*             SGL_DLLCALL CreateShaderAsync(const Shader::DESC& desc);
 	Program*            SGL_DLLCALL CreateProgram();
 	Font*               SGL_DLLCALL CreateFont();
 	RenderTarget*       SGL_DLLCALL CreateRenderTarget();
+	CommandList*        SGL_DLLCALL CreateCommandList();
+	Query*              SGL_DLLCALL CreateQuery(const Query::DESC& desc);
+	StreamingBuffer*    SGL_DLLCALL CreateStreamingBuffer(Buffer* buffer, const StreamingBuffer::DESC& desc);
+	StreamOut*          SGL_DLLCALL CreateStreamOut();
 };
 
 } // namesapce sgl
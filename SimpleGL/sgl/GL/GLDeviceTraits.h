@@ -2,6 +2,7 @@
 #define SIMPLE_GL_GL_DEVICE_TRAITS_H
 
 #include "Device.h"
+#include <string>
 
 namespace sgl {
 
@@ -27,6 +28,14 @@ public:
     unsigned int SGL_DLLCALL MaxTextureWidth() const { return maxTextureWidth; }
     unsigned int SGL_DLLCALL MaxTextureHeight() const { return maxTextureHeight; }
 
+    unsigned int SGL_DLLCALL NumberOfUniformBufferBindings() const { return numUniformBufferBindings; }
+    unsigned int SGL_DLLCALL UniformBufferOffsetAlignment() const { return uniformBufferOffsetAlignment; }
+    unsigned int SGL_DLLCALL NumberOfStreamOutBuffers() const { return numStreamOutBuffers; }
+    unsigned int SGL_DLLCALL MaxTextureBufferSize() const { return maxTextureBufferSize; }
+    unsigned int SGL_DLLCALL TextureBufferOffsetAlignment() const { return textureBufferOffsetAlignment; }
+
+    const char* SGL_DLLCALL DriverIdentity() const { return driverIdentity.c_str(); }
+
     unsigned int SGL_DLLCALL FindSupportedTextureFormats(Texture2D::FORMAT* formats) const;
 
 private:
@@ -46,6 +55,12 @@ private:
     unsigned int numCombinedTIU;
     unsigned int maxTextureWidth;
     unsigned int maxTextureHeight;
+    unsigned int numUniformBufferBindings;
+    unsigned int uniformBufferOffsetAlignment;
+    unsigned int numStreamOutBuffers;
+    unsigned int maxTextureBufferSize;
+    unsigned int textureBufferOffsetAlignment;
+    std::string  driverIdentity;
 };
 
 } // namespace sgl
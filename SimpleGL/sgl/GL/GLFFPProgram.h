@@ -18,6 +18,9 @@ public:
     // Work
     bool                SGL_DLLCALL IsDirty() const         { return false; }
     SGL_HRESULT         SGL_DLLCALL Dirty(bool /*force*/)   { return SGL_OK; }
+    SGL_HRESULT         SGL_DLLCALL DirtyAsync(bool /*force*/)  { return SGL_OK; }
+    bool                SGL_DLLCALL IsReady()               { return true; }
+    bool                SGL_DLLCALL IsLinking() const       { return false; }
     void                SGL_DLLCALL Clear()                 {}
     SGL_HRESULT         SGL_DLLCALL Bind() const;
     void                SGL_DLLCALL Unbind() const;
@@ -39,9 +42,30 @@ public:
     int                 SGL_DLLCALL AttributeLocation(const char* /*name*/) const { return -1; }
     unsigned            SGL_DLLCALL NumAttributes() const                         { return 0; }
     ATTRIBUTE           SGL_DLLCALL Attribute(unsigned /*index*/) const           { sglSetError(SGLERR_INVALID_CALL, "FFP program doesn't have generic attributes"); return ATTRIBUTE(); }
+    SGL_HRESULT         SGL_DLLCALL BindFragDataLocation(const char* name, unsigned colorNumber);
+
+    /* Uniform blocks */
+    SGL_HRESULT         SGL_DLLCALL SetUniformBlockBinding(const char* name, unsigned bindingPoint);
+    int                 SGL_DLLCALL UniformBlockIndex(const char* /*name*/) const         { return -1; }
+    unsigned            SGL_DLLCALL NumUniformBlocks() const                            { return 0; }
+    UNIFORM_BLOCK       SGL_DLLCALL UniformBlock(unsigned /*index*/) const              { sglSetError(SGLERR_INVALID_CALL, "FFP program doesn't have uniform blocks"); return UNIFORM_BLOCK(); }
+    int                 SGL_DLLCALL UniformBlockMemberOffset(const char* /*name*/) const  { return -1; }
+
+    /* Stream output */
+    SGL_HRESULT         SGL_DLLCALL SetTransformFeedbackVaryings( unsigned                 numVaryings,
+                                                                  const char**             varyings,
+                                                                  TRANSFORM_FEEDBACK_MODE  mode );
+    unsigned            SGL_DLLCALL NumTransformFeedbackVaryings() const                { return 0; }
+    const char*         SGL_DLLCALL TransformFeedbackVarying(unsigned /*index*/) const  { return 0; }
+    TRANSFORM_FEEDBACK_MODE SGL_DLLCALL TransformFeedbackMode() const                   { return INTERLEAVED_ATTRIBS; }
+
+    /* Binaries */
+    unsigned            SGL_DLLCALL GetBinary(unsigned& /*format*/, void* /*data*/, unsigned /*size*/) const { return 0; }
+    SGL_HRESULT         SGL_DLLCALL LoadBinary(unsigned format, const void* data, unsigned size);
 
     /* Standart uniforms */
     AbstractUniform*    SGL_DLLCALL GetUniform(const char* /*name*/) const  { return 0; }
+    AbstractUniform*    SGL_DLLCALL GetUniform(const UniformName& /*name*/) const { return 0; }
 
     Uniform4x4F*        SGL_DLLCALL GetModelViewMatrixUniform() const       { return modelViewMatrixUniform.get(); }
     Uniform4x4F*        SGL_DLLCALL GetProjectionMatrixUniform() const      { return projectionMatrixUniform.get(); }
@@ -83,6 +107,7 @@ public:
     SamplerUniform2D*   SGL_DLLCALL GetSamplerUniform2D(const char* /*name*/) const   { return 0; }
     SamplerUniform3D*   SGL_DLLCALL GetSamplerUniform3D(const char* /*name*/) const   { return 0; }
     SamplerUniformCube* SGL_DLLCALL GetSamplerUniformCube(const char* /*name*/) const { return 0; }
+    SamplerUniformBuffer* SGL_DLLCALL GetSamplerUniformBuffer(const char* /*name*/) const { return 0; }
 
 private:
     GLDevice*    device;
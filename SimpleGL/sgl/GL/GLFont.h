@@ -24,11 +24,13 @@ protected:
     GLDevice*					device;
     ref_ptr<Texture2D>          texture;
     ref_ptr<VertexBuffer>       vbo;
+    ref_ptr<StreamingBuffer>    stream;
     ref_ptr<VertexLayout>       vertexLayout;
     ref_ptr<RasterizerState>    rasterizerState;
     ref_ptr<BlendState>         blendState;
     ref_ptr<DepthStencilState>  depthStencilState;
     mutable std::vector<float>  data;
+    mutable unsigned            frameIndex;     // frame of the last print
 
     mutable float vpWidth;
     mutable float vpHeight;
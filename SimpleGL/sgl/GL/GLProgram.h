@@ -13,6 +13,8 @@ class GLUniform;
 template<typename T>
 class GLSamplerUniform;
 
+class GLShadowedUniform;
+
 /* Wraps gl function for working with shader programs */
 
 class GLProgram :
@@ -43,6 +45,49 @@ private:
     };
     typedef std::vector<attribute>              attribute_vector;
 
+    struct uniform_block
+    {
+        unsigned            index;
+        unsigned            size;
+        unsigned            bindingPoint;
+        std::string         name;
+
+        // convert to UNIFORM_BLOCK
+        UNIFORM_BLOCK to_UNIFORM_BLOCK() const
+        {
+            UNIFORM_BLOCK block;
+            block.index        = index;
+            block.size         = size;
+            block.bindingPoint = bindingPoint;
+            block.name         = name.c_str();
+            return block;
+        }
+    };
+    typedef std::vector<uniform_block>          uniform_block_vector;
+
+    struct uniform_block_member
+    {
+        std::string         name;
+        int                 offset;
+    };
+    typedef std::vector<uniform_block_member>   uniform_block_member_vector;
+
+    // binding points requested by the user, kept between relinks
+    typedef std::vector< std::pair<std::string, unsigned> >  block_binding_vector;
+
+    typedef std::vector<std::string>            string_vector;
+
+    // slot of the open addressing uniform table, keyed by the name prefix of nameLength characters
+    struct uniform_slot
+    {
+        unsigned            hash;
+        unsigned            nameLength;
+        AbstractUniform*    uniform;
+    };
+    typedef std::vector<uniform_slot>           uniform_table;
+
+    typedef std::vector<GLShadowedUniform*>     shadowed_uniform_vector;
+
 
 private:
     AbstractUniform* CreateUniform( GLProgram*  program,
@@ -52,6 +97,24 @@ private:
                                     GLenum      glUniformType,
                                     size_t      size );
 
+    /* Clear hash table of the uniforms and allocate slots for the uniforms */
+    void ResetUniformTable(unsigned numUniforms);
+
+    /* Insert uniform into the table under its name and array name without [0] */
+    void InsertUniform(AbstractUniform* uniform);
+
+    /* Insert uniform into the table under the name prefix */
+    void InsertUniform(AbstractUniform* uniform, unsigned nameLength);
+
+    /* Find uniform in the table */
+    AbstractUniform* FindUniform(const char* name, unsigned hash) const;
+
+    /* Attach shaders and start linking */
+    void SubmitLink();
+
+    /* Enumerate uniforms, uniform blocks and attributes of the linked program */
+    void EnumerateInterface();
+
 public:
     GLProgram(GLDevice* deviceState);
     ~GLProgram();
@@ -62,6 +125,9 @@ public:
 
     bool            SGL_DLLCALL IsDirty() const { return dirty; } 
     SGL_HRESULT     SGL_DLLCALL Dirty(bool force = false);
+    SGL_HRESULT     SGL_DLLCALL DirtyAsync(bool force = false);
+    bool            SGL_DLLCALL IsReady();
+    bool            SGL_DLLCALL IsLinking() const { return linking; }
     const char*     SGL_DLLCALL CompilationLog() const;
     void            SGL_DLLCALL Clear();
 
@@ -73,6 +139,30 @@ public:
     int             SGL_DLLCALL AttributeLocation(const char* name) const;
     unsigned        SGL_DLLCALL NumAttributes() const { return attributes.size(); }
     ATTRIBUTE       SGL_DLLCALL Attribute(unsigned index) const;
+    SGL_HRESULT     SGL_DLLCALL BindFragDataLocation(const char* name, unsigned colorNumber);
+
+    // Uniform blocks
+    SGL_HRESULT     SGL_DLLCALL SetUniformBlockBinding(const char* name, unsigned bindingPoint);
+    int             SGL_DLLCALL UniformBlockIndex(const char* name) const;
+    unsigned        SGL_DLLCALL NumUniformBlocks() const { return uniformBlocks.size(); }
+    UNIFORM_BLOCK   SGL_DLLCALL UniformBlock(unsigned index) const;
+    int             SGL_DLLCALL UniformBlockMemberOffset(const char* name) const;
+
+    // Stream output
+    SGL_HRESULT     SGL_DLLCALL SetTransformFeedbackVaryings( unsigned                 numVaryings,
+                                                              const char**             varyings,
+                                                              TRANSFORM_FEEDBACK_MODE  mode );
+    unsigned        SGL_DLLCALL NumTransformFeedbackVaryings() const { return feedbackVaryings.size(); }
+    const char*     SGL_DLLCALL TransformFeedbackVarying(unsigned index) const { return feedbackVaryings[index].c_str(); }
+    TRANSFORM_FEEDBACK_MODE SGL_DLLCALL TransformFeedbackMode() const { return feedbackMode; }
+
+    // Binaries
+    unsigned        SGL_DLLCALL GetBinary( unsigned&    format,
+                                           void*        data,
+                                           unsigned     size ) const;
+    SGL_HRESULT     SGL_DLLCALL LoadBinary( unsigned       format,
+                                            const void*    data,
+                                            unsigned       size );
 
     // Geometry shaders
     void            SGL_DLLCALL SetGeometryNumVerticesOut(unsigned int maxNumVertices);
@@ -85,6 +175,7 @@ public:
 
     // Uniforms
     AbstractUniform* SGL_DLLCALL GetUniform(const char* name) const;
+    AbstractUniform* SGL_DLLCALL GetUniform(const UniformName& name) const;
     
     template<typename T>
     GLUniform<T>* GetUniform(const char* name) const
@@ -120,15 +211,41 @@ public:
     SamplerUniform2D*   SGL_DLLCALL GetSamplerUniform2D(const char* name) const;
     SamplerUniform3D*   SGL_DLLCALL GetSamplerUniform3D(const char* name) const;
     SamplerUniformCube* SGL_DLLCALL GetSamplerUniformCube(const char* name) const;
+    SamplerUniformBuffer* SGL_DLLCALL GetSamplerUniformBuffer(const char* name) const;
 
     /** Get OpenGL program handle */
     GLuint SGL_DLLCALL Handle() const { return glProgram; }
 
+    /** Queue changed uniform for the upload before the next draw. Program must be current. */
+    void QueueUniform(GLShadowedUniform* uniform) const;
+
+    /** Upload queued uniforms. Program must be current. */
+    void FlushUniforms() const;
+
+    /** Check whether the driver finished linking without waiting for it. Always false without KHR_parallel_shader_compile. */
+    bool LinkCompleted() const;
+
+    /** Wait for the linking and check its result. */
+    SGL_HRESULT FinishLink();
+
 private:
     GLDevice*			device;
     shader_vector       shaders;
     attribute_vector    attributes;
     uniform_ptr*        uniforms;
+    uniform_table       uniformTable;
+
+    // uniforms changed since the last draw
+    mutable shadowed_uniform_vector dirtyUniforms;
+
+    // uniform blocks
+    uniform_block_vector        uniformBlocks;
+    uniform_block_member_vector uniformBlockMembers;
+    block_binding_vector        blockBindings;
+
+    // stream output
+    string_vector               feedbackVaryings;
+    TRANSFORM_FEEDBACK_MODE     feedbackMode;
 
     // geometry shaders
     unsigned int        numActiveUniforms;
@@ -139,6 +256,7 @@ private:
     // data
     GLuint              glProgram;
     bool                dirty;
+    bool                linking;
 
     // log
     std::string         compilationLog;
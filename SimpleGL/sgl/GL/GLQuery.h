@@ -0,0 +1,47 @@
+#ifndef SIMPLE_GL_GL_QUERY_H
+#define SIMPLE_GL_GL_QUERY_H
+
+#include "GLForward.h"
+#include "../Query.h"
+#include <vector>
+
+namespace sgl {
+
+/* Query using ring of the GL query objects */
+class GLQuery :
+    public ResourceImpl<Query>
+{
+public:
+    GLQuery( GLDevice*      device,
+             const DESC&    desc );
+    ~GLQuery();
+
+    // Override Query
+    TYPE        SGL_DLLCALL Type() const        { return type; }
+    SGL_HRESULT SGL_DLLCALL Begin();
+    SGL_HRESULT SGL_DLLCALL End();
+    bool        SGL_DLLCALL ResultAvailable() const;
+    SGL_HRESULT SGL_DLLCALL GetResult(unsigned long long& result, bool wait);
+    unsigned    SGL_DLLCALL NumPending() const  { return numPending; }
+
+    /** Check whether query type is supported by the current context */
+    static bool SupportsType(TYPE type);
+
+private:
+    typedef std::vector<unsigned> query_vector;
+
+private:
+    GLDevice*       device;
+
+    // data
+    TYPE            type;
+    unsigned        glTarget;
+    query_vector    queries;
+    unsigned        head;           // oldest pending query
+    unsigned        numPending;
+    bool            active;
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_GL_QUERY_H
@@ -0,0 +1,60 @@
+#ifndef SIMPLE_GL_GL_READBACK_REQUEST_H
+#define SIMPLE_GL_GL_READBACK_REQUEST_H
+
+#include "GLForward.h"
+#include "../ReadbackRequest.h"
+#include "../Texture.h"
+
+namespace sgl {
+
+/* Readback into the pixel pack buffer guarded by the fence */
+class GLReadbackRequest :
+    public ResourceImpl<ReadbackRequest>
+{
+public:
+    GLReadbackRequest( GLDevice*    device,
+                       unsigned     size );
+    ~GLReadbackRequest();
+
+    // Override ReadbackRequest
+    unsigned    SGL_DLLCALL Size() const    { return size; }
+    bool        SGL_DLLCALL IsReady() const;
+    SGL_HRESULT SGL_DLLCALL Wait();
+    SGL_HRESULT SGL_DLLCALL Map(const void** data);
+    SGL_HRESULT SGL_DLLCALL Unmap();
+
+    /** Get buffer the data must be copied into. */
+    unsigned PackBuffer() const { return glBuffer; }
+
+    /** Insert fence after the copy commands, must be called once after issuing the copy. */
+    SGL_HRESULT Issue();
+
+    /** Check whether pixel buffer objects are supported by the current context. */
+    static bool Supported();
+
+    /** Start readback of the framebuffer bound for reading. */
+    static GLReadbackRequest* ReadPixels( GLDevice*          device,
+                                          const rectangle&   rect,
+                                          Texture::FORMAT    format );
+
+    /** Start readback of the image of the texture bound to the active stage. */
+    static GLReadbackRequest* ReadTexImage( GLDevice*        device,
+                                            unsigned         glTarget,
+                                            unsigned         mipmap,
+                                            Texture::FORMAT  format,
+                                            unsigned         width,
+                                            unsigned         height );
+
+private:
+    GLDevice*       device;
+
+    // data
+    unsigned        glBuffer;
+    mutable void*   fence;      // GLsync, 0 once the copy is finished
+    unsigned        size;
+    bool            mapped;
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_GL_READBACK_REQUEST_H
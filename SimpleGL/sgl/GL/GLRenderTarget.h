@@ -145,6 +145,8 @@ public:
     bool            SGL_DLLCALL IsDirty() const;
     SGL_HRESULT     SGL_DLLCALL Dirty(bool force = false);
 
+    ReadbackRequest* SGL_DLLCALL Readback(const rectangle& rect, Texture::FORMAT format) const;
+
     SGL_HRESULT     SGL_DLLCALL SetReadBuffer(unsigned int target);
     SGL_HRESULT     SGL_DLLCALL SetDrawBuffer(unsigned int target);
     SGL_HRESULT     SGL_DLLCALL SetDrawBuffers( unsigned int    numTargets,
@@ -13,7 +13,8 @@ class GLShader :
 {
 public:
     GLShader( GLDevice*		device, 
-              const DESC&   desc );
+              const DESC&   desc,
+              bool          async = false );
     ~GLShader();
 
     // Override Shader
@@ -23,6 +24,9 @@ public:
 
     /** Get OpenGL shader handle */
     unsigned SGL_DLLCALL Handle() const { return shader; }
+
+    /** Check compile status, waits for the compiler. Fills the compilation log if compilation failed. */
+    bool QueryStatus();
  
 protected:
     GLDevice*    device;
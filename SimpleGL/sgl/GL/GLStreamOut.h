@@ -1,65 +1,64 @@
 #ifndef SIMPLE_GL_GL_STREAM_OUT_H
 #define SIMPLE_GL_GL_STREAM_OUT_H
 
+#include "GLForward.h"
 #include "../StreamOut.h"
-#include "GLVertexBuffer.h"
-#include "GLProgram.h"
 #include <vector>
 
 namespace sgl {
 
 /** OpenGL stream output implementation via TranformFeedback */
-class GLStreamOut : 
-    public StreamOut
+class GLStreamOut :
+    public ResourceImpl<StreamOut>
 {
 private:
-    typedef std::vector<DeclarationEntry>           declaration_vector;
-    typedef std::vector< ref_ptr<GLVertexBuffer> >  target_vector;
+    typedef std::vector< ref_ptr<VertexBuffer> >    target_vector;
+    typedef std::vector<unsigned>                   offset_vector;
 
 public:
-    GLStreamOut(GLProgram* _program);
+    GLStreamOut(GLDevice* device);
     ~GLStreamOut();
 
     // Override StreamOut
-    Program* SGL_DLLCALL MasterProgram() const { return program; }
+    SGL_HRESULT     SGL_DLLCALL SetPrimitiveType(PRIMITIVE_TYPE primitiveType);
+    PRIMITIVE_TYPE  SGL_DLLCALL PrimitiveType() const { return primitiveType; }
 
-    void SGL_DLLCALL SetMode(MODE _streamOutMode) { streamOutMode = _streamOutMode; }
-    MODE SGL_DLLCALL Mode() const { return streamOutMode; }
-
-    SGL_HRESULT SGL_DLLCALL SetPrimitiveType(PRIMITIVE_TYPE primitiveType);
-    PRIMITIVE_TYPE SGL_DLLCALL PrimitiveType() const { return primitiveType; }
-   
-    SGL_HRESULT         SGL_DLLCALL SetStreamOutDecl(unsigned int numEntries, DeclarationEntry* soDecl);
-    unsigned int        SGL_DLLCALL NumDeclEntries() const { return declaration.size(); }
-    DeclarationEntry    SGL_DLLCALL DeclEntry(unsigned int index) const { return declaration[index]; }
-    
-    SGL_HRESULT     SGL_DLLCALL SetTargets(unsigned int numEntries, VertexBuffer** vbos);
+    SGL_HRESULT     SGL_DLLCALL SetTargets( unsigned int       numEntries,
+                                            VertexBuffer**     vbos,
+                                            const unsigned*    offsets );
     unsigned int    SGL_DLLCALL NumTargets() const { return targets.size(); }
     VertexBuffer*   SGL_DLLCALL Target(unsigned int index) const { return targets[index].get(); }
+    unsigned        SGL_DLLCALL TargetOffset(unsigned int index) const { return targetOffsets[index]; }
+
+    SGL_HRESULT     SGL_DLLCALL SetQuery(Query* query);
+    Query*          SGL_DLLCALL CurrentQuery() const { return query.get(); }
 
-    SGL_HRESULT SGL_DLLCALL Dirty(bool force = false);
+    void            SGL_DLLCALL SetRasterizerDiscard(bool discard) { rasterizerDiscard = discard; }
+    bool            SGL_DLLCALL RasterizerDiscard() const { return rasterizerDiscard; }
 
-    /** Bind stream output stage 
-     * @return result of the operation. Same as in Dirty.
-     * @see Dirty
-     */
-    SGL_HRESULT SGL_DLLCALL Bind() const;
+    SGL_HRESULT     SGL_DLLCALL Begin();
+    SGL_HRESULT     SGL_DLLCALL End();
+    SGL_HRESULT     SGL_DLLCALL Pause();
+    SGL_HRESULT     SGL_DLLCALL Resume();
+    bool            SGL_DLLCALL Active() const { return active; }
+    bool            SGL_DLLCALL Paused() const { return paused; }
 
-    /** Unbind stream output stage */
-    void SGL_DLLCALL Unbind() const;
+    /** Check whether stream output is supported by the current context */
+    static bool Supported();
 
 private:
-    GLProgram*          program;
+    GLDevice*           device;
 
     // settings
-    bool                dirty;
-    MODE                streamOutMode;
     PRIMITIVE_TYPE      primitiveType;
-    declaration_vector  declaration;
     target_vector       targets;
+    offset_vector       targetOffsets;
+    ref_ptr<Query>      query;
+    bool                rasterizerDiscard;
 
-    // openGL
-    char**              feedbackVaryings;
+    // state
+    bool                active;
+    bool                paused;
 };
 
 } // namespace sgl
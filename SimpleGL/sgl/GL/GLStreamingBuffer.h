@@ -0,0 +1,62 @@
+#ifndef SIMPLE_GL_GL_STREAMING_BUFFER_H
+#define SIMPLE_GL_GL_STREAMING_BUFFER_H
+
+#include "GLForward.h"
+#include "../StreamingBuffer.h"
+#include <vector>
+
+namespace sgl {
+
+/* Streaming buffer over the buffer created by the GLDevice */
+class GLStreamingBuffer :
+    public ResourceImpl<StreamingBuffer>
+{
+public:
+    GLStreamingBuffer( GLDevice*       device,
+                       sgl::Buffer*    buffer,
+                       const DESC&     desc );
+    ~GLStreamingBuffer();
+
+    // Override StreamingBuffer
+    sgl::Buffer* SGL_DLLCALL TargetBuffer() const   { return buffer.get(); }
+    bool         SGL_DLLCALL Persistent() const     { return mode == PERSISTENT; }
+    void*        SGL_DLLCALL Allocate(unsigned size, unsigned alignment, unsigned& offset);
+    SGL_HRESULT  SGL_DLLCALL Commit();
+    SGL_HRESULT  SGL_DLLCALL EndFrame();
+
+private:
+    enum MODE
+    {
+        PERSISTENT, // coherent persistent mapping of the whole buffer
+        MAP_RANGE,  // map every allocation, unsynchronized if fences are available
+        STAGING     // copy allocations through SetSubData
+    };
+
+    typedef std::vector<char>   char_vector;
+    typedef std::vector<void*>  fence_vector;
+
+private:
+    /** Fence current region, wait until the next one is released by the GPU */
+    SGL_HRESULT NextRegion();
+
+private:
+    GLDevice*               device;
+    ref_ptr<sgl::Buffer>    buffer;
+
+    // data
+    MODE            mode;
+    bool            fenced;
+    unsigned        numRegions;
+    unsigned        regionSize;
+    unsigned        region;
+    unsigned        regionOffset;   // allocated bytes in the current region
+    unsigned        pendingOffset;
+    unsigned        pendingSize;    // size of the chunk waiting for Commit
+    char*           persistentData;
+    char_vector     staging;
+    fence_vector    fences;         // GLsync per region
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_GL_STREAMING_BUFFER_H
@@ -38,6 +38,7 @@ public:
                                              const void*     data );
     SGL_HRESULT     SGL_DLLCALL GetImage( unsigned int  mipmap,
                                           void*         data );
+    ReadbackRequest* SGL_DLLCALL Readback(unsigned int mipmap);
 
     SGL_HRESULT     SGL_DLLCALL BindSamplerState(SamplerState* samplerState);
     SGL_HRESULT     SGL_DLLCALL Bind(unsigned int stage) const;
@@ -1,55 +1,58 @@
-#ifndef SIMPLE_GL_GL_TEXTURE_1D_H
-#define SIMPLE_GL_GL_TEXTURE_1D_H
+#ifndef SIMPLE_GL_GL_TEXTURE_BUFFER_H
+#define SIMPLE_GL_GL_TEXTURE_BUFFER_H
 
-#include "Texture1D.h"
 #include "GLTexture.h"
 
-#ifdef SIMPLE_GL_USE_SDL_IMAGE
-#   include <SDL_image.h>
-#endif
+#ifndef SIMPLE_GL_ES
 
 namespace sgl {
 
-/* GL texture wrapper */
-class GLTexture1D :
-    public GLTexture<Texture1D>
+class GLTextureBuffer :
+    public GLTexture<TextureBuffer>
 {
-friend class GLDevice;
-protected:
-    GLTexture1D(Device* _pDevice);
-
 public:
-    // type of the texture
-    TYPE SGL_DLLCALL Type() const { return TEXTURE_1D; }
-
-    // create the texture with specified parameters
-    void SGL_DLLCALL Clear();
-
-    // files
-    SGL_HRESULT SGL_DLLCALL LoadFromFile(const char* fileName);
-    SGL_HRESULT SGL_DLLCALL SaveToFile(const char* fileName) const;
-
-    // creation
-    SGL_HRESULT SGL_DLLCALL SetImage(FORMAT _format, unsigned int _size, const void* _data);
-    void        SGL_DLLCALL SetResizeNonPowerOfTwoHint(bool toggle);
-
-    // properties
-    unsigned int    SGL_DLLCALL Size() const                    { return size; }
-    FORMAT          SGL_DLLCALL Format() const                  { return format; }
-    bool            SGL_DLLCALL ResizeNonPowerOfTwoHint() const { return resizeNonPowerOfTwo; }
+    typedef GLTexture<TextureBuffer>    base_type;
 
-    /** Get OpenGL texture format */
-    GLenum SGL_DLLCALL GLFormat() const;
-
-    virtual ~GLTexture1D();
-
-protected:
-    // settings
-    unsigned int	size;
-    FORMAT          format;
-    bool            resizeNonPowerOfTwo;
+public:
+    GLTextureBuffer(GLDevice* device);
+    ~GLTextureBuffer();
+
+    // Override TextureBuffer
+    Texture::TYPE   SGL_DLLCALL Type() const            { return Texture::TEXTURE_BUFFER; }
+    Texture::FORMAT SGL_DLLCALL Format() const          { return format; }
+    Buffer*         SGL_DLLCALL TargetBuffer() const    { return buffer.get(); }
+    unsigned int    SGL_DLLCALL Offset() const          { return offset; }
+    unsigned int    SGL_DLLCALL Size() const;
+    unsigned int    SGL_DLLCALL NumTexels() const;
+
+    SGL_HRESULT     SGL_DLLCALL SetBuffer( Buffer*         buffer,
+                                           FORMAT          format,
+                                           unsigned int    offset,
+                                           unsigned int    size );
+
+    SGL_HRESULT SGL_DLLCALL Bind(unsigned int stage) const;
+    void        SGL_DLLCALL Unbind() const;
+
+    /** Check whether texture buffers are supported by the current context */
+    static bool Supported();
+
+private:
+    /** Attach buffer to the texture bound to the active stage if it was changed or reallocated */
+    void AttachBuffer() const;
+
+private:
+    Texture::FORMAT     format;
+    ref_ptr<Buffer>     buffer;
+    unsigned int        offset;
+    unsigned int        size;
+
+    // attachment
+    mutable GLuint          attachedBuffer;
+    mutable unsigned int    attachedSize;
 };
 
 } // namespace sgl
 
-#endif // SIMPLE_GL_GL_TEXTURE_2D_H
+#endif // !defined(SIMPLE_GL_ES)
+
+#endif // SIMPLE_GL_GL_TEXTURE_BUFFER_H
@@ -40,6 +40,8 @@ public:
     SGL_HRESULT     SGL_DLLCALL GetImage( unsigned int  mipmap,
                                           void*         data );
 
+    ReadbackRequest* SGL_DLLCALL Readback(unsigned int mipmap);
+
     SGL_HRESULT     SGL_DLLCALL BindSamplerState(SamplerState*)    { return EInvalidCall("Can't setup sampler state to cubemap side."); }
     SGL_HRESULT     SGL_DLLCALL Bind(unsigned int) const           { return EInvalidCall("Can't bind cube map side as 2D sampler."); }
     void            SGL_DLLCALL Unbind() const                     {}
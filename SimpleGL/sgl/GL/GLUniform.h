@@ -2,9 +2,23 @@
 #define SIMPLE_GL_GL_UNIFORM_H
 
 #include "GLTexture.h"
+#include <vector>
 
 namespace sgl {
 
+/* Uniform keeping the copy of its values. Changed values are
+ * uploaded by the master program right before the draw.
+ */
+class GLShadowedUniform
+{
+public:
+    /** Upload changed values, master program must be current */
+    virtual void Flush() = 0;
+
+protected:
+    virtual ~GLShadowedUniform() {}
+};
+
 template<typename Interface>
 class GLUniformBase :
     public ReferencedImpl<Interface>
@@ -49,7 +63,8 @@ protected:
 /* GL typed uniform */
 template<typename T>
 class GLUniform :
-    public GLUniformBase< Uniform<T> >
+    public GLUniformBase< Uniform<T> >,
+    public GLShadowedUniform
 {
 public:
     typedef GLUniformBase< Uniform<T> >  base_type;
@@ -63,7 +78,10 @@ public:
                GLuint               glLocation,
                size_t               _numValues ) :
         base_type(device, program, name, glProgram, glIndex, glLocation),
-        numValues(_numValues)
+        numValues(_numValues),
+        values(_numValues),
+        numValidValues(0),
+        numDirtyValues(0)
     {}
 
     // Override Uniform
@@ -75,8 +93,20 @@ public:
     unsigned int    SGL_DLLCALL Size() const { return numValues; }
     void            SGL_DLLCALL QueryValues(T* values) const;
 
+    // Override GLShadowedUniform
+    void Flush();
+
+private:
+    /* Copy values to the shadow and queue uniform for the upload if they changed */
+    void Store(const T* newValues, size_t count);
+
 private:
-    size_t numValues;
+    size_t          numValues;
+
+    // shadow, first numValidValues match the program, first numDirtyValues wait for the upload
+    std::vector<T>  values;
+    size_t          numValidValues;
+    size_t          numDirtyValues;
 };
 
 /* GL sampler uniform */
@@ -94,27 +124,42 @@ public:
                       GLuint                glProgram,
                       GLuint                glStage,
                       GLuint                glLocation ) :
-        base_type(device, program, name, glProgram, glStage, glLocation)
+        base_type(device, program, name, glProgram, glStage, glLocation),
+        stage(-1)
     {}
 
     AbstractUniform::TYPE SGL_DLLCALL Type() const;
 
-    void SGL_DLLCALL Set(unsigned int stage, const T* texture)
+    void SGL_DLLCALL Set(unsigned int stage_, const T* texture)
     {
         assert( base_type::device->CurrentProgram() == base_type::program );
         if (texture) {
-            texture->Bind(stage);
+            texture->Bind(stage_);
+        }
+
+        // texture is bound immediately, so stage is set immediately too
+        if (stage != int(stage_))
+        {
+            glUniform1i(base_type::glLocation, stage_);
+            SGL_FRAME_STATISTICS(base_type::device, numUniformCalls, 1);
+            stage = stage_;
         }
-        glUniform1i(base_type::glLocation, stage);
     }
 
     unsigned int SGL_DLLCALL Value() const
     {
-        assert( base_type::device->CurrentProgram() == base_type::program );
+        if (stage >= 0) {
+            return stage;
+        }
+
         int value;
         glGetUniformiv(base_type::glProgram, base_type::glLocation, &value);
+        SGL_FRAME_STATISTICS(base_type::device, numGetQueries, 1);
         return value;
     }
+
+private:
+    int stage; // shadow, -1 if not set yet
 };
 
 } // namespace sgl
@@ -1,24 +1,25 @@
-#ifndef SIMPLE_GL_GL_CONSTANT_BUFFER_H
-#define SIMPLE_GL_GL_CONSTANT_BUFFER_H
+#ifndef SIMPLE_GL_GL_UNIFORM_BUFFER_H
+#define SIMPLE_GL_GL_UNIFORM_BUFFER_H
 
 #include "GLBuffer.h"
+#include "../UniformBuffer.h"
 
 namespace sgl {
 
-/* Vertex buffer object interface */
-class GLConstantBuffer :
-    public GLBuffer<ConstantBuffer>
+template<typename BufferImpl>
+class GLUniformBuffer :
+    public BufferImpl
 {
-friend class GLDevice;
-protected:
-    GLConstantBuffer(Device* _pDevice);
-
 public:
-    virtual TYPE SGL_DLLCALL Type() const { return CONSTANT_BUFFER; }
+    GLUniformBuffer(GLDevice* device);
+    ~GLUniformBuffer();
 
-    virtual ~GLConstantBuffer() {}
+    // Override UniformBuffer
+    SGL_HRESULT SGL_DLLCALL Bind(unsigned bindingPoint) const;
+    SGL_HRESULT SGL_DLLCALL BindRange(unsigned bindingPoint, unsigned offset, unsigned size) const;
+    void        SGL_DLLCALL Unbind(unsigned bindingPoint) const;
 };
 
-}
+} // namespace sgl
 
-#endif // SIMPLE_GL_GL_CONSTANT_BUFFER_H
+#endif // SIMPLE_GL_GL_UNIFORM_BUFFER_H
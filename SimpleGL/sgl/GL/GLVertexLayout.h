@@ -47,6 +47,9 @@ public:
 	void SGL_DLLCALL Bind() const;
 	void SGL_DLLCALL Unbind() const;
 
+	/** Enable and setup all attributes of the layout using buffer bound to the GL_ARRAY_BUFFER. */
+	void SetupAttributes() const;
+
 private:
 	GLDevice*				device;
 	std::vector<ELEMENT>	elements;
@@ -28,6 +28,13 @@ class Program :
 	public Resource
 {
 public:
+    /// Layout of the varyings captured by the stream output
+    enum TRANSFORM_FEEDBACK_MODE
+    {
+        INTERLEAVED_ATTRIBS,    /// varyings are written one by one into single buffer
+        SEPARATE_ATTRIBS        /// every varying is written into its own buffer
+    };
+
     struct ATTRIBUTE
     {
         unsigned            index;
@@ -36,6 +43,14 @@ public:
         sgl::SCALAR_TYPE    type;
     };
 
+    struct UNIFORM_BLOCK
+    {
+        unsigned            index;          /// index of the block in the program
+        unsigned            size;           /// minimum size of the buffer data sourcing the block
+        unsigned            bindingPoint;   /// uniform buffer binding point of the block
+        const char*         name;
+    };
+
 public:
     /** Attach shader to the program. Program becames dirty.
      * @return Result of the operation. Could be EInvalidCall if the shader is invalid
@@ -60,6 +75,22 @@ public:
      */
     virtual SGL_HRESULT SGL_DLLCALL Dirty(bool force = false) = 0;
 
+    /** Start recreating the program without waiting for the driver. Program becomes valid when
+     * IsReady returns true, renderer can use fallback program meanwhile. Errors are reported
+     * when linking is completed by IsReady, Dirty or Device::ProcessCompilation.
+     * @param force recreation even if it is already initialized.
+     * @return result of the operation. Can be SGLERR_INVALID_CALL if program is binded.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL DirtyAsync(bool force = false) = 0;
+
+    /** Check whether the program is linked and can be binded. Completes asynchronous linking
+     * if the driver has finished it, never waits for the driver.
+     */
+    virtual bool SGL_DLLCALL IsReady() = 0;
+
+    /** Check whether the program is being linked asynchronously. */
+    virtual bool SGL_DLLCALL IsLinking() const = 0;
+
     /** Get program compilation log */
     virtual const char* SGL_DLLCALL CompilationLog() const = 0;
 
@@ -120,9 +151,87 @@ public:
     /** Get definition of the i'th program attribute. */
     virtual ATTRIBUTE   SGL_DLLCALL Attribute(unsigned index) const = 0;
 
-    /** Get abstract uniform */
+    /** Bind named fragment shader output to the color attachment. Program becames dirty.
+     * @param name - name of the fragment shader output.
+     * @param colorNumber - index of the color attachment of the render target.
+     * @return result of the operation. SGLERR_UNSUPPORTED if the outputs can't be bound, e.g. in GLES.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL BindFragDataLocation(const char* name, unsigned int colorNumber) = 0;
+
+    /** Associate named uniform block with the uniform buffer binding point. Association is kept
+     * when program is relinked, so it can be set up before the program is dirtied.
+     * @param name - name of the uniform block.
+     * @param bindingPoint - uniform buffer binding point.
+     * @return result of the operation. SGLERR_INVALID_CALL if the program doesn't have such block,
+     * SGLERR_UNSUPPORTED if the uniform buffers are not supported.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL SetUniformBlockBinding(const char* name, unsigned bindingPoint) = 0;
+
+    /** Get index of the named uniform block.
+     * @return index of the block or -1 if not found.
+     */
+    virtual int         SGL_DLLCALL UniformBlockIndex(const char* name) const = 0;
+
+    /** Get number of uniform blocks used by the program. */
+    virtual unsigned    SGL_DLLCALL NumUniformBlocks() const = 0;
+
+    /** Get definition of the i'th uniform block. */
+    virtual UNIFORM_BLOCK SGL_DLLCALL UniformBlock(unsigned index) const = 0;
+
+    /** Get offset of the uniform block member in the block data. Useful to validate UniformLayout.
+     * @param name - name of the member, e.g. "viewProjection" or "lights[0].position".
+     * @return offset of the member in bytes or -1 if not found.
+     */
+    virtual int         SGL_DLLCALL UniformBlockMemberOffset(const char* name) const = 0;
+
+    /** Set varyings captured by the stream output when the program is used. Program becames dirty.
+     * @param numVaryings - number of varyings, 0 disables capture.
+     * @param varyings - names of the varyings, e.g. "gl_Position". Names are copied.
+     * @param mode - layout of the varyings in the stream output buffers.
+     * @return result of the operation. SGLERR_UNSUPPORTED if stream output is not supported,
+     * SGLERR_INVALID_CALL if there are more separate varyings than DeviceTraits::NumberOfStreamOutBuffers.
+     * @see StreamOut
+     */
+    virtual SGL_HRESULT SGL_DLLCALL SetTransformFeedbackVaryings( unsigned                 numVaryings,
+                                                                  const char**             varyings,
+                                                                  TRANSFORM_FEEDBACK_MODE  mode = INTERLEAVED_ATTRIBS ) = 0;
+
+    /** Get number of varyings captured by the stream output. */
+    virtual unsigned    SGL_DLLCALL NumTransformFeedbackVaryings() const = 0;
+
+    /** Get name of the i'th varying captured by the stream output. */
+    virtual const char* SGL_DLLCALL TransformFeedbackVarying(unsigned index) const = 0;
+
+    /** Get layout of the varyings captured by the stream output. Default is INTERLEAVED_ATTRIBS. */
+    virtual TRANSFORM_FEEDBACK_MODE SGL_DLLCALL TransformFeedbackMode() const = 0;
+
+    /** Get binary of the linked program. Binary can be loaded back by the same driver using LoadBinary.
+     * @param format [out] - driver specific format of the binary.
+     * @param data [out] - buffer for the binary, can be 0 to get size of the binary.
+     * @param size - size of the buffer.
+     * @return size of the binary. 0 if program is dirty or ARB_get_program_binary is not supported.
+     */
+    virtual unsigned    SGL_DLLCALL GetBinary( unsigned&    format,
+                                               void*        data,
+                                               unsigned     size ) const = 0;
+
+    /** Link program from the binary retrieved by GetBinary. Shaders are not attached, varyings and
+     * geometry settings are taken from the binary, uniform block bindings are restored.
+     * @return result of the operation. SGLERR_INVALID_CALL if the driver rejected the binary,
+     * e.g. after driver update, SGLERR_UNSUPPORTED if ARB_get_program_binary is not supported.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL LoadBinary( unsigned       format,
+                                                const void*    data,
+                                                unsigned       size ) = 0;
+
+    /** Get abstract uniform. Lookup doesn't query OpenGL, arrays can be found with or without [0] suffix.
+     * @return uniform or 0 if program doesn't have active uniform with such name or program is dirty.
+     */
     virtual AbstractUniform*        SGL_DLLCALL GetUniform(const char* name) const = 0;
 
+    /** Get abstract uniform using name with precomputed hash. */
+    virtual AbstractUniform*        SGL_DLLCALL GetUniform(const UniformName& name) const = 0;
+
     /** Create int uniform */
     virtual UniformI*               SGL_DLLCALL GetUniformI(const char* name) const = 0;
 
@@ -183,6 +292,9 @@ public:
     /** Create TextureCube uniform */
     virtual SamplerUniformCube*     SGL_DLLCALL GetSamplerUniformCube(const char* name) const = 0;
 
+    /** Create TextureBuffer uniform */
+    virtual SamplerUniformBuffer*   SGL_DLLCALL GetSamplerUniformBuffer(const char* name) const = 0;
+
     /** Get uniform with specified value type */
     template<typename T>
     static inline Uniform<T>* SGL_DLLCALL GetUniform( Program*      program,
@@ -303,6 +415,13 @@ inline SamplerUniformCube* SGL_DLLCALL Program::GetSamplerUniform<TextureCube>(
     return program->GetSamplerUniformCube(name);
 }
 
+template<>
+inline SamplerUniformBuffer* SGL_DLLCALL Program::GetSamplerUniform<TextureBuffer>( Program*     program,
+                                                                                    const char*  name )
+{
+    return program->GetSamplerUniformBuffer(name);
+}
+
 } // namepace sgl
 
 #endif // SIMPLE_GL_PROGRAM_H
@@ -0,0 +1,75 @@
+#ifndef SIMPLE_GL_QUERY_H
+#define SIMPLE_GL_QUERY_H
+
+#include "Resource.h"
+
+namespace sgl {
+
+/** Asynchronous GPU query. Query keeps ring of the GL query objects, so results
+ * of the previous frames could be polled without stalling the pipeline.
+ * Each Begin/End pair (or End for timestamps) issues query into the next
+ * object of the ring, results are retrieved in the issue order.
+ */
+class Query :
+    public Resource
+{
+public:
+    /// Type of the query
+    enum TYPE
+    {
+        TIME_ELAPSED,                           /// time in nanoseconds between Begin and End
+        TIMESTAMP,                              /// GPU time in nanoseconds when all previous commands are completed
+        SAMPLES_PASSED,                         /// number of samples passed depth and stencil tests
+        ANY_SAMPLES_PASSED,                     /// 1 if any sample passed depth and stencil tests, 0 otherwise
+        PRIMITIVES_GENERATED,                   /// number of primitives emitted by vertex or geometry shader
+        TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN   /// number of primitives written into transform feedback buffers
+    };
+
+    /// Query description
+    struct DESC
+    {
+        TYPE        type;
+        unsigned    numBuffers;     /// number of queries in the ring, results are delayed up to numBuffers - 1 issues
+
+        DESC() :
+            type(TIME_ELAPSED),
+            numBuffers(3)
+        {}
+    };
+
+public:
+    /** Get type of the query. */
+    virtual TYPE SGL_DLLCALL Type() const = 0;
+
+    /** Start query. Query of the same type must not be active.
+     * @return SGLERR_INVALID_CALL for timestamp queries or if query is already active.
+     * SGLERR_UNAVAILABLE if every query in the ring is waiting for the result.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL Begin() = 0;
+
+    /** Finish query, for timestamp query record the timestamp.
+     * @return SGLERR_INVALID_CALL if query is not active.
+     * SGLERR_UNAVAILABLE if every query in the ring is waiting for the result.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL End() = 0;
+
+    /** Check whether result of the oldest pending query is available. Doesn't stall. */
+    virtual bool SGL_DLLCALL ResultAvailable() const = 0;
+
+    /** Retrieve result of the oldest pending query and release it.
+     * @param result [out] - query result.
+     * @param wait - wait for the result if it is not available.
+     * @return SGLERR_UNAVAILABLE if result is not available and wait is false,
+     * SGLERR_INVALID_CALL if there are no pending queries.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL GetResult(unsigned long long& result, bool wait = false) = 0;
+
+    /** Get number of issued queries waiting for the result retrieval. */
+    virtual unsigned SGL_DLLCALL NumPending() const = 0;
+
+    virtual ~Query() {}
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_QUERY_H
@@ -0,0 +1,38 @@
+#ifndef SIMPLE_GL_READBACK_REQUEST_H
+#define SIMPLE_GL_READBACK_REQUEST_H
+
+#include "Resource.h"
+
+namespace sgl {
+
+/** Asynchronous copy of the GPU data into the client memory. Data is copied into
+ * the pixel pack buffer and guarded by the fence, so the request can be polled
+ * and mapped a frame or two later without stalling the pipeline.
+ */
+class ReadbackRequest :
+    public Resource
+{
+public:
+    /** Get size of the requested data in bytes. */
+    virtual unsigned SGL_DLLCALL Size() const = 0;
+
+    /** Check whether the GPU finished the copy. Doesn't stall. */
+    virtual bool SGL_DLLCALL IsReady() const = 0;
+
+    /** Wait until the GPU finishes the copy. */
+    virtual SGL_HRESULT SGL_DLLCALL Wait() = 0;
+
+    /** Map requested data, waits if the copy is not finished.
+     * @param data [out] - pointer to the data, valid until Unmap.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL Map(const void** data) = 0;
+
+    /** Release mapped data. */
+    virtual SGL_HRESULT SGL_DLLCALL Unmap() = 0;
+
+    virtual ~ReadbackRequest() {}
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_READBACK_REQUEST_H
@@ -164,6 +164,14 @@ public:
     /** Create render target view. */
     virtual SGL_HRESULT SGL_DLLCALL Dirty(bool force = false) = 0;
 
+    /** Start asynchronous readback of the read buffer region.
+     * @param rect - region of the read buffer.
+     * @param format - format of the retrieved pixels.
+     * @return readback request or 0 if readback is not supported.
+     */
+    virtual ReadbackRequest* SGL_DLLCALL Readback( const rectangle&   rect,
+                                                   Texture::FORMAT    format = Texture::RGBA8 ) const = 0;
+
     virtual ~RenderTarget() {}
 };
 
@@ -3,76 +3,57 @@
 
 #include "VertexBuffer.h"
 #include "Program.h"
+#include "Query.h"
 
 namespace sgl {
 
 /** Interface for defining stream output stage(TransformFeedback in the OpenGL).
- * It is attached to the shader program.
+ * Varyings to capture and their layout are set up in the program using
+ * Program::SetTransformFeedbackVaryings, stream output captures them into the target buffers
+ * while it is active:
+ * @code
+ * const char* varyings[] = {"position", "velocity"};
+ * program->SetTransformFeedbackVaryings(2, varyings, Program::SEPARATE_ATTRIBS);
+ * program->Dirty();
+ *
+ * VertexBuffer* targets[] = {positions, velocities};
+ * streamOut->SetPrimitiveType(POINTS);
+ * streamOut->SetTargets(2, targets);
+ * streamOut->SetQuery(primitivesWritten);
+ *
+ * program->Bind();
+ * streamOut->Begin();
+ * device->Draw(POINTS, 0, numParticles);
+ * streamOut->End();
+ * @endcode
  */
-class StreamOut : 
-    public Referenced
+class StreamOut :
+    public Resource
 {
 public:
-    enum MODE
-    {
-        SEPARATE, /// Stream out vertices to one or more buffers. Each declaration entry
-                  /// will be stored in the buffer with index corresponding declaration.
-        INTERLEAVED /// Stream out vertices to single buffer one by one.
-    };
-
-    /** Single stream output element declaration */
-    struct DeclarationEntry
-    {
-        const char*     semantic; /// Could be POSITION, NORMAL, TEXCOORDi or name of the
-                                  /// openGL varying. You can't mix varying semantic
-                                  /// with standart API semantic in one declaration.
-        unsigned char   componentCount; /// number of components for streamin out. If the semantic
-                                        /// is name of the varying variable this ignored.
-    };
-
-public:
-    /** Get program to wich stream out is attached */
-    virtual Program* SGL_DLLCALL MasterProgram() const = 0;
-
-    /** Setup stream out mode. Default is INTERLEAVED.
-     * @param streamOutMode - SEPARATE ot INTERLEAVED mode 
-     */
-    virtual void SGL_DLLCALL SetMode(MODE streamOutMode) = 0;
-
-    /** Get stream output mode */
-    virtual MODE SGL_DLLCALL Mode() const = 0;
-
-    /** Setup feedback primitive type. Default is TRIANGLES
+    /** Setup feedback primitive type. Default is TRIANGLES. Primitives of the draw calls
+     * must match it: POINTS for points, LINES for lines, TRIANGLES for triangles of any kind.
      * @param primitiveType - primitive type of the output stream
-     * @return result of the operation. Could be SGLERR_INVALID_CALL id the primitive type
-     * is not the one of the POINTS, LINES, TRIANGLES.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if the primitive type
+     * is not the one of the POINTS, LINES, TRIANGLES or stream output is active.
      */
     virtual SGL_HRESULT SGL_DLLCALL SetPrimitiveType(PRIMITIVE_TYPE primitiveType) = 0;
 
     /** Get feedback primitive type */
     virtual PRIMITIVE_TYPE SGL_DLLCALL PrimitiveType() const = 0;
 
-    /** Set stream output declaration
-     * @param numEntried - number of the entries in the soDecl array
-     * @param soDecl - array of the stream output declaration entries
-     * @return result of the operation. Could be SGLERR_INVALID call if the declaration is invalid,
-     * SGLERR_UNSUPPORTED if device doesn't support such declaration.
-     */
-    virtual SGL_HRESULT SGL_DLLCALL SetStreamOutDecl(unsigned int numEntries, DeclarationEntry* soDecl) = 0;
-
-    /** Get number of the stream output declaration entries */
-    virtual unsigned int SGL_DLLCALL NumDeclEntries() const = 0;
-
-    /** Get i'th stream output declaration entry */
-    virtual DeclarationEntry SGL_DLLCALL DeclEntry(unsigned int index) const = 0;
-
-    /** Set stream output vertex buffer targets 
+    /** Set stream output vertex buffer targets. Single target is used by the INTERLEAVED_ATTRIBS
+     * programs, i'th target receives i'th varying of the SEPARATE_ATTRIBS programs.
      * @param numEntries - number of the buffers in the vbos array
      * @param vbos - array of the vertex buffers
-     * @return result of the operation. Could be SGLERR_INVALID_CALL if one of the vbos is 0, 
-     * SGLERR_UNSUPPORTED if the offset is invalid for current device.
+     * @param offsets - offsets of the captured data in the buffers in bytes, multiple of 4. May be 0.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if one of the vbos is 0,
+     * offset is invalid or stream output is active, SGLERR_UNSUPPORTED if there are more targets
+     * than DeviceTraits::NumberOfStreamOutBuffers.
      */
-    virtual SGL_HRESULT SGL_DLLCALL SetTargets(unsigned int numEntries, VertexBuffer** vbos) = 0;
+    virtual SGL_HRESULT SGL_DLLCALL SetTargets( unsigned int       numEntries,
+                                                VertexBuffer**     vbos,
+                                                const unsigned*    offsets = 0 ) = 0;
 
     /** Get number of the stream output buffer targets */
     virtual unsigned int SGL_DLLCALL NumTargets() const = 0;
@@ -80,12 +61,56 @@ public:
     /** Get i'th stream output buffer target */
     virtual VertexBuffer* SGL_DLLCALL Target(unsigned int index) const = 0;
 
-    /** Try to compile the resource 
-     * @param force - force recreation even if the resource is initialized.
-     * @return result of the operation. Could be SGLERR_INVALID_CALL - if the combination of the parameters is invalid,
-     * SGLERR_UNSUPPORTED - if the device doesn't support such stream output configuration.  
+    /** Get offset of the captured data in the i'th stream output buffer target */
+    virtual unsigned SGL_DLLCALL TargetOffset(unsigned int index) const = 0;
+
+    /** Set query counting primitives while stream output is active, so the number of
+     * captured primitives can be retrieved without stalling.
+     * @param query - query of the TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN or PRIMITIVES_GENERATED type, may be 0.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if query type is wrong or
+     * stream output is active.
      */
-    virtual SGL_HRESULT SGL_DLLCALL Dirty(bool force = false) = 0;
+    virtual SGL_HRESULT SGL_DLLCALL SetQuery(Query* query) = 0;
+
+    /** Get query counting primitives while stream output is active */
+    virtual Query* SGL_DLLCALL CurrentQuery() const = 0;
+
+    /** Discard primitives after stream output, so nothing is rasterized. Default is false.
+     * Useful for simulation passes which don't render anything.
+     */
+    virtual void SGL_DLLCALL SetRasterizerDiscard(bool discard) = 0;
+
+    /** Check whether primitives are discarded after stream output */
+    virtual bool SGL_DLLCALL RasterizerDiscard() const = 0;
+
+    /** Bind targets and start capturing varyings of the bound program.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if stream output is
+     * already active, there are no targets or bound program doesn't capture varyings.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL Begin() = 0;
+
+    /** Stop capturing varyings.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if stream output is not active.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL End() = 0;
+
+    /** Suspend capture, so the program can be switched or draws can be done without capturing
+     * them. Captured data is preserved and appended on Resume.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if stream output is not active
+     * or already paused, SGLERR_UNSUPPORTED if ARB_transform_feedback2 is not supported.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL Pause() = 0;
+
+    /** Resume paused capture.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if stream output is not paused.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL Resume() = 0;
+
+    /** Check whether stream output is begun and not ended */
+    virtual bool SGL_DLLCALL Active() const = 0;
+
+    /** Check whether stream output is paused */
+    virtual bool SGL_DLLCALL Paused() const = 0;
 
     virtual ~StreamOut() {}
 };
@@ -0,0 +1,61 @@
+#ifndef SIMPLE_GL_STREAMING_BUFFER_H
+#define SIMPLE_GL_STREAMING_BUFFER_H
+
+#include "Buffer.h"
+
+namespace sgl {
+
+/** Ring allocator for the per frame dynamic data over the buffer. Buffer is split
+ * into several regions, each region is guarded by the fence once it is filled or
+ * the frame is ended. Region is reused only after the GPU finished reading it, so
+ * writes never stall on the data in flight. Buffer storage is persistently mapped
+ * if ARB_buffer_storage is available, otherwise ranges are mapped unsynchronized
+ * or uploaded through SetSubData.
+ */
+class StreamingBuffer :
+    public Resource
+{
+public:
+    /// Streaming buffer description
+    struct DESC
+    {
+        unsigned    size;           /// size of the whole buffer in bytes
+        unsigned    numRegions;     /// number of regions, usually number of frames in flight
+
+        DESC() :
+            size(1 << 20),
+            numRegions(3)
+        {}
+    };
+
+public:
+    /** Get buffer the data is streamed into. Bind it as vertex, index or uniform source. */
+    virtual Buffer* SGL_DLLCALL TargetBuffer() const = 0;
+
+    /** Check whether buffer storage is persistently mapped. */
+    virtual bool SGL_DLLCALL Persistent() const = 0;
+
+    /** Allocate chunk of the buffer for writing. Switches to the next region if current
+     * one is exhausted, waiting for the GPU if it still uses that region.
+     * @param size - size of the chunk in bytes.
+     * @param alignment - alignment of the chunk offset, e.g. vertex stride.
+     * @param offset [out] - offset of the chunk from the beginning of the buffer.
+     * @return pointer to write the data into, valid until the next Allocate or Commit.
+     * 0 if size exceeds size of the region.
+     */
+    virtual void* SGL_DLLCALL Allocate(unsigned     size,
+                                       unsigned     alignment,
+                                       unsigned&    offset) = 0;
+
+    /** Make the last allocated chunk visible to the GPU. Must be called before drawing. */
+    virtual SGL_HRESULT SGL_DLLCALL Commit() = 0;
+
+    /** Fence current region and switch to the next one. Call once per frame. */
+    virtual SGL_HRESULT SGL_DLLCALL EndFrame() = 0;
+
+    virtual ~StreamingBuffer() {}
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_STREAMING_BUFFER_H
@@ -19,7 +19,8 @@ public:
         TEXTURE_1D,
         TEXTURE_2D,
         TEXTURE_3D,
-        TEXTURE_CUBE_MAP
+        TEXTURE_CUBE_MAP,
+        TEXTURE_BUFFER
     };
 
     /** texture format */
@@ -91,16 +92,6 @@ public:
         {}
     };
 
-    /** Texture buffer description. */
-    struct TEXTURE_BUFFER_DESC
-    {
-        FORMAT format;
-
-        TEXTURE_BUFFER_DESC() :
-            format(UNKNOWN)
-        {}
-    };
-
     /** 3D texture description. */
     struct TEXTURE_3D_DESC
     {
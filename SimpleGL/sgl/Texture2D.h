@@ -1,6 +1,7 @@
 #ifndef SIMPLE_GL_TEXTURE_2D_H
 #define SIMPLE_GL_TEXTURE_2D_H
 
+#include "ReadbackRequest.h"
 #include "Texture.h"
 
 namespace sgl {
@@ -87,6 +88,12 @@ public:
     virtual SGL_HRESULT SGL_DLLCALL GetImage( unsigned int  mipmap,
                                               void*         data ) = 0;
 
+    /** Start asynchronous readback of the image data. Data is tightly packed as in GetImage.
+     * @param mipmap - mipmap index.
+     * @return readback request or 0 if readback is not supported.
+     */
+    virtual ReadbackRequest* SGL_DLLCALL Readback(unsigned int mipmap) = 0;
+
     /** Bind sampler state to the texture. */
     virtual SGL_HRESULT SGL_DLLCALL BindSamplerState(SamplerState* samplerState) = 0;
 
@@ -1,74 +1,83 @@
-#ifndef SIMPLE_GL_TEXTURE_1D_H
-#define SIMPLE_GL_TEXTURE_1D_H
+#ifndef SIMPLE_GL_TEXTURE_BUFFER_H
+#define SIMPLE_GL_TEXTURE_BUFFER_H
 
 #include "Texture.h"
+#include "Buffer.h"
 
 namespace sgl {
 
-// forward
-class TextureBuffer;
-
-/** 1 dimensional texture view interface. */
-class Texture1D :
-	public Texture
+/** Texture view of the buffer. Shaders fetch texels from it using texelFetch
+ * and samplerBuffer uniform, so large tables (bone matrices, instance transforms,
+ * lookup tables) are not limited by the uniform storage and are uploaded at buffer speed.
+ * Buffer contents are updated as usual, through Buffer::SetSubData, Map or StreamingBuffer:
+ * @code
+ * unsigned offset;
+ * void* data = streamingBuffer->Allocate(numBones * sizeof(math::Matrix4f), 16, offset);
+ * std::copy(bones, bones + numBones, static_cast<math::Matrix4f*>(data));
+ * streamingBuffer->Commit();
+ *
+ * boneTable->SetBuffer( streamingBuffer->TargetBuffer(),
+ *                       Texture::RGBA32F,
+ *                       offset,
+ *                       numBones * sizeof(math::Matrix4f) );
+ * program->GetSamplerUniformBuffer("boneTable")->Set(0, boneTable);
+ * @endcode
+ * N/A in GLES.
+ */
+class TextureBuffer :
+    public Texture
 {
 public:
-    /** Get format of the texture */
-    virtual Texture::FORMAT SGL_DLLCALL Format() const = 0;
-
-    /** Get width of the texture */
-    virtual unsigned int SGL_DLLCALL Width() const = 0;
+    /** Texture buffer description. */
+    struct DESC
+    {
+        FORMAT          format;
+        Buffer*         buffer;     /// buffer holding the texels, can be 0 and set later
+        unsigned int    offset;     /// offset of the first texel in bytes
+        unsigned int    size;       /// size of the texel range in bytes, 0 - till the end of the buffer
 
-    /** Get number of mipmap levels in the texture */
-    virtual unsigned int SGL_DLLCALL NumMipmaps() const = 0;
+        DESC() :
+            format(UNKNOWN),
+            buffer(0),
+            offset(0),
+            size(0)
+        {}
+    };
 
-    /** Force mipmap regeneration.
-     * @return result of the operation. Can be SGLERR_INVALID_CALL, SGLERR_UNSUPPORTED
+public:
+    /** Set buffer holding the texels. Buffer is attached to the texture on the next Bind,
+     * so it can be reallocated using SetData between binds.
+     * @param buffer - buffer holding the texels. Can be 0.
+     * @param format - format of the texels. Depth and compressed formats are not allowed.
+     * @param offset - offset of the first texel in bytes. Multiple of the DeviceTraits::TextureBufferOffsetAlignment.
+     * @param size - size of the texel range in bytes, 0 - till the end of the buffer.
+     * @return result of the operation. Could be SGLERR_INVALID_CALL if format is not allowed or
+     * range is out of the buffer, SGLERR_UNSUPPORTED if range is specified and ARB_texture_buffer_range
+     * is not supported or range contains too many texels.
      */
-    virtual SGL_HRESULT SGL_DLLCALL GenerateMipmap() = 0;
+    virtual SGL_HRESULT SGL_DLLCALL SetBuffer( Buffer*         buffer,
+                                               FORMAT          format,
+                                               unsigned int    offset = 0,
+                                               unsigned int    size = 0 ) = 0;
 
-    /** Setup sub image of the texture. Will fail for multisample textures.
-     * @param mipmap - mipmap level of the texture for access.
-     * @param offsetx - x offset of the region.
-     * @param width - width of the region.
-	 * @param data - texture pixels.
-	 * @return status of the operation. Could be SGLERR_INVALID_CALL.
-     */
-    virtual SGL_HRESULT SGL_DLLCALL SetSubImage( unsigned int    mipmap,
-                                                 unsigned int    offsetx,
-                                                 unsigned int    width, 
-                                                 const void*     data ) = 0;
+    /** Get buffer holding the texels */
+    virtual Buffer* SGL_DLLCALL TargetBuffer() const = 0;
 
-    /** Setup mip level of the texture. Mipmap width and height are calculated
-     * using mipmap level. 
-     * @param mipmap - mipmap index.
-	 * @param data - texture pixels. If NULL then create an empty texture.
-	 * @return status of the operation. Could be SGLERR_OUT_OF_MEMORY, SGLERR_INVALID_CALL
-     */
-    virtual SGL_HRESULT SGL_DLLCALL SetImage( unsigned int  mipmap,
-                                              const void*   data ) = 0;
+    /** Get format of the texels */
+    virtual FORMAT SGL_DLLCALL Format() const = 0;
 
-    /** Get image data.
-     * @param mipmap - mipmap index.
-	 * @param data - texture pixels output.
-	 * @return status of the operation. Can be SGLERR_INVALID_CALL if mipmap or data is invalid.
-     */
-    virtual SGL_HRESULT SGL_DLLCALL GetImage( unsigned int  mipmap,
-                                              void*         data ) = 0;
+    /** Get offset of the first texel in bytes */
+    virtual unsigned int SGL_DLLCALL Offset() const = 0;
 
-    /** Setup texture to the device.
-     * @param stage - texture stage.
-     * @return result of the operation. Could return SGLERR_INVALID_CALL if
-     * texture stage is invalid
-     */
-    virtual SGL_HRESULT SGL_DLLCALL Bind(unsigned int stage) const = 0;
+    /** Get size of the texel range in bytes */
+    virtual unsigned int SGL_DLLCALL Size() const = 0;
 
-    /** Unbind texture from the device if it is binded*/
-    virtual void SGL_DLLCALL Unbind() const = 0;
+    /** Get number of the texels accessible by the shader */
+    virtual unsigned int SGL_DLLCALL NumTexels() const = 0;
 
-    virtual ~Texture1D() {}
+    virtual ~TextureBuffer() {}
 };
 
 } // namespace sgl
 
-#endif // SIMPLE_GL_TEXTURE_1D_H
+#endif // SIMPLE_GL_TEXTURE_BUFFER_H
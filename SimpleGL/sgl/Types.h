@@ -39,6 +39,9 @@ enum SCALAR_TYPE
     UINT,
     FLOAT,
     DOUBLE,
+    HALF,                   /// 16 bit floating point. Requires GL 3.0 or ARB_half_float_vertex, OES_vertex_half_float in GLES.
+    INT_2_10_10_10_REV,     /// 4 signed components packed in 32 bits: x in lower 10 bits, w in upper 2. Requires GL 3.3, N/A in GLES.
+    UINT_2_10_10_10_REV,    /// 4 unsigned components packed in 32 bits. Requires GL 3.3, N/A in GLES.
     __NUMBER_OF_SCALAR_TYPES__
 };
 
@@ -53,7 +56,7 @@ struct ScalarTypetTraits
 /** Structure containing information about scalar type */
 struct scalar_type_desc
 {
-    unsigned sizeInBits; /// Size of the type in bits
+    unsigned sizeInBits; /// Size of the type in bits. For packed types - size of the packed value divided by number of components.
 };
 
 /** Traits containing scalar type information for runtime checks. */
@@ -68,7 +71,11 @@ static const scalar_type_desc SCALAR_TYPE_TRAITS[] =
     {16},
     {32},
     {32},
-    {32}
+    {32},
+    {64},
+    {16},
+    {8},
+    {8}
 };
 
 } // namespace sgl
@@ -6,12 +6,50 @@
 #include "Texture2D.h"
 #include "Texture3D.h"
 #include "TextureCube.h"
+#include "TextureBuffer.h"
+#include <string>
 
 namespace sgl {
 
 // forward decl
 class Program;
 
+/** Uniform name with precomputed hash. Construct once and reuse it to find uniforms
+ * of different programs without hashing the string on every lookup:
+ * @code
+ * static const UniformName WORLD_MATRIX("worldMatrix");
+ * AbstractUniform* uniform = program->GetUniform(WORLD_MATRIX);
+ * @endcode
+ */
+class UniformName
+{
+public:
+    explicit UniformName(const char* name_) :
+        name(name_),
+        hash( Hash(name_) )
+    {}
+
+    /** Get name of the uniform */
+    const char* Name() const { return name.c_str(); }
+
+    /** Get hash of the name */
+    unsigned Hash() const { return hash; }
+
+    /** Hash uniform name, FNV-1a */
+    static unsigned Hash(const char* str)
+    {
+        unsigned value = 2166136261u;
+        for (; *str; ++str) {
+            value = (value ^ static_cast<unsigned char>(*str)) * 16777619u;
+        }
+        return value;
+    }
+
+private:
+    std::string name;
+    unsigned    hash;
+};
+
 /** Uniform with the undefined type */
 class AbstractUniform :
     public WeakReferenced
@@ -43,7 +81,8 @@ public:
         SAMPLER_1D,
         SAMPLER_2D,
         SAMPLER_3D,
-        SAMPLER_CUBE
+        SAMPLER_CUBE,
+        SAMPLER_BUFFER
     };
 
 public:
@@ -65,7 +104,9 @@ class Uniform :
 	public AbstractUniform
 {
 public:
-    /** Set value of the uniform. Master program must be binded. */
+    /** Set value of the uniform. Master program must be binded.
+     * Value is uploaded before the next draw and only if it differs from the previous one.
+     */
     virtual void SGL_DLLCALL Set(const T& value) = 0;
 
     /** Set array of the uniforms. Master program must be binded.
@@ -77,14 +118,14 @@ public:
                                   unsigned int   count ) = 0;
 
     /** Get value of the uniform. if there is arrya of the uniforms - retrieve first.
-     * Master program must be binded.
+     * Value set before is returned without querying the driver.
      */
     virtual T SGL_DLLCALL Value() const = 0;
 
     /** Get number of values in the uniform array. */
     virtual unsigned int SGL_DLLCALL Size() const = 0;
 
-    /** Retrieve stored uniforms. Master program must be binded.
+    /** Retrieve stored uniforms. Values which weren't set are queried from the driver.
      * Doesn't perform any checks.
      * @param values [out] - array for the values, array must have enouth size to store values
      */
@@ -140,6 +181,7 @@ typedef SamplerUniform<Texture1D>       SamplerUniform1D;
 typedef SamplerUniform<Texture2D>       SamplerUniform2D;
 typedef SamplerUniform<Texture3D>       SamplerUniform3D;
 typedef SamplerUniform<TextureCube>     SamplerUniformCube;
+typedef SamplerUniform<TextureBuffer>   SamplerUniformBuffer;
 
 } // namespace sgl
 
@@ -1,18 +1,41 @@
-#ifndef SIMPLE_GL_CONSTANT_BUFFER_H
-#define SIMPLE_GL_CONSTANT_BUFFER_H
+#ifndef SIMPLE_GL_UNIFORM_BUFFER_H
+#define SIMPLE_GL_UNIFORM_BUFFER_H
 
 #include "Buffer.h"
 
 namespace sgl {
 
-/** Constant buffer for shader */
-class ConstantBuffer :
+/** Buffer sourcing data of the uniform blocks. Blocks of the programs are associated
+ * with the indexed binding points, so the same buffer may be shared by every program
+ * referencing the binding point. Use UniformLayout to fill the buffer.
+ * @see Program::SetUniformBlockBinding
+ * @see UniformLayout
+ */
+class UniformBuffer :
     public Buffer
 {
 public:
-    virtual SGL_DLLCALL ~ConstantBuffer() {}
+    /** Bind whole buffer to the indexed binding point. Buffers with UPDATE_ROUND_ROBIN
+     * policy must be rebound after update.
+     * @param bindingPoint - index of the uniform buffer binding point.
+     * @return result of the operation. SGLERR_INVALID_CALL if the binding point is out of range.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL Bind(unsigned bindingPoint) const = 0;
+
+    /** Bind range of the buffer to the indexed binding point.
+     * @param bindingPoint - index of the uniform buffer binding point.
+     * @param offset - offset of the range, must be multiple of the DeviceTraits::UniformBufferOffsetAlignment.
+     * @param size - size of the range in bytes.
+     * @return result of the operation. SGLERR_INVALID_CALL if the range is invalid.
+     */
+    virtual SGL_HRESULT SGL_DLLCALL BindRange(unsigned bindingPoint, unsigned offset, unsigned size) const = 0;
+
+    /** Unbind buffer from the binding point if it is bound there. */
+    virtual void SGL_DLLCALL Unbind(unsigned bindingPoint) const = 0;
+
+    virtual ~UniformBuffer() {}
 };
 
 } // namespace sgl
 
-#endif // SIMPLE_GL_CONSTANT_BUFFER_H
+#endif // SIMPLE_GL_UNIFORM_BUFFER_H
@@ -0,0 +1,134 @@
+#ifndef SIMPLE_GL_UTILITY_BUFFER_ARENA_H
+#define SIMPLE_GL_UTILITY_BUFFER_ARENA_H
+
+#include "../Device.h"
+#include <vector>
+
+namespace sgl {
+
+/** Buffer arena sub-allocates ranges for many small meshes out of few large vertex or index
+ * buffers. Free space of every buffer is managed by the two level segregated fit (TLSF)
+ * allocator, so allocation and release take constant time and neighbouring free ranges are merged.
+ * Meshes sharing the buffer are drawn without rebinding it using base vertex draws:
+ * @code
+ * const BufferArena::BufferRange& vertices = vertexArena.Range(mesh.vertices);
+ * const BufferArena::BufferRange& indices  = indexArena.Range(mesh.indices);
+ * vertices.vertexBuffer->Bind(vertexLayout);
+ * indices.indexBuffer->Bind(IndexBuffer::UINT_16);
+ * device->DrawIndexedBaseVertex( TRIANGLES,
+ *                                indices.offset / sizeof(unsigned short),
+ *                                mesh.numIndices,
+ *                                vertices.offset / vertexSize );
+ * @endcode
+ */
+class SGL_DLLEXPORT BufferArena
+{
+public:
+    enum TYPE
+    {
+        VERTEX_ARENA,
+        INDEX_ARENA
+    };
+
+    struct DESC
+    {
+        TYPE            type;
+        unsigned        blockSize;  /// size of the buffers ranges are allocated from
+        unsigned        alignment;  /// range offsets and sizes are multiple of it, e.g. size of the vertex or index
+        Buffer::USAGE   usage;
+
+        DESC() :
+            type(VERTEX_ARENA),
+            blockSize(1 << 22),
+            alignment(4),
+            usage(Buffer::STATIC_DRAW)
+        {}
+    };
+
+    /** Current location of the allocated range. Changes if the range is moved by the Defragment. */
+    struct BufferRange
+    {
+        VertexBuffer*   vertexBuffer;   /// buffer containing range of the vertex arena, 0 otherwise
+        IndexBuffer*    indexBuffer;    /// buffer containing range of the index arena, 0 otherwise
+        unsigned        block;          /// index of the arena buffer
+        unsigned        offset;         /// offset of the range in bytes
+        unsigned        size;           /// size of the range in bytes
+    };
+
+    /// Usage of the arena memory
+    struct STATISTICS
+    {
+        unsigned    numBlocks;
+        unsigned    numRanges;
+        unsigned    capacity;           /// summary size of the arena buffers
+        unsigned    allocatedSize;      /// summary size of the allocated ranges
+        unsigned    largestFreeRange;
+        float       utilisation;        /// allocatedSize / capacity
+        float       fragmentation;      /// 1 - largestFreeRange / free size, 0 if free space is contiguous
+    };
+
+public:
+    BufferArena(Device* device, const DESC& desc);
+    ~BufferArena();
+
+    /** Allocate range, create new buffer if none of the buffers has enough space.
+     * @param size - size of the range in bytes, rounded up to the alignment.
+     * @param data - data to put into the range, may be 0.
+     * @return handle of the range, 0 if allocation failed.
+     */
+    unsigned Allocate(unsigned size, const void* data = 0);
+
+    /** Release range. Buffers are kept for the further allocations until Defragment. */
+    void Free(unsigned handle);
+
+    /** Update data of the range.
+     * @param offset - offset in the range.
+     */
+    SGL_HRESULT SetData( unsigned       handle,
+                         unsigned       offset,
+                         unsigned       size,
+                         const void*    data );
+
+    /** Get current location of the range. */
+    const BufferRange& Range(unsigned handle) const;
+
+    /** Compact fragmented buffers and release empty ones. Moves ranges, so their
+     * locations must be fetched again. Copies are done on GPU, N/A in GLES.
+     */
+    SGL_HRESULT Defragment();
+
+    /** Get usage of the arena memory. */
+    STATISTICS Statistics() const;
+
+private:
+    struct arena_block;
+
+    struct range_entry
+    {
+        BufferRange range;
+        int         segment;    /// index of the segment in the block, -1 if handle is free
+    };
+
+    typedef std::vector<arena_block*>   block_vector;
+    typedef std::vector<range_entry>    range_vector;
+    typedef std::vector<unsigned>       handle_vector;
+
+private:
+    // noncopyable
+    BufferArena(const BufferArena&);
+    BufferArena& operator = (const BufferArena&);
+
+    arena_block* CreateBlock(unsigned size);
+    void         BindRange(unsigned handle, unsigned block, int segment);
+
+private:
+    ref_ptr<Device> device;
+    DESC            desc;
+    block_vector    blocks;
+    range_vector    ranges;
+    handle_vector   freeHandles;
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_UTILITY_BUFFER_ARENA_H
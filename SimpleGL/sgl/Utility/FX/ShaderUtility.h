@@ -47,7 +47,7 @@ inline Shader* CreateShaderFromFile( Device*            device,
             return 0;
         }
 
-        // insert defines
+        // read file as is, use ShaderPreprocessor or ShaderCache to resolve includes and inject defines
         {
             fseek(file, 0, SEEK_END);
             long size = ftell(file);
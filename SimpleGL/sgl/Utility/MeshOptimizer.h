@@ -0,0 +1,105 @@
+#ifndef SIMPLE_GL_UTILITY_MESH_OPTIMIZER_H
+#define SIMPLE_GL_UTILITY_MESH_OPTIMIZER_H
+
+#include "../IndexBuffer.h"
+#include "../VertexLayout.h"
+
+namespace sgl {
+
+/** Statistics of the simulated post-transform vertex cache. */
+struct VERTEX_CACHE_STATISTICS
+{
+    unsigned    numTransformed; /// number of vertices transformed by the vertex shader
+    float       acmr;           /// average cache miss ratio, transformed vertices per triangle. 0.5 is optimal for grids
+    float       atvr;           /// average transformed vertex ratio, transformed vertices per referenced vertex. 1 is optimal
+};
+
+/** Simulate FIFO post-transform vertex cache on the triangle list.
+ * @param indices - indices of the triangle list.
+ * @param numIndices - number of indices, multiple of 3.
+ * @param numVertices - number of vertices referenced by the indices.
+ * @param cacheSize - number of entries of the simulated cache.
+ */
+SGL_DLLEXPORT VERTEX_CACHE_STATISTICS AnalyzeVertexCache( const unsigned*    indices,
+                                                          unsigned           numIndices,
+                                                          unsigned           numVertices,
+                                                          unsigned           cacheSize = 16 );
+
+/** Reorder triangles for the post-transform vertex cache using Forsyth's algorithm.
+ * Doesn't depend on the cache size and gives good results on any hardware.
+ * @param destination [out] - reordered indices, may be the same as indices.
+ * @param indices - indices of the triangle list.
+ * @param numIndices - number of indices, multiple of 3.
+ * @param numVertices - number of vertices referenced by the indices.
+ */
+SGL_DLLEXPORT void OptimizeVertexCache( unsigned*          destination,
+                                        const unsigned*    indices,
+                                        unsigned           numIndices,
+                                        unsigned           numVertices );
+
+/** Reorder triangles for the post-transform vertex cache using Tipsify algorithm.
+ * Works in linear time, so it is preferable for huge meshes.
+ * @param destination [out] - reordered indices, may be the same as indices.
+ * @param indices - indices of the triangle list.
+ * @param numIndices - number of indices, multiple of 3.
+ * @param numVertices - number of vertices referenced by the indices.
+ * @param cacheSize - size of the cache to optimize for.
+ */
+SGL_DLLEXPORT void OptimizeVertexCacheTipsify( unsigned*          destination,
+                                               const unsigned*    indices,
+                                               unsigned           numIndices,
+                                               unsigned           numVertices,
+                                               unsigned           cacheSize = 16 );
+
+/** Reorder clusters of the cache optimized triangles, so the triangles facing outwards of the mesh
+ * are drawn first and occlude the rest. Clusters are split where the cache is flushed and further while
+ * cache efficiency stays within threshold, so the cache efficiency is mostly preserved.
+ * @param destination [out] - reordered indices, may be the same as indices.
+ * @param indices - cache optimized indices of the triangle list.
+ * @param numIndices - number of indices, multiple of 3.
+ * @param positions - vertex positions, 3 floats per vertex.
+ * @param positionStride - distance between positions in bytes.
+ * @param numVertices - number of vertices referenced by the indices.
+ * @param threshold - allowed ACMR degradation, e.g. 1.05 allows clusters 5% worse than the source.
+ */
+SGL_DLLEXPORT void OptimizeOverdraw( unsigned*          destination,
+                                     const unsigned*    indices,
+                                     unsigned           numIndices,
+                                     const float*       positions,
+                                     unsigned           positionStride,
+                                     unsigned           numVertices,
+                                     float              threshold = 1.05f );
+
+/** Reorder vertices in the order of their first reference by the indices, so vertex fetch
+ * becomes sequential. Indices are remapped, unreferenced vertices are moved to the end.
+ * @param vertexData [in, out] - vertices laid out according to the layout.
+ * @param layout - layout of the vertices. Elements may be interleaved or stored in separate arrays.
+ * @param numVertices - number of vertices.
+ * @param indices [in, out] - indices to remap.
+ * @param numIndices - number of indices.
+ * @return number of referenced vertices.
+ */
+SGL_DLLEXPORT unsigned OptimizeVertexFetch( void*                  vertexData,
+                                            const VertexLayout*    layout,
+                                            unsigned               numVertices,
+                                            unsigned*              indices,
+                                            unsigned               numIndices );
+
+/** Upload indices into the buffer using 16 bit indices if vertex count allows.
+ * @param buffer - index buffer to fill.
+ * @param indices - 32 bit indices.
+ * @param numIndices - number of indices.
+ * @param numVertices - number of vertices referenced by the indices.
+ * @param type [out] - type of the uploaded indices to bind buffer with.
+ * @return result of the SetData.
+ */
+SGL_DLLEXPORT SGL_HRESULT SetOptimalIndexData( IndexBuffer*               buffer,
+                                               const unsigned*            indices,
+                                               unsigned                   numIndices,
+                                               unsigned                   numVertices,
+                                               IndexBuffer::INDEX_TYPE&   type,
+                                               Buffer::USAGE              usage = Buffer::STATIC_DRAW );
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_UTILITY_MESH_OPTIMIZER_H
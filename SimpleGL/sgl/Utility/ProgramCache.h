@@ -0,0 +1,122 @@
+#ifndef SIMPLE_GL_UTILITY_PROGRAM_CACHE_H
+#define SIMPLE_GL_UTILITY_PROGRAM_CACHE_H
+
+#include "../Device.h"
+#include <string>
+#include <vector>
+
+namespace sgl {
+
+/** Program cache stores binaries of the linked programs in the directory and restores them
+ * on the next runs, so shaders are compiled and linked only once per driver. Programs are
+ * identified by the hash of the shader sources, bound attribute and fragment data locations,
+ * captured varyings and the DeviceTraits::DriverIdentity. If the driver rejects the binary,
+ * program is compiled from the sources and the binary is replaced:
+ * @code
+ * ProgramCache cache(device, "cache/programs");
+ *
+ * Shader::DESC shaders[2] = { {Shader::VERTEX, vertexSource}, {Shader::FRAGMENT, fragmentSource} };
+ * const char*  attributes[2] = { "position", "normal" };
+ * unsigned     locations[2]  = { 0, 1 };
+ *
+ * ProgramCache::PROGRAM_DESC desc;
+ * desc.numShaders         = 2;
+ * desc.shaders            = shaders;
+ * desc.numAttributes      = 2;
+ * desc.attributes         = attributes;
+ * desc.attributeLocations = locations;
+ * ref_ptr<Program> program = cache.CreateProgram(desc);
+ * @endcode
+ * Programs restored from the binary don't have shaders attached, so they can't be relinked.
+ * Binaries require ARB_get_program_binary, without it cache just compiles the programs.
+ */
+class SGL_DLLEXPORT ProgramCache
+{
+public:
+    /// Sources and link settings of the program
+    struct PROGRAM_DESC
+    {
+        unsigned                            numShaders;
+        const Shader::DESC*                 shaders;
+        unsigned                            numAttributes;
+        const char**                        attributes;         /// names of the attributes bound to the attributeLocations
+        const unsigned*                     attributeLocations;
+        unsigned                            numFragDatas;
+        const char**                        fragDatas;          /// names of the fragment outputs bound to the fragDataLocations
+        const unsigned*                     fragDataLocations;
+        unsigned                            numVaryings;        /// varyings captured by the stream output
+        const char**                        varyings;
+        Program::TRANSFORM_FEEDBACK_MODE    feedbackMode;
+
+        PROGRAM_DESC() :
+            numShaders(0),
+            shaders(0),
+            numAttributes(0),
+            attributes(0),
+            attributeLocations(0),
+            numFragDatas(0),
+            fragDatas(0),
+            fragDataLocations(0),
+            numVaryings(0),
+            varyings(0),
+            feedbackMode(Program::INTERLEAVED_ATTRIBS)
+        {}
+    };
+
+    /// Efficiency of the cache
+    struct STATISTICS
+    {
+        unsigned    numHits;            /// programs restored from the binaries
+        unsigned    numMisses;          /// programs compiled because binary wasn't found
+        unsigned    numRejected;        /// programs compiled because driver rejected the binary
+        double      loadTime;           /// seconds spent restoring programs from the binaries
+        double      compileTime;        /// seconds spent compiling programs and storing their binaries
+        float       hitRate;            /// numHits / number of created programs
+    };
+
+public:
+    /** Create cache.
+     * @param device - device creating the programs.
+     * @param directory - existing directory for the binaries, 0 or empty disables storing binaries.
+     */
+    ProgramCache(Device* device, const char* directory);
+    ~ProgramCache();
+
+    /** Create and link program, restore it from the binary if possible.
+     * @return linked program or 0 if compilation or linking failed. Error is set by the device.
+     */
+    ref_ptr<Program> CreateProgram(const PROGRAM_DESC& desc);
+
+    /** Get efficiency of the cache since creation. */
+    STATISTICS Statistics() const;
+
+private:
+    // noncopyable
+    ProgramCache(const ProgramCache&);
+    ProgramCache& operator = (const ProgramCache&);
+
+    /* Get path to the binary of the program, empty if binaries are not stored */
+    std::string BinaryPath(const PROGRAM_DESC& desc) const;
+
+    /* Restore program from the binary. SGLERR_FILE_NOT_FOUND if there is no binary */
+    SGL_HRESULT LoadBinary(Program* program, const std::string& path);
+
+    /* Store binary of the linked program */
+    void StoreBinary(const Program* program, const std::string& path);
+
+private:
+    ref_ptr<Device>             device;
+    std::string                 directory;
+    std::vector<unsigned char>  binary;
+
+    // statistics
+    unsigned                    numHits;
+    unsigned                    numMisses;
+    unsigned                    numRejected;
+    double                      loadTime;
+    double                      compileTime;
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_UTILITY_PROGRAM_CACHE_H
@@ -0,0 +1,160 @@
+#ifndef SIMPLE_GL_UTILITY_RENDER_QUEUE_H
+#define SIMPLE_GL_UTILITY_RENDER_QUEUE_H
+
+#include "../Device.h"
+#include <map>
+#include <vector>
+
+namespace sgl {
+
+/** Render queue collects draw items, sorts them by the 64 bit key and submits
+ * them to the device. Opaque items are sorted by program, states, texture and vertex buffer
+ * and then front to back, so program and state changes are minimized and early z rejects
+ * most of the fragments. Translucent items are drawn after opaque back to front.
+ */
+class SGL_DLLEXPORT RenderQueue
+{
+public:
+    enum
+    {
+        NUM_TEXTURES = 4    /// number of textures per draw item
+    };
+
+    enum DRAW_TYPE
+    {
+        DRAW,
+        DRAW_INDEXED
+    #ifndef SIMPLE_GL_ES
+        , DRAW_INSTANCED
+        , DRAW_INDEXED_INSTANCED
+    #endif
+    };
+
+    /** Description of the draw call with all objects required to perform it.
+     * Zero objects are not bound and left from the previous item.
+     */
+    struct DRAW_ITEM
+    {
+        const Program*              program;
+        const BlendState*           blendState;
+        const DepthStencilState*    depthStencilState;
+        const RasterizerState*      rasterizerState;
+        const VertexBuffer*         vertexBuffer;
+        const VertexLayout*         vertexLayout;
+        const IndexBuffer*          indexBuffer;
+        IndexBuffer::INDEX_TYPE     indexFormat;
+        const Texture*              textures[NUM_TEXTURES];   /// textures bound to stages [0, NUM_TEXTURES)
+        const CommandList*          uniforms;                 /// per item uniform setup, executed before draw
+        DRAW_TYPE                   drawType;
+        PRIMITIVE_TYPE              primType;
+        unsigned int                first;                    /// first vertex or first index
+        unsigned int                count;                    /// number of vertices or indices
+        unsigned int                numInstances;
+        float                       depth;                    /// view space distance to the camera, nonnegative
+        bool                        translucent;              /// draw back to front after opaque items
+
+        DRAW_ITEM() :
+            program(0),
+            blendState(0),
+            depthStencilState(0),
+            rasterizerState(0),
+            vertexBuffer(0),
+            vertexLayout(0),
+            indexBuffer(0),
+            indexFormat(IndexBuffer::UINT_32),
+            uniforms(0),
+            drawType(DRAW),
+            primType(TRIANGLES),
+            first(0),
+            count(0),
+            numInstances(1),
+            depth(0.0f),
+            translucent(false)
+        {
+            std::fill(textures, textures + NUM_TEXTURES, (const Texture*)0);
+        }
+    };
+
+public:
+    RenderQueue();
+
+    /** Add item into the queue. Objects are not referenced, they must be alive until Submit. */
+    void Push(const DRAW_ITEM& item);
+
+    /** Sort items and draw them using device. Queue is not cleared.
+     * @return result of the operation. Stops on the first failed bind.
+     */
+    SGL_HRESULT Submit(Device* device);
+
+    /** Remove all items from the queue. */
+    void Clear();
+
+    /** Get number of items in the queue. */
+    size_t Size() const { return items.size(); }
+
+    /** Get number of program binds performed during last Submit. */
+    unsigned int NumProgramBinds() const { return numProgramBinds; }
+
+    /** Get number of state binds performed during last Submit. */
+    unsigned int NumStateBinds() const { return numStateBinds; }
+
+    /** Get number of texture binds performed during last Submit. */
+    unsigned int NumTextureBinds() const { return numTextureBinds; }
+
+private:
+    typedef std::map<const void*, unsigned int> id_map;
+
+    struct state_triple
+    {
+        const BlendState*        blendState;
+        const DepthStencilState* depthStencilState;
+        const RasterizerState*   rasterizerState;
+
+        bool operator < (const state_triple& rhs) const
+        {
+            if (blendState != rhs.blendState) {
+                return blendState < rhs.blendState;
+            }
+            if (depthStencilState != rhs.depthStencilState) {
+                return depthStencilState < rhs.depthStencilState;
+            }
+            return rasterizerState < rhs.rasterizerState;
+        }
+    };
+
+    typedef std::map<state_triple, unsigned int> state_id_map;
+
+    /* Sort key with the index of the item */
+    struct sort_entry
+    {
+        unsigned long long  key;
+        unsigned int        index;
+    };
+
+    typedef std::vector<DRAW_ITEM>  item_vector;
+    typedef std::vector<sort_entry> sort_vector;
+
+private:
+    unsigned long long MakeKey(const DRAW_ITEM& item);
+    void               Sort();
+
+private:
+    item_vector     items;
+    sort_vector     entries;
+    sort_vector     swapEntries;
+
+    // dense ids of the objects to pack them into the key
+    id_map          programIds;
+    id_map          textureIds;
+    id_map          vertexBufferIds;
+    state_id_map    stateIds;
+
+    // statistics
+    unsigned int    numProgramBinds;
+    unsigned int    numStateBinds;
+    unsigned int    numTextureBinds;
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_UTILITY_RENDER_QUEUE_H
@@ -0,0 +1,72 @@
+#ifndef SIMPLE_GL_UTILITY_SHADER_CACHE_H
+#define SIMPLE_GL_UTILITY_SHADER_CACHE_H
+
+#include "ShaderPreprocessor.h"
+
+namespace sgl {
+
+/** Shader cache compiles every permutation of the shader file only once. Shaders are keyed
+ * by the type, file name and set of the defines, order of the defines doesn't matter, so
+ * materials sharing the variant share the compiled shader:
+ * @code
+ * ShaderPreprocessor::DEFINE defines[2] = { {"NUM_LIGHTS", "4"}, {"USE_NORMAL_MAP", 0} };
+ * program->AddShader( shaderCache.GetShader(Shader::FRAGMENT, "shaders/lighting.frag", 2, defines) );
+ * @endcode
+ * Files are read through the ShaderPreprocessor of the cache, so includes and defines
+ * are resolved before the compilation.
+ */
+class SGL_DLLEXPORT ShaderCache
+{
+public:
+    /** Create cache.
+     * @param device - device creating the shaders.
+     * @param async - compile shaders using Device::CreateShaderAsync, errors are reported by the program linking.
+     */
+    ShaderCache(Device* device, bool async = false);
+    ~ShaderCache();
+
+    /** Get shader compiled from the file with the defines, compile it if it is requested first time.
+     * Shader is kept by the cache until Clear.
+     * @return shader or 0 if preprocessing or compilation failed.
+     */
+    Shader* GetShader( Shader::TYPE                        type,
+                       const char*                         fileName,
+                       unsigned                            numDefines = 0,
+                       const ShaderPreprocessor::DEFINE*   defines = 0 );
+
+    /** Get preprocessor used to read the files, e.g. to add include directories. */
+    ShaderPreprocessor& Preprocessor() { return preprocessor; }
+
+    /** Get number of the shaders compiled by the cache. */
+    unsigned NumShaders() const { return shaders.size(); }
+
+    /** Get number of the GetShader calls. */
+    unsigned NumRequests() const { return numRequests; }
+
+    /** Release shaders and forget cached files. */
+    void Clear();
+
+private:
+    typedef std::map< std::string, ref_ptr<Shader> >                shader_map;
+    typedef std::vector< std::pair<std::string, std::string> >      define_vector;
+
+private:
+    // noncopyable
+    ShaderCache(const ShaderCache&);
+    ShaderCache& operator = (const ShaderCache&);
+
+private:
+    ref_ptr<Device>     device;
+    ShaderPreprocessor  preprocessor;
+    shader_map          shaders;
+    bool                async;
+    unsigned            numRequests;
+
+    // scratch memory
+    define_vector       sortedDefines;
+    std::string         source;
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_UTILITY_SHADER_CACHE_H
@@ -0,0 +1,88 @@
+#ifndef SIMPLE_GL_UTILITY_SHADER_PREPROCESSOR_H
+#define SIMPLE_GL_UTILITY_SHADER_PREPROCESSOR_H
+
+#include "../Device.h"
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace sgl {
+
+/** Shader preprocessor prepares GLSL sources for the compilation: resolves #include "file"
+ * directives, injects #define set after the #version directive and normalises whitespace,
+ * so sources differing only in formatting are equal. #pragma once is supported. Included
+ * files get their own source string numbers in the #line directives (GLSL 3.30 semantics),
+ * so compilation errors can be mapped back to the Files. Files are read once and cached.
+ */
+class SGL_DLLEXPORT ShaderPreprocessor
+{
+public:
+    /// Macro injected into the source
+    struct DEFINE
+    {
+        const char* name;
+        const char* value;  /// can be 0
+    };
+
+public:
+    ShaderPreprocessor();
+    ~ShaderPreprocessor();
+
+    /** Add directory searched for the included files after the directory of the including file. */
+    void AddIncludeDirectory(const char* directory);
+
+    /** Preprocess shader file.
+     * @param fileName - name of the shader file.
+     * @param numDefines - number of the injected macros.
+     * @param defines - injected macros.
+     * @param source [out] - preprocessed source.
+     * @return result of the operation. SGLERR_FILE_NOT_FOUND if the file or included file can't
+     * be opened, SGLERR_INVALID_CALL if the include is malformed or recursive.
+     */
+    SGL_HRESULT Preprocess( const char*     fileName,
+                            unsigned        numDefines,
+                            const DEFINE*   defines,
+                            std::string&    source );
+
+    /** Get files read by the last Preprocess, index of the file is its source string number. */
+    const std::vector<std::string>& Files() const { return files; }
+
+    /** Forget cached files, e.g. when they are changed on disk. */
+    void ClearFileCache() { fileCache.clear(); }
+
+private:
+    typedef std::map<std::string, std::string>  file_map;
+    typedef std::vector<std::string>            string_vector;
+    typedef std::set<std::string>               string_set;
+
+private:
+    // noncopyable
+    ShaderPreprocessor(const ShaderPreprocessor&);
+    ShaderPreprocessor& operator = (const ShaderPreprocessor&);
+
+    /* Get contents of the file, 0 if file can't be read */
+    const std::string* ReadFile(const std::string& path);
+
+    /* Find included file, empty if not found */
+    std::string ResolveInclude(const std::string& includingPath, const std::string& name);
+
+    /* Append preprocessed file to the source */
+    SGL_HRESULT ProcessFile( const std::string&   path,
+                             unsigned             numDefines,
+                             const DEFINE*        defines,
+                             std::string&         source );
+
+private:
+    string_vector   includeDirectories;
+    file_map        fileCache;
+
+    // state of the Preprocess
+    string_vector   files;
+    string_vector   includeStack;
+    string_set      onceFiles;
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_UTILITY_SHADER_PREPROCESSOR_H
@@ -0,0 +1,238 @@
+#ifndef SIMPLE_GL_UTILITY_UNIFORM_LAYOUT_H
+#define SIMPLE_GL_UTILITY_UNIFORM_LAYOUT_H
+
+#include "../Math/Matrix.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace sgl {
+
+/** Describes how uniform block member of the type T is composed from the scalars.
+ * Matrices are stored by rows, GLSL expects columns, so the value is accessed by element.
+ */
+template<typename T>
+struct uniform_layout_traits;
+
+template<>
+struct uniform_layout_traits<float>
+{
+    typedef float value_type;
+
+    static const unsigned num_rows    = 1;
+    static const unsigned num_columns = 1;
+
+    static float element(const float& value, unsigned /*row*/, unsigned /*column*/) { return value; }
+};
+
+template<>
+struct uniform_layout_traits<int>
+{
+    typedef int value_type;
+
+    static const unsigned num_rows    = 1;
+    static const unsigned num_columns = 1;
+
+    static int element(const int& value, unsigned /*row*/, unsigned /*column*/) { return value; }
+};
+
+template<>
+struct uniform_layout_traits<unsigned>
+{
+    typedef unsigned value_type;
+
+    static const unsigned num_rows    = 1;
+    static const unsigned num_columns = 1;
+
+    static unsigned element(const unsigned& value, unsigned /*row*/, unsigned /*column*/) { return value; }
+};
+
+template<typename T, int n>
+struct uniform_layout_traits< math::Matrix<T, n, 1> >
+{
+    typedef T value_type;
+
+    static const unsigned num_rows    = n;
+    static const unsigned num_columns = 1;
+
+    static T element(const math::Matrix<T, n, 1>& value, unsigned row, unsigned /*column*/) { return value[row]; }
+};
+
+template<typename T, int n, int m>
+struct uniform_layout_traits< math::Matrix<T, n, m> >
+{
+    typedef T value_type;
+
+    static const unsigned num_rows    = n;
+    static const unsigned num_columns = m;
+
+    static T element(const math::Matrix<T, n, m>& value, unsigned row, unsigned column) { return value[row][column]; }
+};
+
+/** Computes offsets of the uniform block members according to the std140 or std430
+ * packing rules and writes members into the block data. Members must be appended in
+ * the order they are declared in the block. Matrices are written column major,
+ * which is the default layout of the GLSL blocks.
+ * @code
+ * // layout(std140) uniform Camera { mat4 viewProjection; vec4 position; };
+ * UniformLayout layout;
+ * unsigned viewProjectionOffset = layout.Append<math::Matrix4f>();
+ * unsigned positionOffset       = layout.Append<math::Vector4f>();
+ *
+ * std::vector<char> data( layout.Size() );
+ * layout.Write(&data[0], viewProjectionOffset, viewProjection);
+ * layout.Write(&data[0], positionOffset, position);
+ * uniformBuffer->SetData(data.size(), &data[0]);
+ * @endcode
+ */
+class UniformLayout
+{
+public:
+    /// Packing rules of the block
+    enum RULES
+    {
+        STD140,     /// uniform blocks, arrays and matrix columns are aligned to vec4
+        STD430      /// shader storage blocks, arrays and columns are aligned as their elements
+    };
+
+    /** Placement of the member inside the block */
+    struct MEMBER
+    {
+        unsigned    offset;         /// offset of the member in bytes
+        unsigned    arrayStride;    /// distance between array elements, 0 for non-array members
+        unsigned    matrixStride;   /// distance between matrix columns, 0 for non-matrix members
+    };
+
+public:
+    explicit UniformLayout(RULES rules_ = STD140) :
+        rules(rules_),
+        size(0),
+        alignment(rules_ == STD140 ? 16 : 4)
+    {}
+
+    /** Append member to the block.
+     * @param arraySize - number of elements of the array member, 0 for non-array members.
+     * @return offset of the member in bytes.
+     */
+    template<typename T>
+    unsigned Append(unsigned arraySize = 0)
+    {
+        return AppendMember<T>(arraySize).offset;
+    }
+
+    /** Append member to the block.
+     * @param arraySize - number of elements of the array member, 0 for non-array members.
+     * @return placement of the member.
+     */
+    template<typename T>
+    MEMBER AppendMember(unsigned arraySize = 0)
+    {
+        typedef uniform_layout_traits<T> traits;
+
+        // matrix is laid out as array of column vectors
+        unsigned columnAlignment = VectorAlignment(traits::num_rows);
+        unsigned columnSize      = traits::num_rows * 4;
+        if (traits::num_columns > 1 && rules == STD140) {
+            columnAlignment = 16;
+        }
+
+        unsigned elementAlignment = columnAlignment;
+        unsigned elementSize      = columnSize;
+        if (traits::num_columns > 1) {
+            elementSize = traits::num_columns * columnAlignment;
+        }
+
+        unsigned elementStride = elementSize;
+        if (arraySize > 0)
+        {
+            if (rules == STD140) {
+                elementAlignment = Align(elementAlignment, 16);
+            }
+            elementStride = Align(elementSize, elementAlignment);
+        }
+
+        MEMBER member;
+        member.offset       = Align(size, elementAlignment);
+        member.arrayStride  = (arraySize > 0) ? elementStride : 0;
+        member.matrixStride = (traits::num_columns > 1) ? columnAlignment : 0;
+
+        size      = member.offset + ( (arraySize > 0) ? arraySize * elementStride : elementSize );
+        alignment = std::max(alignment, elementAlignment);
+        return member;
+    }
+
+    /** Get size of the block data, padded to the alignment of the block. */
+    unsigned Size() const { return Align(size, alignment); }
+
+    /** Get packing rules of the layout. */
+    RULES Rules() const { return rules; }
+
+    /** Write member value into the block data.
+     * @param block - data of the block.
+     * @param offset - offset of the member returned by Append.
+     * @param value - value of the member.
+     */
+    template<typename T>
+    void Write(void* block, unsigned offset, const T& value) const
+    {
+        typedef uniform_layout_traits<T> traits;
+
+        const unsigned matrixStride = MatrixStride<T>();
+        char*          data         = static_cast<char*>(block) + offset;
+        for (unsigned column = 0; column < traits::num_columns; ++column)
+        {
+            for (unsigned row = 0; row < traits::num_rows; ++row)
+            {
+                typename traits::value_type element = traits::element(value, row, column);
+                std::memcpy(data + column * matrixStride + row * 4, &element, 4);
+            }
+        }
+    }
+
+    /** Write elements of the array member into the block data.
+     * @param block - data of the block.
+     * @param member - placement of the member returned by AppendMember.
+     * @param values - values of the array elements.
+     * @param count - number of elements to write.
+     */
+    template<typename T>
+    void Write(void* block, const MEMBER& member, const T* values, unsigned count) const
+    {
+        assert(member.arrayStride > 0 || count <= 1);
+        for (unsigned i = 0; i < count; ++i) {
+            Write(block, member.offset + i * member.arrayStride, values[i]);
+        }
+    }
+
+private:
+    static unsigned Align(unsigned offset, unsigned alignment)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    static unsigned VectorAlignment(unsigned numComponents)
+    {
+        // vec3 is aligned as vec4
+        return (numComponents == 1) ? 4 : (numComponents == 2) ? 8 : 16;
+    }
+
+    template<typename T>
+    unsigned MatrixStride() const
+    {
+        typedef uniform_layout_traits<T> traits;
+        if (traits::num_columns == 1) {
+            return 0;
+        }
+
+        return (rules == STD140) ? 16 : VectorAlignment(traits::num_rows);
+    }
+
+private:
+    RULES       rules;
+    unsigned    size;
+    unsigned    alignment;
+};
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_UTILITY_UNIFORM_LAYOUT_H
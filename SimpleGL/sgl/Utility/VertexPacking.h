@@ -0,0 +1,64 @@
+#ifndef SIMPLE_GL_UTILITY_VERTEX_PACKING_H
+#define SIMPLE_GL_UTILITY_VERTEX_PACKING_H
+
+#include "../Config.h"
+
+namespace sgl {
+
+/* Packers converting float streams into compact vertex formats. Use SSE2 if SIMPLE_GL_USE_SSE is defined.
+ * Packed elements are described using normalized flag of the VertexLayout::ELEMENT:
+ * @code
+ * VertexLayout::ELEMENT elements[] =
+ * {
+ *     {0, 3, 0,  0, sgl::FLOAT,              VertexLayout::ATTRIBUTE, false, false},
+ *     {1, 4, 0,  0, sgl::INT_2_10_10_10_REV, VertexLayout::ATTRIBUTE, true,  false},
+ *     {2, 2, 0,  0, sgl::HALF,               VertexLayout::ATTRIBUTE, false, false}
+ * };
+ * @endcode
+ * Signed normalized values are converted using GL 4.2 rule: -1, 0 and 1 are represented exactly.
+ */
+
+/** Convert floats into 16 bit floats. Values out of range are converted to infinity.
+ * @param destination [out] - converted values.
+ * @param source - values to convert.
+ * @param count - number of values.
+ */
+SGL_DLLEXPORT void PackHalf( unsigned short*  destination,
+                             const float*     source,
+                             unsigned         count );
+
+/** Convert floats from [-1, 1] range into signed normalized 8 bit values. Values are clamped. */
+SGL_DLLEXPORT void PackSnorm8( signed char*   destination,
+                               const float*   source,
+                               unsigned       count );
+
+/** Convert floats from [0, 1] range into unsigned normalized 8 bit values. Values are clamped. */
+SGL_DLLEXPORT void PackUnorm8( unsigned char*  destination,
+                               const float*    source,
+                               unsigned        count );
+
+/** Convert floats from [-1, 1] range into signed normalized 16 bit values. Values are clamped. */
+SGL_DLLEXPORT void PackSnorm16( short*         destination,
+                                const float*   source,
+                                unsigned       count );
+
+/** Convert floats from [0, 1] range into unsigned normalized 16 bit values. Values are clamped. */
+SGL_DLLEXPORT void PackUnorm16( unsigned short*  destination,
+                                const float*     source,
+                                unsigned         count );
+
+/** Pack vectors from [-1, 1] range into INT_2_10_10_10_REV values, e.g. normals or tangents
+ * with handedness in w. Values are clamped.
+ * @param destination [out] - packed vectors.
+ * @param source - vectors to pack.
+ * @param numComponents - number of components of the source vectors, 3 or 4. Missing w is packed as 0.
+ * @param count - number of vectors.
+ */
+SGL_DLLEXPORT void PackSnorm2_10_10_10( unsigned*      destination,
+                                        const float*   source,
+                                        unsigned       numComponents,
+                                        unsigned       count );
+
+} // namespace sgl
+
+#endif // SIMPLE_GL_UTILITY_VERTEX_PACKING_H
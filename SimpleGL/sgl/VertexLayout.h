@@ -29,6 +29,8 @@ public:
         unsigned int    stride;     /// Stride between elements.
         SCALAR_TYPE		type;       /// Type of the each component in the vertex.
 		SEMANTIC		semantic;   /// Optional value - semantic of the attribute.
+        bool            normalized; /// Map integer values to [0, 1] for unsigned and [-1, 1] for signed types. Ignored by fixed function semantics.
+        bool            integer;    /// Pass integer values to the shader as is. Ignored by fixed function semantics. Requires GL 3.0, N/A in GLES.
 	};
 
 public:
@@ -4,6 +4,8 @@
 
 namespace {
 
+    using namespace sgl;
+
     GLenum BIND_BLEND_OPERATION[] =
     {
         GL_FUNC_ADD,
@@ -34,6 +36,63 @@ namespace {
         GL_SRC_ALPHA_SATURATE
     };
 
+    typedef GLDevice::STATE_CACHE state_cache;
+
+    void set_blend_enable(state_cache& cache, GLint enable)
+    {
+        if (cache.blendEnable != enable)
+        {
+            if (enable) {
+                glEnable(GL_BLEND);
+            }
+            else {
+                glDisable(GL_BLEND);
+            }
+            cache.blendEnable = enable;
+        }
+    }
+
+    void set_blend_func( state_cache& cache,
+                         GLint        src,
+                         GLint        dest,
+                         GLint        srcAlpha,
+                         GLint        destAlpha )
+    {
+        if ( cache.blendSrc      != src
+             || cache.blendDest      != dest
+             || cache.blendSrcAlpha  != srcAlpha
+             || cache.blendDestAlpha != destAlpha )
+        {
+            if (src != srcAlpha || dest != destAlpha) {
+                glBlendFuncSeparate(src, dest, srcAlpha, destAlpha);
+            }
+            else {
+                glBlendFunc(src, dest);
+            }
+
+            cache.blendSrc       = src;
+            cache.blendDest      = dest;
+            cache.blendSrcAlpha  = srcAlpha;
+            cache.blendDestAlpha = destAlpha;
+        }
+    }
+
+    void set_blend_equation(state_cache& cache, GLint op, GLint opAlpha)
+    {
+        if (cache.blendOp != op || cache.blendOpAlpha != opAlpha)
+        {
+            if (op != opAlpha) {
+                glBlendEquationSeparate(op, opAlpha);
+            }
+            else {
+                glBlendEquation(op);
+            }
+
+            cache.blendOp      = op;
+            cache.blendOpAlpha = opAlpha;
+        }
+    }
+
 } // anonymous namespace
 
 namespace sgl {
@@ -68,6 +127,9 @@ GLBlendStateDisplayLists::GLBlendStateDisplayLists(GLDevice*               devic
             if (desc.blendOp != desc.blendOpAlpha) {
                 glBlendEquationSeparate(BIND_BLEND_OPERATION[desc.blendOp], BIND_BLEND_OPERATION[desc.blendOpAlpha]);
             }
+            else {
+                glBlendEquation(BIND_BLEND_OPERATION[desc.blendOp]);
+            }
         }
         else {
             glDisable(GL_BLEND);
@@ -84,7 +146,37 @@ GLBlendStateDisplayLists::~GLBlendStateDisplayLists()
 
 void GLBlendStateDisplayLists::Bind() const
 {
-    glCallList(bindDisplayList);
+    GLDevice::STATE_CACHE& cache = device->StateCache();
+
+    // replay list only if some of the values differ from the current ones
+    bool equal = (cache.blendEnable == GLint(desc.blendEnable));
+    if (equal && desc.blendEnable)
+    {
+        equal = cache.blendSrc       == GLint(BIND_BLEND_FUNCTION[desc.srcBlend])
+             && cache.blendDest      == GLint(BIND_BLEND_FUNCTION[desc.destBlend])
+             && cache.blendSrcAlpha  == GLint(BIND_BLEND_FUNCTION[desc.srcBlendAlpha])
+             && cache.blendDestAlpha == GLint(BIND_BLEND_FUNCTION[desc.destBlendAlpha])
+             && cache.blendOp        == GLint(BIND_BLEND_OPERATION[desc.blendOp])
+             && cache.blendOpAlpha   == GLint(BIND_BLEND_OPERATION[desc.blendOpAlpha]);
+    }
+
+    if (!equal)
+    {
+        glCallList(bindDisplayList);
+
+        cache.blendEnable = desc.blendEnable;
+        if (desc.blendEnable)
+        {
+            cache.blendSrc       = BIND_BLEND_FUNCTION[desc.srcBlend];
+            cache.blendDest      = BIND_BLEND_FUNCTION[desc.destBlend];
+            cache.blendSrcAlpha  = BIND_BLEND_FUNCTION[desc.srcBlendAlpha];
+            cache.blendDestAlpha = BIND_BLEND_FUNCTION[desc.destBlendAlpha];
+            cache.blendOp        = BIND_BLEND_OPERATION[desc.blendOp];
+            cache.blendOpAlpha   = BIND_BLEND_OPERATION[desc.blendOpAlpha];
+        }
+    }
+
+    SGL_FRAME_STATISTICS(device, numStateBinds, 1);
     device->SetBlendState(this);
 }
 
@@ -104,20 +196,22 @@ GLBlendStateSeparate::~GLBlendStateSeparate()
 
 void GLBlendStateSeparate::Bind() const
 {
+    GLDevice::STATE_CACHE& cache = device->StateCache();
+
+    set_blend_enable(cache, desc.blendEnable);
     if (desc.blendEnable)
     {
-        glEnable(GL_BLEND);
-        glBlendFuncSeparate( BIND_BLEND_FUNCTION[desc.srcBlend],
-                             BIND_BLEND_FUNCTION[desc.destBlend],
-                             BIND_BLEND_FUNCTION[desc.srcBlendAlpha],
-                             BIND_BLEND_FUNCTION[desc.destBlendAlpha] );
-        glBlendEquationSeparate( BIND_BLEND_OPERATION[desc.blendOp],
-                                 BIND_BLEND_OPERATION[desc.blendOpAlpha] );
-    }
-    else {
-        glDisable(GL_BLEND);
+        set_blend_func( cache,
+                        BIND_BLEND_FUNCTION[desc.srcBlend],
+                        BIND_BLEND_FUNCTION[desc.destBlend],
+                        BIND_BLEND_FUNCTION[desc.srcBlendAlpha],
+                        BIND_BLEND_FUNCTION[desc.destBlendAlpha] );
+        set_blend_equation( cache,
+                            BIND_BLEND_OPERATION[desc.blendOp],
+                            BIND_BLEND_OPERATION[desc.blendOpAlpha] );
     }
 
+    SGL_FRAME_STATISTICS(device, numStateBinds, 1);
     device->SetBlendState(this);
 }
 
@@ -138,16 +232,16 @@ GLBlendStateDefault::~GLBlendStateDefault()
 
 void GLBlendStateDefault::Bind() const
 {
+    GLDevice::STATE_CACHE& cache = device->StateCache();
+
+    set_blend_enable(cache, desc.blendEnable);
     if (desc.blendEnable)
     {
-        glEnable(GL_BLEND);
-        glBlendFunc(glSrcBlend, glDestBlend);
-        glBlendEquation(glBlendOp);
-    }
-    else {
-        glDisable(GL_BLEND);
+        set_blend_func(cache, glSrcBlend, glDestBlend, glSrcBlend, glDestBlend);
+        set_blend_equation(cache, glBlendOp, glBlendOp);
     }
 
+    SGL_FRAME_STATISTICS(device, numStateBinds, 1);
     device->SetBlendState(this);
 }
 
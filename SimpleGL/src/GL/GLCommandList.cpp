@@ -0,0 +1,561 @@
+#include "GL/GLCommandList.h"
+#include "GL/GLDevice.h"
+#include <cstring>
+
+namespace {
+
+    using namespace sgl;
+    using namespace math;
+
+    enum COMMAND_TYPE
+    {
+        BIND_BLEND_STATE,
+        BIND_DEPTH_STENCIL_STATE,
+        BIND_RASTERIZER_STATE,
+        BIND_PROGRAM,
+        BIND_TEXTURE,
+        BIND_VERTEX_BUFFER,
+        BIND_INDEX_BUFFER,
+        BIND_RENDER_TARGET,
+        SET_VIEWPORT,
+        SET_UNIFORM,
+        SET_SAMPLER_UNIFORM,
+        SET_BUFFER_SUB_DATA,
+        DRAW,
+        DRAW_INDEXED,
+        DRAW_INSTANCED,
+        DRAW_INDEXED_INSTANCED,
+        CLEAR
+    };
+
+    struct command_header
+    {
+        unsigned int type;
+        unsigned int numBlocks;     // size of the command including header and data
+    };
+
+    struct command_bind_state
+    {
+        command_header  header;
+        const State*    state;
+    };
+
+    struct command_bind_program
+    {
+        command_header  header;
+        const Program*  program;
+    };
+
+    struct command_bind_texture
+    {
+        command_header  header;
+        unsigned int    stage;
+        const Texture*  texture;
+    };
+
+    struct command_bind_vertex_buffer
+    {
+        command_header      header;
+        const VertexBuffer* vertexBuffer;
+        const VertexLayout* vertexLayout;
+    };
+
+    struct command_bind_index_buffer
+    {
+        command_header              header;
+        const IndexBuffer*          indexBuffer;
+        IndexBuffer::INDEX_TYPE     format;
+    };
+
+    struct command_bind_render_target
+    {
+        command_header      header;
+        const RenderTarget* renderTarget;
+    };
+
+    struct command_set_viewport
+    {
+        command_header  header;
+        rectangle       viewport;
+    };
+
+    struct command_set_uniform
+    {
+        command_header      header;
+        AbstractUniform*    uniform;
+        unsigned int        count;
+    };
+
+    struct command_set_sampler_uniform
+    {
+        command_header      header;
+        AbstractUniform*    uniform;
+        unsigned int        stage;
+        const Texture*      texture;
+    };
+
+    struct command_set_buffer_sub_data
+    {
+        command_header  header;
+        Buffer*         buffer;
+        unsigned int    offset;
+        unsigned int    dataSize;
+    };
+
+    struct command_draw
+    {
+        command_header  header;
+        PRIMITIVE_TYPE  primType;
+        unsigned int    first;
+        unsigned int    count;
+        unsigned int    numInstances;
+    };
+
+    struct command_clear
+    {
+        command_header  header;
+        bool            colorBuffer;
+        bool            depthBuffer;
+        bool            stencilBuffer;
+    };
+
+    inline unsigned int num_blocks(size_t size)
+    {
+        return (size + sizeof(GLCommandList::block) - 1) / sizeof(GLCommandList::block);
+    }
+
+    // Get data attached to the command
+    template<typename Command>
+    inline const void* command_data(const Command* command)
+    {
+        return reinterpret_cast<const GLCommandList::block*>(command) + num_blocks( sizeof(Command) );
+    }
+
+    // Get size of the uniform value
+    size_t uniform_size(AbstractUniform::TYPE type)
+    {
+        switch (type)
+        {
+            case AbstractUniform::INT:      return sizeof(int);
+            case AbstractUniform::VEC2I:    return sizeof(Vector2i);
+            case AbstractUniform::VEC3I:    return sizeof(Vector3i);
+            case AbstractUniform::VEC4I:    return sizeof(Vector4i);
+            case AbstractUniform::FLOAT:    return sizeof(float);
+            case AbstractUniform::VEC2F:    return sizeof(Vector2f);
+            case AbstractUniform::VEC3F:    return sizeof(Vector3f);
+            case AbstractUniform::VEC4F:    return sizeof(Vector4f);
+            case AbstractUniform::MAT2x2F:  return sizeof(Matrix2x2f);
+            case AbstractUniform::MAT3x3F:  return sizeof(Matrix3x3f);
+            case AbstractUniform::MAT4x4F:  return sizeof(Matrix4x4f);
+        #ifndef SIMPLE_GL_ES
+            case AbstractUniform::MAT2x3F:  return sizeof(Matrix2x3f);
+            case AbstractUniform::MAT2x4F:  return sizeof(Matrix2x4f);
+            case AbstractUniform::MAT3x2F:  return sizeof(Matrix3x2f);
+            case AbstractUniform::MAT3x4F:  return sizeof(Matrix3x4f);
+            case AbstractUniform::MAT4x2F:  return sizeof(Matrix4x2f);
+            case AbstractUniform::MAT4x3F:  return sizeof(Matrix4x3f);
+        #endif
+            default:
+                return 0;
+        }
+    }
+
+    template<typename T>
+    inline void set_uniform(AbstractUniform* uniform, const void* values, unsigned int count)
+    {
+        static_cast< Uniform<T>* >(uniform)->Set(static_cast<const T*>(values), count);
+    }
+
+    void set_uniform(const command_set_uniform* command)
+    {
+        const void* values = command_data(command);
+        switch ( command->uniform->Type() )
+        {
+            case AbstractUniform::INT:      set_uniform<int>(command->uniform, values, command->count);        break;
+            case AbstractUniform::VEC2I:    set_uniform<Vector2i>(command->uniform, values, command->count);   break;
+            case AbstractUniform::VEC3I:    set_uniform<Vector3i>(command->uniform, values, command->count);   break;
+            case AbstractUniform::VEC4I:    set_uniform<Vector4i>(command->uniform, values, command->count);   break;
+            case AbstractUniform::FLOAT:    set_uniform<float>(command->uniform, values, command->count);      break;
+            case AbstractUniform::VEC2F:    set_uniform<Vector2f>(command->uniform, values, command->count);   break;
+            case AbstractUniform::VEC3F:    set_uniform<Vector3f>(command->uniform, values, command->count);   break;
+            case AbstractUniform::VEC4F:    set_uniform<Vector4f>(command->uniform, values, command->count);   break;
+            case AbstractUniform::MAT2x2F:  set_uniform<Matrix2x2f>(command->uniform, values, command->count); break;
+            case AbstractUniform::MAT3x3F:  set_uniform<Matrix3x3f>(command->uniform, values, command->count); break;
+            case AbstractUniform::MAT4x4F:  set_uniform<Matrix4x4f>(command->uniform, values, command->count); break;
+        #ifndef SIMPLE_GL_ES
+            case AbstractUniform::MAT2x3F:  set_uniform<Matrix2x3f>(command->uniform, values, command->count); break;
+            case AbstractUniform::MAT2x4F:  set_uniform<Matrix2x4f>(command->uniform, values, command->count); break;
+            case AbstractUniform::MAT3x2F:  set_uniform<Matrix3x2f>(command->uniform, values, command->count); break;
+            case AbstractUniform::MAT3x4F:  set_uniform<Matrix3x4f>(command->uniform, values, command->count); break;
+            case AbstractUniform::MAT4x2F:  set_uniform<Matrix4x2f>(command->uniform, values, command->count); break;
+            case AbstractUniform::MAT4x3F:  set_uniform<Matrix4x3f>(command->uniform, values, command->count); break;
+        #endif
+            default:
+                assert(!"Can't happen");
+        }
+    }
+
+    void set_sampler_uniform(const command_set_sampler_uniform* command)
+    {
+        switch ( command->uniform->Type() )
+        {
+            case AbstractUniform::SAMPLER_1D:
+                static_cast<SamplerUniform1D*>(command->uniform)->Set( command->stage, static_cast<const Texture1D*>(command->texture) );
+                break;
+
+            case AbstractUniform::SAMPLER_2D:
+                static_cast<SamplerUniform2D*>(command->uniform)->Set( command->stage, static_cast<const Texture2D*>(command->texture) );
+                break;
+
+            case AbstractUniform::SAMPLER_3D:
+                static_cast<SamplerUniform3D*>(command->uniform)->Set( command->stage, static_cast<const Texture3D*>(command->texture) );
+                break;
+
+            case AbstractUniform::SAMPLER_CUBE:
+                static_cast<SamplerUniformCube*>(command->uniform)->Set( command->stage, static_cast<const TextureCube*>(command->texture) );
+                break;
+
+            case AbstractUniform::SAMPLER_BUFFER:
+                static_cast<SamplerUniformBuffer*>(command->uniform)->Set( command->stage, static_cast<const TextureBuffer*>(command->texture) );
+                break;
+
+            default:
+                assert(!"Can't happen");
+        }
+    }
+
+} // anonymous namespace
+
+namespace sgl {
+
+GLCommandList::GLCommandList(GLDevice* device_) :
+    device(device_),
+    numCommands(0)
+{
+}
+
+GLCommandList::~GLCommandList()
+{
+}
+
+template<typename Command>
+Command* GLCommandList::Append(unsigned int type, unsigned int dataSize)
+{
+    size_t   offset    = stream.size();
+    unsigned numBlocks = num_blocks( sizeof(Command) ) + num_blocks(dataSize);
+    stream.resize(offset + numBlocks);
+    ++numCommands;
+
+    Command* command = reinterpret_cast<Command*>(&stream[offset]);
+    command->header.type      = type;
+    command->header.numBlocks = numBlocks;
+    return command;
+}
+
+void GLCommandList::BindBlendState(const BlendState* blendState)
+{
+    Append<command_bind_state>(BIND_BLEND_STATE)->state = blendState;
+}
+
+void GLCommandList::BindDepthStencilState(const DepthStencilState* depthStencilState)
+{
+    Append<command_bind_state>(BIND_DEPTH_STENCIL_STATE)->state = depthStencilState;
+}
+
+void GLCommandList::BindRasterizerState(const RasterizerState* rasterizerState)
+{
+    Append<command_bind_state>(BIND_RASTERIZER_STATE)->state = rasterizerState;
+}
+
+void GLCommandList::BindProgram(const Program* program)
+{
+    Append<command_bind_program>(BIND_PROGRAM)->program = program;
+}
+
+void GLCommandList::BindTexture(unsigned int stage, const Texture* texture)
+{
+    assert(stage < Device::NUM_TEXTURE_STAGES);
+
+    command_bind_texture* command = Append<command_bind_texture>(BIND_TEXTURE);
+    command->stage   = stage;
+    command->texture = texture;
+}
+
+void GLCommandList::BindVertexBuffer(const VertexBuffer* vertexBuffer, const VertexLayout* vertexLayout)
+{
+    command_bind_vertex_buffer* command = Append<command_bind_vertex_buffer>(BIND_VERTEX_BUFFER);
+    command->vertexBuffer = vertexBuffer;
+    command->vertexLayout = vertexLayout;
+}
+
+void GLCommandList::BindIndexBuffer(const IndexBuffer* indexBuffer, IndexBuffer::INDEX_TYPE format)
+{
+    command_bind_index_buffer* command = Append<command_bind_index_buffer>(BIND_INDEX_BUFFER);
+    command->indexBuffer = indexBuffer;
+    command->format      = format;
+}
+
+void GLCommandList::BindRenderTarget(const RenderTarget* renderTarget)
+{
+    Append<command_bind_render_target>(BIND_RENDER_TARGET)->renderTarget = renderTarget;
+}
+
+void GLCommandList::SetViewport(const rectangle& vp)
+{
+    Append<command_set_viewport>(SET_VIEWPORT)->viewport = vp;
+}
+
+void GLCommandList::SetUniform( AbstractUniform* uniform,
+                                const void*      values,
+                                unsigned int     count )
+{
+    assert(uniform && values);
+
+    size_t               dataSize = uniform_size( uniform->Type() ) * count;
+    command_set_uniform* command  = Append<command_set_uniform>(SET_UNIFORM, dataSize);
+    command->uniform = uniform;
+    command->count   = count;
+    memcpy(const_cast<void*>( command_data(command) ), values, dataSize);
+}
+
+void GLCommandList::SetSamplerUniform( AbstractUniform* uniform,
+                                       unsigned int     stage,
+                                       const Texture*   texture )
+{
+    assert(uniform);
+
+    command_set_sampler_uniform* command = Append<command_set_sampler_uniform>(SET_SAMPLER_UNIFORM);
+    command->uniform = uniform;
+    command->stage   = stage;
+    command->texture = texture;
+}
+
+void GLCommandList::SetBufferSubData( Buffer*         buffer,
+                                      unsigned int    offset,
+                                      unsigned int    dataSize,
+                                      const void*     data )
+{
+    assert(buffer && data);
+
+    command_set_buffer_sub_data* command = Append<command_set_buffer_sub_data>(SET_BUFFER_SUB_DATA, dataSize);
+    command->buffer   = buffer;
+    command->offset   = offset;
+    command->dataSize = dataSize;
+    memcpy(const_cast<void*>( command_data(command) ), data, dataSize);
+}
+
+void GLCommandList::Draw( PRIMITIVE_TYPE primType,
+                          unsigned       firstVertex,
+                          unsigned       numVertices )
+{
+    command_draw* command = Append<command_draw>(DRAW);
+    command->primType     = primType;
+    command->first        = firstVertex;
+    command->count        = numVertices;
+    command->numInstances = 1;
+}
+
+void GLCommandList::DrawIndexed( PRIMITIVE_TYPE primType,
+                                 unsigned       firstIndex,
+                                 unsigned       numIndices )
+{
+    command_draw* command = Append<command_draw>(DRAW_INDEXED);
+    command->primType     = primType;
+    command->first        = firstIndex;
+    command->count        = numIndices;
+    command->numInstances = 1;
+}
+
+#ifndef SIMPLE_GL_ES
+void GLCommandList::DrawInstanced( PRIMITIVE_TYPE primType,
+                                   unsigned       firstVertex,
+                                   unsigned       numVertices,
+                                   unsigned       numInstances )
+{
+    command_draw* command = Append<command_draw>(DRAW_INSTANCED);
+    command->primType     = primType;
+    command->first        = firstVertex;
+    command->count        = numVertices;
+    command->numInstances = numInstances;
+}
+
+void GLCommandList::DrawIndexedInstanced( PRIMITIVE_TYPE primType,
+                                          unsigned       firstIndex,
+                                          unsigned       numIndices,
+                                          unsigned       numInstances )
+{
+    command_draw* command = Append<command_draw>(DRAW_INDEXED_INSTANCED);
+    command->primType     = primType;
+    command->first        = firstIndex;
+    command->count        = numIndices;
+    command->numInstances = numInstances;
+}
+#endif // !defined(SIMPLE_GL_ES)
+
+void GLCommandList::Clear(bool colorBuffer, bool depthBuffer, bool stencilBuffer)
+{
+    command_clear* command = Append<command_clear>(CLEAR);
+    command->colorBuffer   = colorBuffer;
+    command->depthBuffer   = depthBuffer;
+    command->stencilBuffer = stencilBuffer;
+}
+
+void GLCommandList::Reset()
+{
+    stream.clear();
+    numCommands = 0;
+}
+
+SGL_HRESULT GLCommandList::Execute() const
+{
+    SGL_HRESULT result = SGL_OK;
+    for (size_t i = 0; i < stream.size(); )
+    {
+        const command_header* header = reinterpret_cast<const command_header*>(&stream[i]);
+        switch (header->type)
+        {
+            case BIND_BLEND_STATE:
+                static_cast<const BlendState*>( reinterpret_cast<const command_bind_state*>(header)->state )->Bind();
+                break;
+
+            case BIND_DEPTH_STENCIL_STATE:
+                static_cast<const DepthStencilState*>( reinterpret_cast<const command_bind_state*>(header)->state )->Bind();
+                break;
+
+            case BIND_RASTERIZER_STATE:
+                static_cast<const RasterizerState*>( reinterpret_cast<const command_bind_state*>(header)->state )->Bind();
+                break;
+
+            case BIND_PROGRAM:
+            {
+                const Program* program = reinterpret_cast<const command_bind_program*>(header)->program;
+                if (program) {
+                    result = program->Bind();
+                }
+                else if ( device->CurrentProgram() ) {
+                    device->CurrentProgram()->Unbind();
+                }
+                break;
+            }
+
+            case BIND_TEXTURE:
+            {
+                const command_bind_texture* command = reinterpret_cast<const command_bind_texture*>(header);
+                if (command->texture) {
+                    result = command->texture->Bind(command->stage);
+                }
+                else if ( device->CurrentTexture(command->stage) ) {
+                    device->CurrentTexture(command->stage)->Unbind();
+                }
+                break;
+            }
+
+            case BIND_VERTEX_BUFFER:
+            {
+                const command_bind_vertex_buffer* command = reinterpret_cast<const command_bind_vertex_buffer*>(header);
+                if (command->vertexBuffer) {
+                    command->vertexBuffer->Bind(command->vertexLayout);
+                }
+                else if ( device->CurrentVertexBuffer() ) {
+                    device->CurrentVertexBuffer()->Unbind();
+                }
+                break;
+            }
+
+            case BIND_INDEX_BUFFER:
+            {
+                const command_bind_index_buffer* command = reinterpret_cast<const command_bind_index_buffer*>(header);
+                if (command->indexBuffer) {
+                    command->indexBuffer->Bind(command->format);
+                }
+                else if ( device->CurrentIndexBuffer() ) {
+                    device->CurrentIndexBuffer()->Unbind();
+                }
+                break;
+            }
+
+            case BIND_RENDER_TARGET:
+            {
+                const RenderTarget* renderTarget = reinterpret_cast<const command_bind_render_target*>(header)->renderTarget;
+                if (renderTarget) {
+                    result = renderTarget->Bind();
+                }
+                else if ( device->CurrentRenderTarget() ) {
+                    device->CurrentRenderTarget()->Unbind();
+                }
+                break;
+            }
+
+            case SET_VIEWPORT:
+                device->SetViewport( reinterpret_cast<const command_set_viewport*>(header)->viewport );
+                break;
+
+            case SET_UNIFORM:
+                set_uniform( reinterpret_cast<const command_set_uniform*>(header) );
+                break;
+
+            case SET_SAMPLER_UNIFORM:
+                set_sampler_uniform( reinterpret_cast<const command_set_sampler_uniform*>(header) );
+                break;
+
+            case SET_BUFFER_SUB_DATA:
+            {
+                const command_set_buffer_sub_data* command = reinterpret_cast<const command_set_buffer_sub_data*>(header);
+                result = command->buffer->SetSubData( command->offset, command->dataSize, command_data(command) );
+                break;
+            }
+
+            case DRAW:
+            {
+                const command_draw* command = reinterpret_cast<const command_draw*>(header);
+                device->Draw(command->primType, command->first, command->count);
+                break;
+            }
+
+            case DRAW_INDEXED:
+            {
+                const command_draw* command = reinterpret_cast<const command_draw*>(header);
+                device->DrawIndexed(command->primType, command->first, command->count);
+                break;
+            }
+
+        #ifndef SIMPLE_GL_ES
+            case DRAW_INSTANCED:
+            {
+                const command_draw* command = reinterpret_cast<const command_draw*>(header);
+                device->DrawInstanced(command->primType, command->first, command->count, command->numInstances);
+                break;
+            }
+
+            case DRAW_INDEXED_INSTANCED:
+            {
+                const command_draw* command = reinterpret_cast<const command_draw*>(header);
+                device->DrawIndexedInstanced(command->primType, command->first, command->count, command->numInstances);
+                break;
+            }
+        #endif // !defined(SIMPLE_GL_ES)
+
+            case CLEAR:
+            {
+                const command_clear* command = reinterpret_cast<const command_clear*>(header);
+                device->Clear(command->colorBuffer, command->depthBuffer, command->stencilBuffer);
+                break;
+            }
+
+            default:
+                return EInvalidCall("GLCommandList::Execute failed. Command stream is corrupted.");
+        }
+
+    #ifndef SGL_NO_STATUS_CHECK
+        if (SGL_OK != result) {
+            return result;
+        }
+    #endif
+
+        i += header->numBlocks;
+    }
+
+    return SGL_OK;
+}
+
+} // namespace sgl
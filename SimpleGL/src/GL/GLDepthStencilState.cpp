@@ -4,6 +4,8 @@
 
 namespace {
 
+    using namespace sgl;
+
     GLenum BIND_COMPARISON_FUNCTION[] =
     {
 	    GL_NEVER,
@@ -28,6 +30,147 @@ namespace {
 	    GL_INVERT,
     };
 
+    typedef GLDevice::STATE_CACHE                   state_cache;
+    typedef DepthStencilState::DESC                 depth_stencil_desc;
+    typedef DepthStencilState::STENCIL_OPERATION    stencil_operation;
+
+    bool stencil_face_equal(const state_cache& cache, int face, const stencil_operation& op, GLint readMask)
+    {
+        return cache.stencilReadMask[face]    == readMask
+            && cache.stencilFunc[face]        == GLint(BIND_COMPARISON_FUNCTION[op.stencilFunc])
+            && cache.stencilFailOp[face]      == GLint(BIND_OPERATION[op.stencilFailOp])
+            && cache.stencilDepthFailOp[face] == GLint(BIND_OPERATION[op.stencilDepthFailOp])
+            && cache.stencilPassOp[face]      == GLint(BIND_OPERATION[op.stencilPassOp]);
+    }
+
+    void store_stencil_face(state_cache& cache, int face, const stencil_operation& op, GLint readMask)
+    {
+        cache.stencilReadMask[face]    = readMask;
+        cache.stencilFunc[face]        = BIND_COMPARISON_FUNCTION[op.stencilFunc];
+        cache.stencilFailOp[face]      = BIND_OPERATION[op.stencilFailOp];
+        cache.stencilDepthFailOp[face] = BIND_OPERATION[op.stencilDepthFailOp];
+        cache.stencilPassOp[face]      = BIND_OPERATION[op.stencilPassOp];
+    }
+
+    bool depth_stencil_equal(const state_cache& cache, const depth_stencil_desc& desc)
+    {
+        if ( cache.depthEnable != GLint(desc.depthEnable)
+             || cache.depthWriteMask != GLint(desc.depthWriteMask)
+             || cache.stencilEnable  != GLint(desc.stencilEnable) )
+        {
+            return false;
+        }
+
+        if ( desc.depthEnable && cache.depthFunc != GLint(BIND_COMPARISON_FUNCTION[desc.depthFunc]) ) {
+            return false;
+        }
+
+        if (desc.stencilEnable)
+        {
+            return cache.stencilWriteMask == GLint(desc.stencilWriteMask)
+                && stencil_face_equal(cache, 0, desc.frontFaceOp, desc.stencilReadMask)
+                && stencil_face_equal(cache, 1, desc.backFaceOp,  desc.stencilReadMask);
+        }
+
+        return true;
+    }
+
+    void store_depth_stencil(state_cache& cache, const depth_stencil_desc& desc)
+    {
+        cache.depthEnable    = desc.depthEnable;
+        cache.depthWriteMask = desc.depthWriteMask;
+        cache.stencilEnable  = desc.stencilEnable;
+        if (desc.depthEnable) {
+            cache.depthFunc = BIND_COMPARISON_FUNCTION[desc.depthFunc];
+        }
+
+        if (desc.stencilEnable)
+        {
+            cache.stencilWriteMask = desc.stencilWriteMask;
+            store_stencil_face(cache, 0, desc.frontFaceOp, desc.stencilReadMask);
+            store_stencil_face(cache, 1, desc.backFaceOp,  desc.stencilReadMask);
+        }
+    }
+
+    void set_stencil_face(state_cache& cache, int face, const stencil_operation& op, GLint readMask)
+    {
+        const GLenum glFace = (face == 0) ? GL_FRONT : GL_BACK;
+
+        GLint func = BIND_COMPARISON_FUNCTION[op.stencilFunc];
+        if (cache.stencilFunc[face] != func || cache.stencilReadMask[face] != readMask)
+        {
+            glStencilFuncSeparate(glFace, func, 0, readMask);
+            cache.stencilFunc[face]     = func;
+            cache.stencilReadMask[face] = readMask;
+        }
+
+        GLint failOp      = BIND_OPERATION[op.stencilFailOp];
+        GLint depthFailOp = BIND_OPERATION[op.stencilDepthFailOp];
+        GLint passOp      = BIND_OPERATION[op.stencilPassOp];
+        if ( cache.stencilFailOp[face]         != failOp
+             || cache.stencilDepthFailOp[face] != depthFailOp
+             || cache.stencilPassOp[face]      != passOp )
+        {
+            glStencilOpSeparate(glFace, failOp, depthFailOp, passOp);
+            cache.stencilFailOp[face]      = failOp;
+            cache.stencilDepthFailOp[face] = depthFailOp;
+            cache.stencilPassOp[face]      = passOp;
+        }
+    }
+
+    void set_depth_stencil(state_cache& cache, const depth_stencil_desc& desc)
+    {
+        if ( cache.depthEnable != GLint(desc.depthEnable) )
+        {
+            if (desc.depthEnable) {
+                glEnable(GL_DEPTH_TEST);
+            }
+            else {
+                glDisable(GL_DEPTH_TEST);
+            }
+            cache.depthEnable = desc.depthEnable;
+        }
+
+        if (desc.depthEnable)
+        {
+            GLint func = BIND_COMPARISON_FUNCTION[desc.depthFunc];
+            if (cache.depthFunc != func)
+            {
+                glDepthFunc(func);
+                cache.depthFunc = func;
+            }
+        }
+
+        if ( cache.depthWriteMask != GLint(desc.depthWriteMask) )
+        {
+            glDepthMask(desc.depthWriteMask);
+            cache.depthWriteMask = desc.depthWriteMask;
+        }
+
+        if ( cache.stencilEnable != GLint(desc.stencilEnable) )
+        {
+            if (desc.stencilEnable) {
+                glEnable(GL_STENCIL_TEST);
+            }
+            else {
+                glDisable(GL_STENCIL_TEST);
+            }
+            cache.stencilEnable = desc.stencilEnable;
+        }
+
+        if (desc.stencilEnable)
+        {
+            if ( cache.stencilWriteMask != GLint(desc.stencilWriteMask) )
+            {
+                glStencilMask(desc.stencilWriteMask);
+                cache.stencilWriteMask = desc.stencilWriteMask;
+            }
+
+            set_stencil_face(cache, 0, desc.frontFaceOp, desc.stencilReadMask);
+            set_stencil_face(cache, 1, desc.backFaceOp,  desc.stencilReadMask);
+        }
+    }
+
 } // anonymous namespace
 
 namespace sgl {
@@ -88,7 +231,13 @@ GLDepthStencilStateDisplayLists::~GLDepthStencilStateDisplayLists()
 // Override State
 void GLDepthStencilStateDisplayLists::Bind() const
 {
-    glCallList(bindDisplayList);
+    GLDevice::STATE_CACHE& cache = device->StateCache();
+    if ( !depth_stencil_equal(cache, desc) )
+    {
+        glCallList(bindDisplayList);
+        store_depth_stencil(cache, desc);
+    }
+    SGL_FRAME_STATISTICS(device, numStateBinds, 1);
     device->SetDepthStencilState(this);
 }
 
@@ -108,37 +257,9 @@ GLDepthStencilStateSeparate::~GLDepthStencilStateSeparate()
 // Override State
 void GLDepthStencilStateSeparate::Bind() const
 {
-    if (desc.depthEnable)
-    {
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(BIND_COMPARISON_FUNCTION[desc.depthFunc]);
-    }
-    else {
-        glDisable(GL_DEPTH_TEST);
-    }
-    glDepthMask(desc.depthWriteMask);
-
-    if (desc.stencilEnable)
-    {
-        glEnable(GL_STENCIL_TEST);
-        glStencilMask(desc.stencilWriteMask);
-
-        glStencilFuncSeparate(GL_FRONT, BIND_COMPARISON_FUNCTION[desc.frontFaceOp.stencilFunc], 0, desc.stencilReadMask);
-        glStencilFuncSeparate(GL_BACK,  BIND_COMPARISON_FUNCTION[desc.backFaceOp.stencilFunc],  0, desc.stencilReadMask);
-
-        glStencilOpSeparate( GL_FRONT,
-                             BIND_OPERATION[desc.frontFaceOp.stencilFailOp],
-                             BIND_OPERATION[desc.frontFaceOp.stencilDepthFailOp],
-                             BIND_OPERATION[desc.frontFaceOp.stencilPassOp] );
-        glStencilOpSeparate( GL_BACK,
-                             BIND_OPERATION[desc.backFaceOp.stencilFailOp],
-                             BIND_OPERATION[desc.backFaceOp.stencilDepthFailOp],
-                             BIND_OPERATION[desc.backFaceOp.stencilPassOp] );
-    }
-    else {
-        glDisable(GL_STENCIL_TEST);
-    }
+    set_depth_stencil(device->StateCache(), desc);
 
+    SGL_FRAME_STATISTICS(device, numStateBinds, 1);
     device->SetDepthStencilState(this);
 }
 
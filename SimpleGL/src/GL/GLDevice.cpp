@@ -1,4 +1,5 @@
 #include "GL/GLBlendState.h"
+#include "GL/GLCommandList.h"
 #include "GL/GLDepthStencilState.h"
 #include "GL/GLDeviceTraits.h"
 #include "GL/GLRasterizerState.h"
@@ -8,17 +9,25 @@
 #include "GL/GLVertexLayout.h"
 #include "GL/GLVertexBuffer.h"
 #include "GL/GLIndexBuffer.h"
+#include "GL/GLUniformBuffer.h"
 #include "GL/GLShader.h"
 #include "GL/GLProgram.h"
+#include "GL/GLQuery.h"
+#include "GL/GLReadbackRequest.h"
+#include "GL/GLStreamingBuffer.h"
+#include "GL/GLStreamOut.h"
 #include "GL/GLFFPProgram.h"
 #include "GL/GLTexture1D.h"
 #include "GL/GLTexture2D.h"
 #include "GL/GLTexture3D.h"
+#include "GL/GLTextureBuffer.h"
 #include "GL/GLTextureCube.h"
 #include "GL/GLVBORenderTarget.h"
 #include "GL/GLFont.h"
 #include "Utility/IlImage.h"
 #include "Utility/IfThenElse.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <string>
 
@@ -202,6 +211,12 @@ GLDevice::GLDevice() :
     makeCleanup(false),
     valid(true)
 {
+    defaultFramebuffer = 0;
+#if defined(__linux__) && !defined(__ANDROID__) && defined(SIMPLE_GL_USE_EGL)
+    eglDisplay = EGL_NO_DISPLAY;
+    eglSurface = EGL_NO_SURFACE;
+    eglContext = EGL_NO_CONTEXT;
+#endif
 #ifdef SIMPLE_GL_USE_DEVIL
     // init image library
     static bool ilInitialized = false;
@@ -258,6 +273,19 @@ GLDevice::GLDevice() :
 GLDevice::GLDevice(const Device::VIDEO_DESC& desc)
 :	valid(true)
 {
+    defaultFramebuffer = 0;
+#if defined(__linux__) && !defined(__ANDROID__) && defined(SIMPLE_GL_USE_EGL)
+    eglDisplay = EGL_NO_DISPLAY;
+    eglSurface = EGL_NO_SURFACE;
+    eglContext = EGL_NO_CONTEXT;
+#endif
+#ifndef SIMPLE_GL_USE_EGL
+    if (desc.offscreen) 
+    {
+        sglSetError(SGLERR_UNSUPPORTED, "SimpleGL compiled without EGL. Can't create offscreen device.");
+        throw gl_error("GLDevice::GLDevice() failed");
+    }
+#endif
 #ifdef SIMPLE_GL_USE_DEVIL
     // init image library
     static bool ilInitialized = false;
@@ -270,166 +298,425 @@ GLDevice::GLDevice(const Device::VIDEO_DESC& desc)
 #ifdef WIN32
 
 #elif defined(__linux__)
-    // Open a connection to the X server
-    display = XOpenDisplay(0);
-    if (!display) {
-        throw gl_error("Couldn't open display");
-    }
-
-    // Make sure OpenGL's GLX extension supported
-    int errorBase;
-	int eventBase;
-    if( !glXQueryExtension( display, &errorBase, &eventBase ) ) {
-        throw gl_error("X server has no OpenGL GLX extension");
-    }
-
-    // Find an appropriate visual
-    int bufferAttributes32[]  =
-    {
-        GLX_DRAWABLE_TYPE,  GLX_WINDOW_BIT,
-        GLX_RENDER_TYPE,    GLX_RGBA_BIT,
-        GLX_DOUBLEBUFFER,   True,
-        GLX_RED_SIZE,       8,
-        GLX_GREEN_SIZE,     8,
-        GLX_BLUE_SIZE,      8,
-        GLX_ALPHA_SIZE,     8,
-        GLX_DEPTH_SIZE,     24,
-        GLX_STENCIL_SIZE,   8,
-        None
-    };
+#ifdef SIMPLE_GL_USE_EGL
+    if (desc.offscreen) {
+        InitOffscreenContext(desc);
+    }
+    else
+#endif
+    {
+        // Open a connection to the X server
+        display = XOpenDisplay(0);
+        if (!display) {
+            throw gl_error("Couldn't open display");
+        }
 
-    int bufferAttributes24[]  =
-    {
-        GLX_DRAWABLE_TYPE,  GLX_WINDOW_BIT,
-        GLX_RENDER_TYPE,    GLX_RGBA_BIT,
-        GLX_DOUBLEBUFFER,   True,
-        GLX_RED_SIZE,       8,
-        GLX_GREEN_SIZE,     8,
-        GLX_BLUE_SIZE,      8,
-        GLX_DEPTH_SIZE,     24,
-        GLX_STENCIL_SIZE,   8,
-        None
-    };
+        // Make sure OpenGL's GLX extension supported
+        int errorBase;
+    	int eventBase;
+        if( !glXQueryExtension( display, &errorBase, &eventBase ) ) {
+            throw gl_error("X server has no OpenGL GLX extension");
+        }
 
-    int* bufferAttributes = bufferAttributes32;
-    if ( Texture::FORMAT_TRAITS[desc.colorBufferFormat].sizeInBits == 24 ) {
-        bufferAttributes = bufferAttributes24;
-    }
+        // Find an appropriate visual
+        int bufferAttributes32[]  =
+        {
+            GLX_DRAWABLE_TYPE,  GLX_WINDOW_BIT,
+            GLX_RENDER_TYPE,    GLX_RGBA_BIT,
+            GLX_DOUBLEBUFFER,   True,
+            GLX_RED_SIZE,       8,
+            GLX_GREEN_SIZE,     8,
+            GLX_BLUE_SIZE,      8,
+            GLX_ALPHA_SIZE,     8,
+            GLX_DEPTH_SIZE,     24,
+            GLX_STENCIL_SIZE,   8,
+            None
+        };
+
+        int bufferAttributes24[]  =
+        {
+            GLX_DRAWABLE_TYPE,  GLX_WINDOW_BIT,
+            GLX_RENDER_TYPE,    GLX_RGBA_BIT,
+            GLX_DOUBLEBUFFER,   True,
+            GLX_RED_SIZE,       8,
+            GLX_GREEN_SIZE,     8,
+            GLX_BLUE_SIZE,      8,
+            GLX_DEPTH_SIZE,     24,
+            GLX_STENCIL_SIZE,   8,
+            None
+        };
+
+        int* bufferAttributes = bufferAttributes32;
+        if ( Texture::FORMAT_TRAITS[desc.colorBufferFormat].sizeInBits == 24 ) {
+            bufferAttributes = bufferAttributes24;
+        }
 
-    // Try for the double-bufferd visual first
-    GLXFBConfig*    FBConfigs;
-    GLXFBConfig     renderFBConfig;
-    int             numFBConfigs;
-	FBConfigs = glXChooseFBConfig( display,
-			    				   DefaultScreen(display),
-                                   bufferAttributes,
-                                   &numFBConfigs );
-    if (!FBConfigs) {
-        throw gl_error("Couldn't get FB config with 24 bit depth buffer and 8 bit stencil buffer");
-    }
+        // Try for the double-bufferd visual first
+        GLXFBConfig*    FBConfigs;
+        GLXFBConfig     renderFBConfig;
+        int             numFBConfigs;
+    	FBConfigs = glXChooseFBConfig( display,
+    			    				   DefaultScreen(display),
+                                       bufferAttributes,
+                                       &numFBConfigs );
+        if (!FBConfigs) {
+            throw gl_error("Couldn't get FB config with 24 bit depth buffer and 8 bit stencil buffer");
+        }
 
-    XVisualInfo* visualInfo = 0;
-	for(int i = 0; i < numFBConfigs; i++)
-	{
-		visualInfo = glXGetVisualFromFBConfig(display, FBConfigs[i]);
-        if (!visualInfo) {
-			continue;
+        XVisualInfo* visualInfo = 0;
+    	for(int i = 0; i < numFBConfigs; i++)
+    	{
+    		visualInfo = glXGetVisualFromFBConfig(display, FBConfigs[i]);
+            if (!visualInfo) {
+    			continue;
+            }
+
+            visualInfo     = glXGetVisualFromFBConfig(display, FBConfigs[i]);
+            renderFBConfig = FBConfigs[i];
+            break;
         }
 
-        visualInfo     = glXGetVisualFromFBConfig(display, FBConfigs[i]);
-        renderFBConfig = FBConfigs[i];
-        break;
-    }
+        // Setup window
+        XSetWindowAttributes windowAttributes;
+        windowAttributes.colormap     = XCreateColormap( display,
+                                                         RootWindow(display, visualInfo->screen),
+                                                         visualInfo->visual,
+                                                         AllocNone );
+        windowAttributes.border_pixel = 0;
+        windowAttributes.event_mask   = ExposureMask           |
+                                        VisibilityChangeMask   |
+                                        KeyPressMask           |
+                                        KeyReleaseMask         |
+                                        ButtonPressMask        |
+                                        ButtonReleaseMask      |
+                                        PointerMotionMask      |
+                                        StructureNotifyMask    |
+                                        SubstructureNotifyMask |
+                                        FocusChangeMask;
+
+        // Create an X window with the selected visual
+        window = XCreateWindow( display,
+                                RootWindow(display, visualInfo->screen),
+                                0, 0,                                   // x/y position of top-left outside corner of the window
+                                desc.width, desc.height,                // Width and height of window
+                                0,                                      // Border width
+                                visualInfo->depth,
+                                InputOutput,
+                                visualInfo->visual,
+                                CWBorderPixel | CWColormap | CWEventMask,
+                                &windowAttributes );
+
+        // Create an OpenGL rendering context
+    	glxContext = glXCreateNewContext( display,
+    									  renderFBConfig,
+    									  GLX_RGBA_TYPE,
+    									  0,              // No sharing of display lists
+    									  GL_TRUE );      // Direct rendering if possible
+        if (!glxContext) {
+            throw gl_error("Couldn't create rendering context");
+        }
 
-    // Setup window
-    XSetWindowAttributes windowAttributes;
-    windowAttributes.colormap     = XCreateColormap( display,
-                                                     RootWindow(display, visualInfo->screen),
-                                                     visualInfo->visual,
-                                                     AllocNone );
-    windowAttributes.border_pixel = 0;
-    windowAttributes.event_mask   = ExposureMask           |
-                                    VisibilityChangeMask   |
-                                    KeyPressMask           |
-                                    KeyReleaseMask         |
-                                    ButtonPressMask        |
-                                    ButtonReleaseMask      |
-                                    PointerMotionMask      |
-                                    StructureNotifyMask    |
-                                    SubstructureNotifyMask |
-                                    FocusChangeMask;
-
-    // Create an X window with the selected visual
-    window = XCreateWindow( display,
-                            RootWindow(display, visualInfo->screen),
-                            0, 0,                                   // x/y position of top-left outside corner of the window
-                            desc.width, desc.height,                // Width and height of window
-                            0,                                      // Border width
-                            visualInfo->depth,
-                            InputOutput,
-                            visualInfo->visual,
-                            CWBorderPixel | CWColormap | CWEventMask,
-                            &windowAttributes );
-
-    // Create an OpenGL rendering context
-	glxContext = glXCreateNewContext( display,
-									  renderFBConfig,
-									  GLX_RGBA_TYPE,
-									  0,              // No sharing of display lists
-									  GL_TRUE );      // Direct rendering if possible
-    if (!glxContext) {
-        throw gl_error("Couldn't create rendering context");
-    }
-
-	// make sure to get a GLX window with the fb-config with render-support
-	glxWindow   = glXCreateWindow(display, renderFBConfig, window, 0);
-	glxDrawable = glxWindow;
-
-    // Request the X window to be displayed on the screen
-    XMapWindow(display, window);
-
-	// ... and wait for it to appear
-	XEvent event;
-	XIfEvent(display, &event, wait_for_notify, (XPointer) window);
-
-    // Bind the rendering context to the window
-    glXMakeContextCurrent(display, glxWindow, glxWindow, glxContext);
+    	// make sure to get a GLX window with the fb-config with render-support
+    	glxWindow   = glXCreateWindow(display, renderFBConfig, window, 0);
+    	glxDrawable = glxWindow;
 
-    makeCleanup = true;
+        // Request the X window to be displayed on the screen
+        XMapWindow(display, window);
+
+    	// ... and wait for it to appear
+    	XEvent event;
+    	XIfEvent(display, &event, wait_for_notify, (XPointer) window);
+
+        // Bind the rendering context to the window
+        glXMakeContextCurrent(display, glxWindow, glxWindow, glxContext);
+
+        makeCleanup = true;
+    }
 #endif
 
-    static bool glewInitialized = false;
-    if (!glewInitialized)
+    // GLX and EGL contexts load entry points separately
+#if defined(__linux__) && defined(SIMPLE_GL_USE_EGL)
+    bool eglDevice = (eglContext != EGL_NO_CONTEXT);
+#else
+    bool eglDevice = false;
+#endif
+    static bool glewInitialized[2] = { false, false };
+    if (!glewInitialized[eglDevice])
     {
         GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        // GLEW built for GLX fails without X display, but GL entry points are loaded anyway
+        if (eglDevice && err == GLEW_ERROR_NO_GLX_DISPLAY) {
+            err = GLEW_OK;
+        }
+#endif
         if (GLEW_OK != err) {
             throw gl_error("Can't init glew.");
         }
 
         std::cout << "OpenGL version is " << glGetString(GL_VERSION) << endl;
-        glewInitialized = true;
+        glewInitialized[eglDevice] = true;
+    }
+
+#if defined(__linux__) && defined(SIMPLE_GL_USE_EGL)
+    if (eglContext != EGL_NO_CONTEXT && eglSurface == EGL_NO_SURFACE) {
+        CreateDefaultFramebuffer(desc);
     }
+#endif
 
     InitOpenGL();
 }
 
+#if defined(__linux__) && defined(SIMPLE_GL_USE_EGL)
+void GLDevice::InitOffscreenContext(const Device::VIDEO_DESC& desc)
+{
+    // Prefer Mesa surfaceless platform, it needs neither X server nor GPU
+#if defined(EGL_EXT_platform_base) && defined(EGL_PLATFORM_SURFACELESS_MESA)
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if ( clientExtensions && strstr(clientExtensions, "EGL_MESA_platform_surfaceless") )
+    {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay) {
+            eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, 0);
+        }
+    }
+#endif
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    if ( eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, 0, 0) ) {
+        throw gl_error("Couldn't initialize EGL display");
+    }
+
+    if ( !eglBindAPI(EGL_OPENGL_API) ) {
+        throw gl_error("EGL doesn't support OpenGL API");
+    }
+
+    // Try pbuffer config first
+    EGLint configAttributes[] =
+    {
+        EGL_SURFACE_TYPE,       EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         Texture::FORMAT_TRAITS[desc.colorBufferFormat].sizeInBits == 24 ? 0 : 8,
+        EGL_DEPTH_SIZE,         24,
+        EGL_STENCIL_SIZE,       8,
+        EGL_NONE
+    };
+
+    EGLConfig   config;
+    EGLint      numConfigs = 0;
+    bool        pbuffer    = eglChooseConfig(eglDisplay, configAttributes, &config, 1, &numConfigs) && numConfigs > 0;
+    if (!pbuffer)
+    {
+        // context without surface, framebuffer is created by the device
+        const char* displayExtensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+        if ( !displayExtensions || !strstr(displayExtensions, "EGL_KHR_surfaceless_context") ) {
+            throw gl_error("EGL supports neither pbuffers nor surfaceless contexts");
+        }
+
+        configAttributes[1] = 0;
+        if ( !eglChooseConfig(eglDisplay, configAttributes, &config, 1, &numConfigs) || numConfigs == 0 ) {
+            throw gl_error("Couldn't get EGL config");
+        }
+    }
+
+    eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, 0);
+    if (eglContext == EGL_NO_CONTEXT) {
+        throw gl_error("Couldn't create EGL rendering context");
+    }
+
+    if (pbuffer)
+    {
+        EGLint surfaceAttributes[] = 
+        {
+            EGL_WIDTH,  EGLint(desc.width),
+            EGL_HEIGHT, EGLint(desc.height),
+            EGL_NONE
+        };
+
+        eglSurface = eglCreatePbufferSurface(eglDisplay, config, surfaceAttributes);
+        if (eglSurface == EGL_NO_SURFACE) {
+            throw gl_error("Couldn't create EGL pbuffer surface");
+        }
+    }
+
+    if ( !eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext) ) {
+        throw gl_error("Couldn't make EGL context current");
+    }
+
+    makeCleanup = true;
+}
+
+void GLDevice::CreateDefaultFramebuffer(const Device::VIDEO_DESC& desc)
+{
+    GLenum colorFormat = Texture::FORMAT_TRAITS[desc.colorBufferFormat].sizeInBits == 24 ? GL_RGB8 : GL_RGBA8;
+
+    glGenRenderbuffers(2, defaultRenderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, defaultRenderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, colorFormat, desc.width, desc.height);
+    glBindRenderbuffer(GL_RENDERBUFFER, defaultRenderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, desc.width, desc.height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &defaultFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, defaultRenderbuffers[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, defaultRenderbuffers[1]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, defaultRenderbuffers[1]);
+    if ( glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE ) {
+        throw gl_error("Couldn't create offscreen framebuffer");
+    }
+
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+    // context without surface has empty viewport
+    glViewport(0, 0, desc.width, desc.height);
+}
+#endif // defined(__linux__) && defined(SIMPLE_GL_USE_EGL)
+
 #endif // !defined(__ANDROID__)
 
+namespace {
+
+#ifndef SIMPLE_GL_ES
+#if defined(GL_KHR_debug) || defined(GL_ARB_debug_output)
+    void GLAPIENTRY debug_message_callback( GLenum          /*source*/,
+                                            GLenum          type,
+                                            GLuint          /*id*/,
+                                            GLenum          /*severity*/,
+                                            GLsizei         /*length*/,
+                                            const GLchar*   message,
+                                            const void*     /*userParam*/ )
+    {
+        // performance and portability messages are not errors, ARB_debug_output uses the same values
+    #ifdef GL_KHR_debug
+        if (type == GL_DEBUG_TYPE_ERROR || type == GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR) {
+    #else
+        if (type == GL_DEBUG_TYPE_ERROR_ARB || type == GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR_ARB) {
+    #endif
+            sglSetError(SGLERR_INVALID_CALL, message);
+        }
+    }
+#endif
+#endif // !defined(SIMPLE_GL_ES)
+
+    bool debug_output_supported()
+    {
+        bool supported = false;
+    #if !defined(SIMPLE_GL_ES) && defined(GL_KHR_debug)
+        supported = supported || GLEW_KHR_debug;
+    #endif
+    #if !defined(SIMPLE_GL_ES) && defined(GL_ARB_debug_output)
+        supported = supported || GLEW_ARB_debug_output;
+    #endif
+        return supported;
+    }
+
+    void enable_debug_output(bool toggle)
+    {
+    #if !defined(SIMPLE_GL_ES) && defined(GL_KHR_debug)
+        if (GLEW_KHR_debug)
+        {
+            // callback sets the error, which is not thread safe, and must report it
+            // from the call which caused it, so messages are delivered synchronously
+            if (toggle)
+            {
+                glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+                glDebugMessageCallback(debug_message_callback, 0);
+                glEnable(GL_DEBUG_OUTPUT);
+            }
+            else
+            {
+                glDisable(GL_DEBUG_OUTPUT);
+                glDebugMessageCallback(0, 0);
+                glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+            }
+            return;
+        }
+    #endif
+    #if !defined(SIMPLE_GL_ES) && defined(GL_ARB_debug_output)
+        // ARB_debug_output is always enabled in debug context, only callback can be changed
+        if (toggle)
+        {
+            glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
+            glDebugMessageCallbackARB(debug_message_callback, 0);
+        }
+        else
+        {
+            glDebugMessageCallbackARB(0, 0);
+            glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
+        }
+    #else
+        (void)toggle;
+    #endif
+    }
+
+} // anonymous namespace
+
 SGL_HRESULT GLDevice::InitOpenGL()
 {
     // defaults
     currentRenderTarget         = 0;
     currentProgram              = 0;
+    dirtyUniformsProgram        = 0;
     currentIndexBuffer          = 0;
     currentVertexBuffer         = 0;
     currentVertexLayout         = 0;
 
+    vertexArrayDesc.vertexLayout = 0;
+    vertexArrayDesc.vertexBuffer = 0;
+    vertexArrayDesc.indexBuffer  = 0;
+
     std::fill( currentTexture, currentTexture + NUM_TEXTURE_STAGES, ref_ptr<const Texture>() );
+    ResetStateCache();
 
     // create unqie objects
     deviceTraits.reset( new GLDeviceTraits(this) );
+#ifdef SIMPLE_GL_ES
+    directStateAccess = false;
+#else
+    directStateAccess = (glewIsSupported("GL_EXT_direct_state_access") == GL_TRUE);
+#endif
+
+    // let the driver compile shaders in its threads, so linking can be polled
+#if !defined(SIMPLE_GL_ES) && defined(GL_KHR_parallel_shader_compile)
+    parallelShaderCompile = (GLEW_KHR_parallel_shader_compile == GL_TRUE);
+    if (parallelShaderCompile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    }
+#else
+    parallelShaderCompile = false;
+#endif
+    vertexArrayObjects = false;
+    multiDraw          = false;
+    baseVertex         = false;
+    instancing         = false;
+    drawIndirect       = false;
+    multiDrawIndirect  = false;
+    bufferCopies       = false;
     assert( GL_NO_ERROR == glGetError() );
 
+    // frame fences let buffers skip synchronization with the GPU
+#ifdef SIMPLE_GL_ES
+    frameFencing = false;
+#else
+    frameFencing = (GLEW_ARB_sync == GL_TRUE);
+#endif
+    frameIndex         = 0;
+    numCompletedFrames = 0;
+    std::fill(frameFences, frameFences + NUM_FRAME_FENCES, (void*)0);
+
+    // prefer debug output, it doesn't stall the pipeline
+    validationMode = VALIDATION_GET_ERROR;
+    if ( debug_output_supported() ) {
+        SetValidationMode(VALIDATION_DEBUG_OUTPUT);
+    }
+
     // get viewport
     GLint vp[4];
     glGetIntegerv(GL_VIEWPORT, vp);
@@ -444,6 +731,15 @@ SGL_HRESULT GLDevice::InitOpenGL()
 
 GLDevice::~GLDevice()
 {
+#ifndef SIMPLE_GL_ES
+    for (unsigned i = 0; i < NUM_FRAME_FENCES; ++i)
+    {
+        if (frameFences[i]) {
+            glDeleteSync( static_cast<GLsync>(frameFences[i]) );
+        }
+    }
+#endif
+
     // clean up
     if (makeCleanup)
     {
@@ -452,11 +748,31 @@ GLDevice::~GLDevice()
         wglMakeCurrent(0, 0);
         ReleaseDC(hWnd, hDC);
     #elif defined(__linux__) && !defined(__ANDROID__)
-        // If sgl created window by itself
-        glXDestroyContext(display, glxContext);
-        XUnmapWindow(display, window);
-        XDestroyWindow(display, window);
-        XCloseDisplay(display);
+    #ifdef SIMPLE_GL_USE_EGL
+        if (eglDisplay != EGL_NO_DISPLAY)
+        {
+            if (defaultFramebuffer) 
+            {
+                glDeleteFramebuffers(1, &defaultFramebuffer);
+                glDeleteRenderbuffers(2, defaultRenderbuffers);
+            }
+
+            eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            if (eglSurface != EGL_NO_SURFACE) {
+                eglDestroySurface(eglDisplay, eglSurface);
+            }
+            eglDestroyContext(eglDisplay, eglContext);
+            eglTerminate(eglDisplay);
+        }
+        else
+    #endif
+        {
+            // If sgl created window by itself
+            glXDestroyContext(display, glxContext);
+            XUnmapWindow(display, window);
+            XDestroyWindow(display, window);
+            XCloseDisplay(display);
+        }
 	#endif
     }
 }
@@ -467,6 +783,293 @@ SGL_HRESULT GLDevice::Sync() const
     return SGL_OK;
 }
 
+void GLDevice::ResetStateCache()
+{
+    // -1 never matches valid gl value, so every field will be resent on next bind
+    std::fill( reinterpret_cast<GLint*>(&stateCache),
+               reinterpret_cast<GLint*>(&stateCache) + sizeof(STATE_CACHE) / sizeof(GLint),
+               -1 );
+
+    // vertex array object binding is unknown, rebind it on the next draw
+    boundVertexArray = 0;
+    vertexArrayDirty = true;
+}
+
+namespace {
+
+    int buffer_target_index(GLenum glTarget)
+    {
+        switch (glTarget)
+        {
+            case GL_ARRAY_BUFFER:               return GLDevice::ARRAY_BUFFER;
+            case GL_ELEMENT_ARRAY_BUFFER:       return GLDevice::ELEMENT_ARRAY_BUFFER;
+        #ifndef SIMPLE_GL_ES
+            case GL_COPY_READ_BUFFER:           return GLDevice::COPY_READ_BUFFER;
+            case GL_COPY_WRITE_BUFFER:          return GLDevice::COPY_WRITE_BUFFER;
+            case GL_PIXEL_PACK_BUFFER:          return GLDevice::PIXEL_PACK_BUFFER;
+            case GL_PIXEL_UNPACK_BUFFER:        return GLDevice::PIXEL_UNPACK_BUFFER;
+            case GL_UNIFORM_BUFFER:             return GLDevice::UNIFORM_BUFFER;
+            case GL_TEXTURE_BUFFER:             return GLDevice::TEXTURE_BUFFER;
+            case GL_TRANSFORM_FEEDBACK_BUFFER:  return GLDevice::TRANSFORM_FEEDBACK_BUFFER;
+        #endif
+            default:
+                return -1;
+        }
+    }
+
+    // state queried to get buffer bound to the target
+    GLenum buffer_target_binding(GLenum glTarget)
+    {
+        switch (glTarget)
+        {
+            case GL_ARRAY_BUFFER:               return GL_ARRAY_BUFFER_BINDING;
+            case GL_ELEMENT_ARRAY_BUFFER:       return GL_ELEMENT_ARRAY_BUFFER_BINDING;
+        #ifndef SIMPLE_GL_ES
+            case GL_COPY_READ_BUFFER:           return GL_COPY_READ_BUFFER;
+            case GL_COPY_WRITE_BUFFER:          return GL_COPY_WRITE_BUFFER;
+            case GL_PIXEL_PACK_BUFFER:          return GL_PIXEL_PACK_BUFFER_BINDING;
+            case GL_PIXEL_UNPACK_BUFFER:        return GL_PIXEL_UNPACK_BUFFER_BINDING;
+            case GL_UNIFORM_BUFFER:             return GL_UNIFORM_BUFFER_BINDING;
+            case GL_TEXTURE_BUFFER:             return GL_TEXTURE_BUFFER;
+            case GL_TRANSFORM_FEEDBACK_BUFFER:  return GL_TRANSFORM_FEEDBACK_BUFFER_BINDING;
+        #endif
+            default:
+                return 0;
+        }
+    }
+
+} // anonymous namespace
+
+void GLDevice::BindBuffer(GLenum glTarget, GLuint glBuffer)
+{
+    int index = buffer_target_index(glTarget);
+    if (index < 0) 
+    {
+        glBindBuffer(glTarget, glBuffer);
+        return;
+    }
+
+    GLint& boundBuffer = stateCache.boundBuffer[index];
+    if ( boundBuffer != GLint(glBuffer) )
+    {
+        glBindBuffer(glTarget, glBuffer);
+        boundBuffer = glBuffer;
+    }
+}
+
+GLuint GLDevice::BoundBuffer(GLenum glTarget) const
+{
+    int index = buffer_target_index(glTarget);
+    if ( index >= 0 && stateCache.boundBuffer[index] >= 0 ) {
+        return stateCache.boundBuffer[index];
+    }
+
+    // binding is unknown, e.g. after ResetStateCache, query it so it can be restored
+    GLint  glBuffer = 0;
+    GLenum binding  = buffer_target_binding(glTarget);
+    if (binding) {
+        glGetIntegerv(binding, &glBuffer);
+    }
+
+    if (index >= 0) {
+        stateCache.boundBuffer[index] = glBuffer;
+    }
+
+    return glBuffer;
+}
+
+void GLDevice::ReleaseBuffer(GLuint glBuffer)
+{
+    // deleted buffer is unbound from all targets by GL
+    for (int i = 0; i < __NUMBER_OF_BUFFER_TARGETS__; ++i)
+    {
+        if ( stateCache.boundBuffer[i] == GLint(glBuffer) ) {
+            stateCache.boundBuffer[i] = 0;
+        }
+    }
+
+#ifndef SIMPLE_GL_ES
+    for (unsigned i = 0; i < NUM_CACHED_UNIFORM_BUFFER_BINDINGS; ++i)
+    {
+        GLint* binding = stateCache.uniformBufferBinding[i];
+        if ( binding[0] == GLint(glBuffer) )
+        {
+            binding[0] = 0;
+            binding[1] = 0;
+            binding[2] = 0;
+        }
+    }
+#endif
+
+    if (vertexArrayObjects) 
+    {
+        DeleteVertexArrays(0, glBuffer);
+        if (vertexArrayDesc.vertexBuffer == glBuffer) {
+            vertexArrayDesc.vertexBuffer = 0;
+        }
+        if (vertexArrayDesc.indexBuffer == glBuffer) {
+            vertexArrayDesc.indexBuffer = 0;
+        }
+    }
+}
+
+#ifndef SIMPLE_GL_ES
+void GLDevice::BindUniformBuffer(GLuint bindingPoint, GLuint glBuffer, unsigned offset, unsigned size)
+{
+    if (bindingPoint < NUM_CACHED_UNIFORM_BUFFER_BINDINGS)
+    {
+        GLint* binding = stateCache.uniformBufferBinding[bindingPoint];
+        if ( binding[0] == GLint(glBuffer) && binding[1] == GLint(offset) && binding[2] == GLint(size) ) {
+            return;
+        }
+
+        binding[0] = glBuffer;
+        binding[1] = offset;
+        binding[2] = size;
+    }
+
+    if (size == 0) {
+        glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, glBuffer);
+    }
+    else {
+        glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, glBuffer, offset, size);
+    }
+
+    // indexed binding also replaces generic binding
+    stateCache.boundBuffer[UNIFORM_BUFFER] = glBuffer;
+}
+
+GLuint GLDevice::BoundUniformBuffer(GLuint bindingPoint) const
+{
+    if ( bindingPoint >= NUM_CACHED_UNIFORM_BUFFER_BINDINGS || stateCache.uniformBufferBinding[bindingPoint][0] < 0 ) {
+        return 0;
+    }
+
+    return stateCache.uniformBufferBinding[bindingPoint][0];
+}
+#endif // !defined(SIMPLE_GL_ES)
+
+bool GLDevice::FrameCompleted(unsigned frame) const
+{
+    if (frame < numCompletedFrames) {
+        return true;
+    }
+
+#ifndef SIMPLE_GL_ES
+    if (frameFencing && frame < frameIndex)
+    {
+        // fences of the older frames are recycled, check the oldest one available
+        frame = std::max(frame, frameIndex - std::min(frameIndex, NUM_FRAME_FENCES));
+
+        GLsync fence = static_cast<GLsync>(frameFences[frame % NUM_FRAME_FENCES]);
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+        {
+            numCompletedFrames = frame + 1;
+            return true;
+        }
+    }
+#endif
+
+    return false;
+}
+
+void GLDevice::SetVertexArrayLayout(const VertexLayout* vertexLayout)
+{
+    vertexArrayDesc.vertexLayout = vertexLayout;
+    vertexArrayDesc.vertexBuffer = vertexLayout ? BoundBuffer(GL_ARRAY_BUFFER) : 0;
+    vertexArrayDirty             = true;
+}
+
+void GLDevice::SetVertexArrayIndexBuffer(GLuint glBuffer)
+{
+    vertexArrayDesc.indexBuffer = glBuffer;
+    vertexArrayDirty            = true;
+}
+
+void GLDevice::ReleaseVertexArrays(const VertexLayout* vertexLayout)
+{
+    DeleteVertexArrays(vertexLayout, 0);
+    if (vertexArrayDesc.vertexLayout == vertexLayout) {
+        SetVertexArrayLayout(0);
+    }
+}
+
+void GLDevice::DeleteVertexArrays(const VertexLayout* vertexLayout, GLuint glBuffer)
+{
+#ifndef SIMPLE_GL_ES
+    vertex_array_map::iterator iter = vertexArrays.begin();
+    while ( iter != vertexArrays.end() )
+    {
+        const VERTEX_ARRAY_DESC& desc = iter->first;
+        if ( desc.vertexLayout == vertexLayout 
+             || ( glBuffer != 0 && (desc.vertexBuffer == glBuffer || desc.indexBuffer == glBuffer) ) )
+        {
+            // GL reverts to the default vertex array if bound one is deleted,
+            // element array binding of the default vertex array is unknown
+            if (iter->second == boundVertexArray) 
+            {
+                boundVertexArray = 0;
+                vertexArrayDirty = true;
+                stateCache.boundBuffer[ELEMENT_ARRAY_BUFFER] = -1;
+            }
+
+            glDeleteVertexArrays(1, &iter->second);
+            vertexArrays.erase(iter++);
+        }
+        else {
+            ++iter;
+        }
+    }
+#endif
+}
+
+void GLDevice::BindVertexArray() const
+{
+#ifndef SIMPLE_GL_ES
+    GLuint glVertexArray = 0;
+    if (vertexArrayDesc.vertexLayout)
+    {
+        vertex_array_map::iterator iter = vertexArrays.find(vertexArrayDesc);
+        if ( iter == vertexArrays.end() )
+        {
+            // capture layout and buffers into the new vertex array object
+            glGenVertexArrays(1, &glVertexArray);
+            glBindVertexArray(glVertexArray);
+
+            GLint& arrayBuffer = stateCache.boundBuffer[ARRAY_BUFFER];
+            if ( arrayBuffer != GLint(vertexArrayDesc.vertexBuffer) ) 
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, vertexArrayDesc.vertexBuffer);
+                arrayBuffer = vertexArrayDesc.vertexBuffer;
+            }
+            static_cast<const GLVertexLayoutAttribute*>(vertexArrayDesc.vertexLayout)->SetupAttributes();
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vertexArrayDesc.indexBuffer);
+
+            vertexArrays.insert( vertex_array_map::value_type(vertexArrayDesc, glVertexArray) );
+        }
+        else 
+        {
+            glVertexArray = iter->second;
+            if (glVertexArray != boundVertexArray) {
+                glBindVertexArray(glVertexArray);
+            }
+        }
+
+        // element array binding is a part of the vertex array state
+        stateCache.boundBuffer[ELEMENT_ARRAY_BUFFER] = vertexArrayDesc.indexBuffer;
+    }
+    else 
+    {
+        glBindVertexArray(0);
+        stateCache.boundBuffer[ELEMENT_ARRAY_BUFFER] = -1;
+    }
+
+    boundVertexArray = glVertexArray;
+    vertexArrayDirty = false;
+#endif
+}
+
 rectangle GLDevice::Viewport() const
 {
     return viewport;
@@ -526,25 +1129,102 @@ void GLDevice::SetProgram(const Program* program)
     currentProgram = program;
 }
 
-void GLDevice::SetRenderTarget(const RenderTarget* renderTarget)
+unsigned GLDevice::ProcessCompilation(unsigned maxBlockingLinks)
 {
-    currentRenderTarget = renderTarget;
+    // completed programs remove themselves from the list
+    std::vector<GLProgram*> programs(linkingPrograms);
+    for (size_t i = 0; i<programs.size(); ++i)
+    {
+        if ( programs[i]->LinkCompleted() ) {
+            programs[i]->FinishLink();
+        }
+        else if (maxBlockingLinks > 0)
+        {
+            programs[i]->FinishLink();
+            --maxBlockingLinks;
+        }
+    }
+
+    return linkingPrograms.size();
+}
+
+void GLDevice::AddLinkingProgram(GLProgram* program)
+{
+    linkingPrograms.push_back(program);
+}
+
+void GLDevice::RemoveLinkingProgram(GLProgram* program)
+{
+    std::vector<GLProgram*>::iterator iter = std::find(linkingPrograms.begin(), linkingPrograms.end(), program);
+    if ( iter != linkingPrograms.end() ) {
+        linkingPrograms.erase(iter);
+    }
+}
+
+void GLDevice::FlushUniforms() const
+{
+    if (dirtyUniformsProgram)
+    {
+        dirtyUniformsProgram->FlushUniforms();
+        dirtyUniformsProgram = 0;
+    }
+}
+
+void GLDevice::SetRenderTarget(const RenderTarget* renderTarget)
+{
+    currentRenderTarget = renderTarget;
 }
 
 // ============================ DRAW ============================ //
 
+#ifdef SIMPLE_GL_FRAME_STATISTICS
+namespace {
+
+    unsigned long long num_primitives(PRIMITIVE_TYPE primType, unsigned numVertices)
+    {
+        switch (primType)
+        {
+            case POINTS:            return numVertices;
+            case LINES:             return numVertices / 2;
+            case LINE_STRIP:        return numVertices > 1 ? numVertices - 1 : 0;
+            case LINE_LOOP:         return numVertices > 1 ? numVertices : 0;
+            case TRIANGLES:         return numVertices / 3;
+            case TRIANGLE_STRIP:
+            case TRIANGLE_FAN:      return numVertices > 2 ? numVertices - 2 : 0;
+            default:                return 0;
+        }
+    }
+
+    unsigned long long num_primitives(PRIMITIVE_TYPE primType, const unsigned* numVertices, unsigned numDraws)
+    {
+        unsigned long long numPrimitives = 0;
+        for (unsigned i = 0; i<numDraws; ++i) {
+            numPrimitives += num_primitives(primType, numVertices[i]);
+        }
+        return numPrimitives;
+    }
+
+} // anonymous namespace
+#endif // SIMPLE_GL_FRAME_STATISTICS
+
 void GLDevice::Draw( PRIMITIVE_TYPE primType,
                      unsigned       firstVertex,
                      unsigned       numVertices ) const
 {
+    PrepareDraw();
     glDrawArrays(BIND_PRIMITIVE_TYPE[primType], firstVertex, numVertices);
+    SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+    SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, numVertices));
 }
 
 void GLDevice::DrawIndexed( PRIMITIVE_TYPE primType,
                             unsigned       firstIndex,
                             unsigned       numIndices ) const
 {
+    PrepareDraw();
     glDrawElements(BIND_PRIMITIVE_TYPE[primType], numIndices, glIndexType, (GLvoid*)(firstIndex * glIndexSize));
+    SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+    SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, numIndices));
 }
 
 #ifndef SIMPLE_GL_ES
@@ -553,7 +1233,10 @@ void GLDevice::DrawInstanced( PRIMITIVE_TYPE primType,
                               unsigned       numVertices,
                               unsigned       numInstances ) const
 {
+    PrepareDraw();
     glDrawArraysInstanced(BIND_PRIMITIVE_TYPE[primType], firstVertex, numVertices, numInstances);
+    SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+    SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, numVertices) * numInstances);
 }
 
 void GLDevice::DrawIndexedInstanced( PRIMITIVE_TYPE primType,
@@ -561,10 +1244,308 @@ void GLDevice::DrawIndexedInstanced( PRIMITIVE_TYPE primType,
                                      unsigned       numIndices,
                                      unsigned       numInstances ) const
 {
+    PrepareDraw();
     glDrawElementsInstanced(BIND_PRIMITIVE_TYPE[primType], numIndices, glIndexType, (GLvoid*)(firstIndex * glIndexSize), numInstances);
+    SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+    SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, numIndices) * numInstances);
 }
 #endif // defined(SIMPLE_GL_ES)
 
+void GLDevice::MultiDraw( PRIMITIVE_TYPE   primType,
+                          const unsigned*  firstVertices,
+                          const unsigned*  numVertices,
+                          unsigned         numDraws ) const
+{
+    PrepareDraw();
+    SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, numVertices, numDraws));
+#ifndef SIMPLE_GL_ES
+    if (multiDraw)
+    {
+        glMultiDrawArrays( BIND_PRIMITIVE_TYPE[primType], 
+                           reinterpret_cast<GLint*>( const_cast<unsigned*>(firstVertices) ), 
+                           reinterpret_cast<GLsizei*>( const_cast<unsigned*>(numVertices) ), 
+                           numDraws );
+        SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+        return;
+    }
+#endif
+
+    for (unsigned i = 0; i<numDraws; ++i) {
+        glDrawArrays(BIND_PRIMITIVE_TYPE[primType], firstVertices[i], numVertices[i]);
+    }
+    SGL_FRAME_STATISTICS(this, numDrawCalls, numDraws);
+}
+
+void GLDevice::MultiDrawIndexed( PRIMITIVE_TYPE   primType,
+                                 const unsigned*  firstIndices,
+                                 const unsigned*  numIndices,
+                                 unsigned         numDraws ) const
+{
+    PrepareDraw();
+    SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, numIndices, numDraws));
+#ifndef SIMPLE_GL_ES
+    if (multiDraw && numDraws > 0)
+    {
+        multiDrawOffsets.resize(numDraws);
+        for (unsigned i = 0; i<numDraws; ++i) {
+            multiDrawOffsets[i] = (GLvoid*)(firstIndices[i] * glIndexSize);
+        }
+
+        glMultiDrawElements( BIND_PRIMITIVE_TYPE[primType], 
+                             reinterpret_cast<GLsizei*>( const_cast<unsigned*>(numIndices) ), 
+                             glIndexType, 
+                             const_cast<const GLvoid**>(&multiDrawOffsets[0]), 
+                             numDraws );
+        SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+        return;
+    }
+#endif
+
+    for (unsigned i = 0; i<numDraws; ++i) {
+        glDrawElements(BIND_PRIMITIVE_TYPE[primType], numIndices[i], glIndexType, (GLvoid*)(firstIndices[i] * glIndexSize));
+    }
+    SGL_FRAME_STATISTICS(this, numDrawCalls, numDraws);
+}
+
+#ifndef SIMPLE_GL_ES
+void GLDevice::DrawIndexedBaseVertex( PRIMITIVE_TYPE primType,
+                                      unsigned       firstIndex,
+                                      unsigned       numIndices,
+                                      int            baseVertex_ ) const
+{
+    if (baseVertex_ == 0) 
+    {
+        DrawIndexed(primType, firstIndex, numIndices);
+        return;
+    }
+
+    if (!baseVertex) 
+    {
+    #ifndef SGL_NO_STATUS_CHECK
+        sglSetError(SGLERR_UNSUPPORTED, "GLDevice::DrawIndexedBaseVertex failed. Base vertex is not supported.");
+    #endif
+        return;
+    }
+
+    PrepareDraw();
+    glDrawElementsBaseVertex(BIND_PRIMITIVE_TYPE[primType], numIndices, glIndexType, (GLvoid*)(firstIndex * glIndexSize), baseVertex_);
+    SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+    SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, numIndices));
+}
+
+void GLDevice::MultiDrawIndexedBaseVertex( PRIMITIVE_TYPE   primType,
+                                           const unsigned*  firstIndices,
+                                           const unsigned*  numIndices,
+                                           const int*       baseVertices,
+                                           unsigned         numDraws ) const
+{
+    if (baseVertex && multiDraw && numDraws > 0)
+    {
+        PrepareDraw();
+
+        multiDrawOffsets.resize(numDraws);
+        for (unsigned i = 0; i<numDraws; ++i) {
+            multiDrawOffsets[i] = (GLvoid*)(firstIndices[i] * glIndexSize);
+        }
+
+        glMultiDrawElementsBaseVertex( BIND_PRIMITIVE_TYPE[primType], 
+                                       reinterpret_cast<GLsizei*>( const_cast<unsigned*>(numIndices) ), 
+                                       glIndexType, 
+                                       &multiDrawOffsets[0], 
+                                       numDraws,
+                                       const_cast<GLint*>(baseVertices) );
+        SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+        SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, numIndices, numDraws));
+        return;
+    }
+
+    for (unsigned i = 0; i<numDraws; ++i) {
+        DrawIndexedBaseVertex(primType, firstIndices[i], numIndices[i], baseVertices[i]);
+    }
+}
+
+bool GLDevice::ReadIndirectCommands( const Buffer*  buffer,
+                                     unsigned       offset,
+                                     unsigned       numDraws,
+                                     unsigned       stride,
+                                     unsigned       commandSize ) const
+{
+    if (numDraws == 0) {
+        return false;
+    }
+
+    unsigned dataSize = (numDraws - 1) * stride + commandSize;
+#ifndef SGL_NO_STATUS_CHECK
+    if (!buffer || offset + dataSize > buffer->Size()) 
+    {
+        sglSetError(SGLERR_INVALID_CALL, "GLDevice::DrawIndirect failed. Commands are out of the buffer range.");
+        return false;
+    }
+#endif
+
+    indirectCommands.resize(dataSize);
+    return buffer->GetData(&indirectCommands[0], offset, dataSize) == SGL_OK;
+}
+
+void GLDevice::DrawIndirect( PRIMITIVE_TYPE primType,
+                             const Buffer*  buffer,
+                             unsigned       offset ) const
+{
+    MultiDrawIndirect(primType, buffer, offset, 1, 0);
+}
+
+void GLDevice::DrawIndexedIndirect( PRIMITIVE_TYPE primType,
+                                    const Buffer*  buffer,
+                                    unsigned       offset ) const
+{
+    MultiDrawIndexedIndirect(primType, buffer, offset, 1, 0);
+}
+
+void GLDevice::MultiDrawIndirect( PRIMITIVE_TYPE primType,
+                                  const Buffer*  buffer,
+                                  unsigned       offset,
+                                  unsigned       numDraws,
+                                  unsigned       stride ) const
+{
+    if (stride == 0) {
+        stride = sizeof(DRAW_INDIRECT_COMMAND);
+    }
+
+#ifdef GL_ARB_draw_indirect
+    if (drawIndirect)
+    {
+        PrepareDraw();
+        glBindBuffer( GL_DRAW_INDIRECT_BUFFER, BufferHandle(buffer) );
+    #ifdef GL_ARB_multi_draw_indirect
+        if (multiDrawIndirect)
+        {
+            glMultiDrawArraysIndirect(BIND_PRIMITIVE_TYPE[primType], (GLvoid*)offset, numDraws, stride);
+            SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+            return;
+        }
+    #endif
+        for (unsigned i = 0; i<numDraws; ++i) {
+            glDrawArraysIndirect(BIND_PRIMITIVE_TYPE[primType], (GLvoid*)(offset + i * stride));
+        }
+        SGL_FRAME_STATISTICS(this, numDrawCalls, numDraws);
+        return;
+    }
+#endif
+
+    // emulate using readback
+    if ( !ReadIndirectCommands(buffer, offset, numDraws, stride, sizeof(DRAW_INDIRECT_COMMAND)) ) {
+        return;
+    }
+
+    PrepareDraw();
+    for (unsigned i = 0; i<numDraws; ++i)
+    {
+        DRAW_INDIRECT_COMMAND command;
+        memcpy( &command, &indirectCommands[i * stride], sizeof(DRAW_INDIRECT_COMMAND) );
+        assert(command.baseInstance == 0 && "Base instance can't be emulated");
+
+        // emulation serves devices without instancing, so single instance uses plain draw
+        SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, command.numVertices) * command.numInstances);
+        if (command.numInstances == 1) {
+            glDrawArrays(BIND_PRIMITIVE_TYPE[primType], command.firstVertex, command.numVertices);
+        }
+        else if (instancing) {
+            glDrawArraysInstanced(BIND_PRIMITIVE_TYPE[primType], command.firstVertex, command.numVertices, command.numInstances);
+        }
+    #ifndef SGL_NO_STATUS_CHECK
+        else if (command.numInstances > 1) {
+            sglSetError(SGLERR_UNSUPPORTED, "GLDevice::MultiDrawIndirect failed. Instancing is not supported.");
+        }
+    #endif
+    }
+    SGL_FRAME_STATISTICS(this, numDrawCalls, numDraws);
+}
+
+void GLDevice::MultiDrawIndexedIndirect( PRIMITIVE_TYPE primType,
+                                         const Buffer*  buffer,
+                                         unsigned       offset,
+                                         unsigned       numDraws,
+                                         unsigned       stride ) const
+{
+    if (stride == 0) {
+        stride = sizeof(DRAW_INDEXED_INDIRECT_COMMAND);
+    }
+
+#ifdef GL_ARB_draw_indirect
+    if (drawIndirect)
+    {
+        PrepareDraw();
+        glBindBuffer( GL_DRAW_INDIRECT_BUFFER, BufferHandle(buffer) );
+    #ifdef GL_ARB_multi_draw_indirect
+        if (multiDrawIndirect)
+        {
+            glMultiDrawElementsIndirect(BIND_PRIMITIVE_TYPE[primType], glIndexType, (GLvoid*)offset, numDraws, stride);
+            SGL_FRAME_STATISTICS(this, numDrawCalls, 1);
+            return;
+        }
+    #endif
+        for (unsigned i = 0; i<numDraws; ++i) {
+            glDrawElementsIndirect(BIND_PRIMITIVE_TYPE[primType], glIndexType, (GLvoid*)(offset + i * stride));
+        }
+        SGL_FRAME_STATISTICS(this, numDrawCalls, numDraws);
+        return;
+    }
+#endif
+
+    // emulate using readback
+    if ( !ReadIndirectCommands(buffer, offset, numDraws, stride, sizeof(DRAW_INDEXED_INDIRECT_COMMAND)) ) {
+        return;
+    }
+
+    PrepareDraw();
+    for (unsigned i = 0; i<numDraws; ++i)
+    {
+        DRAW_INDEXED_INDIRECT_COMMAND command;
+        memcpy( &command, &indirectCommands[i * stride], sizeof(DRAW_INDEXED_INDIRECT_COMMAND) );
+        assert(command.baseInstance == 0 && "Base instance can't be emulated");
+
+        GLvoid* indices = (GLvoid*)(command.firstIndex * glIndexSize);
+        SGL_FRAME_STATISTICS(this, numPrimitives, num_primitives(primType, command.numIndices) * command.numInstances);
+        if (command.numInstances == 0) {
+            continue;
+        }
+
+        if (command.baseVertex != 0 && !baseVertex)
+        {
+        #ifndef SGL_NO_STATUS_CHECK
+            sglSetError(SGLERR_UNSUPPORTED, "GLDevice::MultiDrawIndexedIndirect failed. Base vertex is not supported.");
+        #endif
+            continue;
+        }
+
+        if (command.numInstances == 1)
+        {
+            if (command.baseVertex == 0) {
+                glDrawElements(BIND_PRIMITIVE_TYPE[primType], command.numIndices, glIndexType, indices);
+            }
+            else {
+                glDrawElementsBaseVertex(BIND_PRIMITIVE_TYPE[primType], command.numIndices, glIndexType, indices, command.baseVertex);
+            }
+        }
+        else if (instancing)
+        {
+            if (command.baseVertex == 0) {
+                glDrawElementsInstanced(BIND_PRIMITIVE_TYPE[primType], command.numIndices, glIndexType, indices, command.numInstances);
+            }
+            else {
+                glDrawElementsInstancedBaseVertex(BIND_PRIMITIVE_TYPE[primType], command.numIndices, glIndexType, indices, command.numInstances, command.baseVertex);
+            }
+        }
+    #ifndef SGL_NO_STATUS_CHECK
+        else {
+            sglSetError(SGLERR_UNSUPPORTED, "GLDevice::MultiDrawIndexedIndirect failed. Instancing is not supported.");
+        }
+    #endif
+    }
+    SGL_FRAME_STATISTICS(this, numDrawCalls, numDraws);
+}
+#endif // !defined(SIMPLE_GL_ES)
+
 void GLDevice::Clear(bool colorBuffer, bool depthBuffer, bool stencilBuffer) const
 {
     GLbitfield mask = (colorBuffer   ? GL_COLOR_BUFFER_BIT   : 0)
@@ -573,17 +1554,61 @@ void GLDevice::Clear(bool colorBuffer, bool depthBuffer, bool stencilBuffer) con
     glClear(mask);
 }
 
+SGL_HRESULT GLDevice::Execute(const CommandList* commandList)
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if (!commandList) {
+        return EInvalidCall("GLDevice::Execute failed. Command list is NULL.");
+    }
+#endif
+
+    return static_cast<const GLCommandList*>(commandList)->Execute();
+}
+
 #ifndef __ANDROID__
 void GLDevice::SwapBuffers() const
 {
 #ifdef WIN32
     ::SwapBuffers(hDC);
 #elif defined(__linux__) && !defined(__ANDROID__)
+#   ifdef SIMPLE_GL_USE_EGL
+    if (eglDisplay != EGL_NO_DISPLAY) 
+    {
+        // surfaceless context has nothing to swap, just submit commands
+        if (eglSurface != EGL_NO_SURFACE) {
+            eglSwapBuffers(eglDisplay, eglSurface);
+        }
+        else {
+            glFlush();
+        }
+    }
+    else
+#   endif
     glXSwapBuffers(display, glxDrawable);
 #endif
+    FinishFrameStatistics();
+
+#ifndef SIMPLE_GL_ES
+    if (frameFencing)
+    {
+        void*& fence = frameFences[frameIndex % NUM_FRAME_FENCES];
+        if (fence) {
+            glDeleteSync( static_cast<GLsync>(fence) );
+        }
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#endif
+    ++frameIndex;
+
+#ifndef SGL_NO_STATUS_CHECK
+    // errors were passed to the debug output callback, drop error flag once per frame
+    if (validationMode == VALIDATION_DEBUG_OUTPUT) {
+        glGetError();
+    }
+#endif
 
 #if defined(DEBUG) && !defined(SGL_NO_STATUS_CHECK)
-    GLenum error = glGetError();
+    GLenum error = PollError();
     switch (error)
     {
     case GL_INVALID_ENUM:
@@ -607,6 +1632,20 @@ void GLDevice::SwapBuffers() const
 }
 #endif // !defined(__ANDROID__)
 
+SGL_HRESULT GLDevice::SetValidationMode(VALIDATION_MODE mode)
+{
+    if ( mode == VALIDATION_DEBUG_OUTPUT && !debug_output_supported() ) {
+        return EUnsupported("GLDevice::SetValidationMode failed. Debug output is not supported.");
+    }
+
+    if ( (mode == VALIDATION_DEBUG_OUTPUT) != (validationMode == VALIDATION_DEBUG_OUTPUT) ) {
+        enable_debug_output(mode == VALIDATION_DEBUG_OUTPUT);
+    }
+    validationMode = mode;
+
+    return SGL_OK;
+}
+
 void SGL_DLLCALL GLDevice::PushState(State::TYPE type)
 {
     switch (type)
@@ -686,78 +1725,336 @@ SGL_HRESULT SGL_DLLCALL GLDevice::PopState(State::TYPE type)
 
 // ============================ OTHER ============================ //
 
-void GLDevice::SetClearColor(const math::Vector4f& color)
-{
-    glClearColor(color.x, color.y, color.z, color.w);
+void GLDevice::SetClearColor(const math::Vector4f& color)
+{
+    glClearColor(color.x, color.y, color.z, color.w);
+}
+
+void GLDevice::SetClearDepthStencil(double depthClear, int stencilClear)
+{
+#ifdef SIMPLE_GL_ES
+    glClearDepthf(depthClear);
+#else
+    glClearDepth(depthClear);
+#endif
+    glClearStencil(stencilClear);
+}
+
+math::Vector4f GLDevice::ClearColor() const
+{
+    math::Vector4f color;
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, &color[0]);
+    SGL_FRAME_STATISTICS(this, numGetQueries, 1);
+    return color;
+}
+
+double GLDevice::ClearDepth() const
+{
+    double depth;
+#ifdef SIMPLE_GL_ES
+    float depthF;
+    glGetFloatv(GL_DEPTH_CLEAR_VALUE, &depthF);
+    depth = depthF;
+#else
+    glGetDoublev(GL_DEPTH_CLEAR_VALUE, &depth);
+#endif
+    SGL_FRAME_STATISTICS(this, numGetQueries, 1);
+    return depth;
+}
+
+int GLDevice::ClearStencil() const
+{
+    int stencil;
+    glGetIntegerv(GL_STENCIL_CLEAR_VALUE, &stencil);
+    SGL_FRAME_STATISTICS(this, numGetQueries, 1);
+    return stencil;
+}
+
+ReadbackRequest* GLDevice::Readback(const rectangle& rect, Texture::FORMAT format) const
+{
+#ifdef SIMPLE_GL_ES
+    sglSetError(SGLERR_UNSUPPORTED, "GLDevice::Readback failed. Not supported in GLES.");
+    return 0;
+#else
+    return GLReadbackRequest::ReadPixels(const_cast<GLDevice*>(this), rect, format);
+#endif
+}
+
+SGL_HRESULT GLDevice::CopyTexture2D( Texture2D*     texture,
+                                     unsigned       level,
+                                     unsigned       offsetx,
+                                     unsigned       offsety,
+                                     unsigned       width,
+                                     unsigned       height ) const
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if (!texture) {
+        return EInvalidCall("GLDevice::CopyTexture2D failed. Texture is NULL.");
+    }
+#endif
+
+    typedef GLTexture2D::guarded_binding     guarded_binding;
+    typedef GLTexture2D::guarded_binding_ptr guarded_binding_ptr;
+
+    GLTexture2D*		glTexture = static_cast<GLTexture2D*>(texture);
+    guarded_binding_ptr texBinding( new guarded_binding(this, glTexture, 0) );
+    {
+        glCopyTexSubImage2D(glTexture->Target(), level, offsetx, offsety, 0, 0, width, height);
+
+    #ifndef SGL_NO_STATUS_CHECK
+        GLenum error = PollError();
+        if ( error != GL_NO_ERROR ) {
+            return CheckGLError("GLDevice::CopyTexture2D failed: ", error);
+        }
+    #endif
+    }
+
+    return SGL_OK;
+}
+
+SGL_HRESULT GLDevice::CopyBuffer( Buffer*         target,
+                                  unsigned        targetOffset,
+                                  const Buffer*   source,
+                                  unsigned        sourceOffset,
+                                  unsigned        size )
+{
+#ifdef SIMPLE_GL_ES
+    return EUnsupported("GLDevice::CopyBuffer failed. Not supported in GLES.");
+#else
+#ifndef SGL_NO_STATUS_CHECK
+    if (!target || !source) {
+        return EInvalidCall("GLDevice::CopyBuffer failed. Buffer is NULL.");
+    }
+
+    if ( sourceOffset + size > source->Size() || targetOffset + size > target->Size() ) {
+        return EInvalidCall("GLDevice::CopyBuffer failed. Range is out of the buffer.");
+    }
+
+    if ( target == source && sourceOffset < targetOffset + size && targetOffset < sourceOffset + size ) {
+        return EInvalidCall("GLDevice::CopyBuffer failed. Source and target ranges overlap.");
+    }
+
+    if ( target->Mapped() || source->Mapped() ) {
+        return EInvalidCall("GLDevice::CopyBuffer failed. Buffer is mapped.");
+    }
+#endif
+
+    if (size == 0) {
+        return SGL_OK;
+    }
+
+    if (bufferCopies)
+    {
+        // copy targets are not used for rendering, so previous bindings are not restored
+        BindBuffer( GL_COPY_READ_BUFFER, BufferHandle(source) );
+        BindBuffer( GL_COPY_WRITE_BUFFER, BufferHandle(target) );
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset, targetOffset, size);
+
+    #ifndef SGL_NO_STATUS_CHECK
+        return CheckGLError("GLDevice::CopyBuffer failed: ", PollError());
+    #else
+        return SGL_OK;
+    #endif
+    }
+
+    // device can't copy buffers, pass the range through the client memory
+    transferData.resize(size);
+    SGL_HRESULT result = source->GetData(&transferData[0], sourceOffset, size);
+    if (result != SGL_OK) {
+        return result;
+    }
+
+    return target->SetSubData(targetOffset, size, &transferData[0]);
+#endif
 }
 
-void GLDevice::SetClearDepthStencil(double depthClear, int stencilClear)
+SGL_HRESULT GLDevice::CopyBufferToTexture2D( Texture2D*      target,
+                                             unsigned        mipmap,
+                                             unsigned        offsetx,
+                                             unsigned        offsety,
+                                             unsigned        width,
+                                             unsigned        height,
+                                             const Buffer*   source,
+                                             unsigned        sourceOffset )
 {
 #ifdef SIMPLE_GL_ES
-    glClearDepthf(depthClear);
+    return EUnsupported("GLDevice::CopyBufferToTexture2D failed. Not supported in GLES.");
 #else
-    glClearDepth(depthClear);
+    unsigned dataSize = target ? Image::SizeOfData(target->Format(), width, height, 1) : 0;
+
+#ifndef SGL_NO_STATUS_CHECK
+    if (!target || !source) {
+        return EInvalidCall("GLDevice::CopyBufferToTexture2D failed. Texture or buffer is NULL.");
+    }
+
+    if ( sourceOffset + dataSize > source->Size() ) {
+        return EInvalidCall("GLDevice::CopyBufferToTexture2D failed. Pixels are out of the buffer.");
+    }
+
+    if ( source->Mapped() ) {
+        return EInvalidCall("GLDevice::CopyBufferToTexture2D failed. Buffer is mapped.");
+    }
 #endif
-    glClearStencil(stencilClear);
-}
 
-math::Vector4f GLDevice::ClearColor() const
-{
-    math::Vector4f color;
-    glGetFloatv(GL_COLOR_CLEAR_VALUE, &color[0]);
-    return color;
+    if (dataSize == 0) {
+        return SGL_OK;
+    }
+
+    SGL_HRESULT result = SGL_OK;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if ( GLReadbackRequest::Supported() )
+    {
+        // pixel data pointer is treated as offset in the bound unpack buffer
+        guarded_buffer_binding binding( this, GL_PIXEL_UNPACK_BUFFER, BufferHandle(source) );
+        result = target->SetSubImage(mipmap, offsetx, offsety, width, height, (const GLvoid*)(size_t)sourceOffset);
+    }
+    else
+    {
+        // pixel buffer objects are not supported, pass the pixels through the client memory
+        transferData.resize(dataSize);
+        result = source->GetData(&transferData[0], sourceOffset, dataSize);
+        if (result == SGL_OK) {
+            result = target->SetSubImage(mipmap, offsetx, offsety, width, height, &transferData[0]);
+        }
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    return result;
+#endif
 }
 
-double GLDevice::ClearDepth() const
+SGL_HRESULT GLDevice::CopyTexture2DToBuffer( Buffer*         target,
+                                             unsigned        targetOffset,
+                                             Texture2D*      source,
+                                             unsigned        mipmap )
 {
-    double depth;
 #ifdef SIMPLE_GL_ES
-    float depthF;
-    glGetFloatv(GL_DEPTH_CLEAR_VALUE, &depthF);
-    depth = depthF;
+    return EUnsupported("GLDevice::CopyTexture2DToBuffer failed. Not supported in GLES.");
 #else
-    glGetDoublev(GL_DEPTH_CLEAR_VALUE, &depth);
+    unsigned dataSize = 0;
+    if (source)
+    {
+        dataSize = Image::SizeOfData( source->Format(),
+                                      std::max(source->Width() >> mipmap, 1u),
+                                      std::max(source->Height() >> mipmap, 1u),
+                                      1 );
+    }
+
+#ifndef SGL_NO_STATUS_CHECK
+    if (!target || !source) {
+        return EInvalidCall("GLDevice::CopyTexture2DToBuffer failed. Texture or buffer is NULL.");
+    }
+
+    if ( source->Samples() > 0 ) {
+        return EInvalidCall("GLDevice::CopyTexture2DToBuffer failed. Can't copy multisample texture.");
+    }
+
+    if ( targetOffset + dataSize > target->Size() ) {
+        return EInvalidCall("GLDevice::CopyTexture2DToBuffer failed. Pixels don't fit the buffer.");
+    }
+
+    if ( target->Mapped() ) {
+        return EInvalidCall("GLDevice::CopyTexture2DToBuffer failed. Buffer is mapped.");
+    }
 #endif
-    return depth;
-}
 
-int GLDevice::ClearStencil() const
-{
-    int stencil;
-    glGetIntegerv(GL_STENCIL_CLEAR_VALUE, &stencil);
-    return stencil;
+    if (dataSize == 0) {
+        return SGL_OK;
+    }
+
+    SGL_HRESULT result = SGL_OK;
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    if ( GLReadbackRequest::Supported() )
+    {
+        // pixel data pointer is treated as offset in the bound pack buffer
+        guarded_buffer_binding binding( this, GL_PIXEL_PACK_BUFFER, BufferHandle(target) );
+        result = source->GetImage(mipmap, (GLvoid*)(size_t)targetOffset);
+    }
+    else
+    {
+        // pixel buffer objects are not supported, pass the pixels through the client memory
+        transferData.resize(dataSize);
+        result = source->GetImage(mipmap, &transferData[0]);
+        if (result == SGL_OK) {
+            result = target->SetSubData(targetOffset, dataSize, &transferData[0]);
+        }
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    return result;
+#endif
 }
 
-SGL_HRESULT GLDevice::CopyTexture2D( Texture2D*     texture,
-                                     unsigned       level,
-                                     unsigned       offsetx,
-                                     unsigned       offsety,
-                                     unsigned       width,
-                                     unsigned       height ) const
+SGL_HRESULT GLDevice::CopyFramebufferToBuffer( Buffer*            target,
+                                               unsigned           targetOffset,
+                                               const rectangle&   rect,
+                                               Texture::FORMAT    format )
 {
+#ifdef SIMPLE_GL_ES
+    return EUnsupported("GLDevice::CopyFramebufferToBuffer failed. Not supported in GLES.");
+#else
+    unsigned dataSize = Image::SizeOfData(format, rect.width, rect.height, 1);
+
 #ifndef SGL_NO_STATUS_CHECK
-    if (!texture) {
-        return EInvalidCall("GLDevice::CopyTexture2D failed. Texture is NULL.");
+    if (!target) {
+        return EInvalidCall("GLDevice::CopyFramebufferToBuffer failed. Buffer is NULL.");
+    }
+
+    if ( Texture::FORMAT_TRAITS[format].compressed ) {
+        return EInvalidCall("GLDevice::CopyFramebufferToBuffer failed. Can't read pixels in compressed format.");
+    }
+
+    if ( targetOffset + dataSize > target->Size() ) {
+        return EInvalidCall("GLDevice::CopyFramebufferToBuffer failed. Pixels don't fit the buffer.");
+    }
+
+    if ( target->Mapped() ) {
+        return EInvalidCall("GLDevice::CopyFramebufferToBuffer failed. Buffer is mapped.");
     }
 #endif
 
-    typedef GLTexture2D::guarded_binding     guarded_binding;
-    typedef GLTexture2D::guarded_binding_ptr guarded_binding_ptr;
+    if (dataSize == 0) {
+        return SGL_OK;
+    }
 
-    GLTexture2D*		glTexture = static_cast<GLTexture2D*>(texture);
-    guarded_binding_ptr texBinding( new guarded_binding(this, glTexture, 0) );
+    SGL_HRESULT result = SGL_OK;
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    if ( GLReadbackRequest::Supported() )
     {
-        glCopyTexSubImage2D(glTexture->Target(), level, offsetx, offsety, 0, 0, width, height);
-
+        guarded_buffer_binding binding( this, GL_PIXEL_PACK_BUFFER, BufferHandle(target) );
+        glReadPixels( rect.x,
+                      rect.y,
+                      rect.width,
+                      rect.height,
+                      BIND_GL_FORMAT_USAGE[format],
+                      BIND_GL_FORMAT_PIXEL_TYPE[format],
+                      (GLvoid*)(size_t)targetOffset );
     #ifndef SGL_NO_STATUS_CHECK
-        GLenum error = glGetError();
-        if ( error != GL_NO_ERROR ) {
-            return CheckGLError("GLDevice::CopyTexture2D failed: ", error);
-        }
+        result = CheckGLError("GLDevice::CopyFramebufferToBuffer failed: ", PollError());
+    #endif
+    }
+    else
+    {
+        // pixel buffer objects are not supported, pass the pixels through the client memory
+        transferData.resize(dataSize);
+        glReadPixels( rect.x,
+                      rect.y,
+                      rect.width,
+                      rect.height,
+                      BIND_GL_FORMAT_USAGE[format],
+                      BIND_GL_FORMAT_PIXEL_TYPE[format],
+                      &transferData[0] );
+    #ifndef SGL_NO_STATUS_CHECK
+        result = CheckGLError("GLDevice::CopyFramebufferToBuffer failed: ", PollError());
     #endif
+        if (result == SGL_OK) {
+            result = target->SetSubData(targetOffset, dataSize, &transferData[0]);
+        }
     }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
 
-    return SGL_OK;
+    return result;
+#endif
 }
 
 /*
@@ -780,11 +2077,81 @@ namespace {
     template<bool toggle> struct support_display_lists          { static const bool value = toggle; };
     template<bool toggle> struct support_render_target          { static const bool value = toggle; };
     template<bool toggle> struct support_buffer_copies          { static const bool value = toggle; };
+    template<bool toggle> struct support_multi_draw             { static const bool value = toggle; };
+    template<bool toggle> struct support_base_vertex            { static const bool value = toggle; };
+    template<bool toggle> struct support_draw_indirect          { static const bool value = toggle; };
 
     #define SUPPORT(Feature, DeviceVersion) support_##Feature<device_traits<DeviceVersion>::support_##Feature>()
+
+    bool UseVertexArrayObjects(support_fixed_attributes<true>)
+    {
+        // fixed attributes are set through client state, keep default vertex array
+        return false;
+    }
+
+    bool UseVertexArrayObjects(support_fixed_attributes<false>)
+    {
+    #ifdef SIMPLE_GL_ES
+        return false;
+    #else
+        return GLEW_VERSION_3_0 || GLEW_ARB_vertex_array_object;
+    #endif
+    }
+
+    bool UseMultiDraw(support_multi_draw<true>)     { return true; }
+    bool UseMultiDraw(support_multi_draw<false>)    { return false; }
+
+    bool UseBaseVertex(support_base_vertex<true>)   { return true; }
+    bool UseBaseVertex(support_base_vertex<false>)
+    {
+    #ifdef SIMPLE_GL_ES
+        return false;
+    #else
+        return GLEW_ARB_draw_elements_base_vertex == GL_TRUE;
+    #endif
+    }
+
+    bool UseInstancing()
+    {
+    #ifdef SIMPLE_GL_ES
+        return false;
+    #else
+        return GLEW_VERSION_3_1 || GLEW_ARB_draw_instanced;
+    #endif
+    }
+
+    bool UseDrawIndirect(support_draw_indirect<true>)   { return true; }
+    bool UseDrawIndirect(support_draw_indirect<false>)
+    {
+    #ifdef GL_ARB_draw_indirect
+        return GLEW_ARB_draw_indirect == GL_TRUE;
+    #else
+        return false;
+    #endif
+    }
+
+    bool UseBufferCopies(support_buffer_copies<true>)   { return true; }
+    bool UseBufferCopies(support_buffer_copies<false>)
+    {
+    #ifdef SIMPLE_GL_ES
+        return false;
+    #else
+        return GLEW_ARB_copy_buffer == GL_TRUE;
+    #endif
+    }
+
+    bool UseMultiDrawIndirect()
+    {
+    #ifdef GL_ARB_multi_draw_indirect
+        return GLEW_ARB_multi_draw_indirect == GL_TRUE;
+    #else
+        return false;
+    #endif
+    }
 	
     Shader* CreateShader(GLDevice*           /*device*/,
                          const Shader::DESC& /*desc*/,
+                         bool                /*async*/,
                          support_programmable_pipeline<false>)
 	{
         return 0;
@@ -792,9 +2159,10 @@ namespace {
 
     Shader* CreateShader(GLDevice*           device,
                          const Shader::DESC& desc,
+                         bool                async,
                          support_programmable_pipeline<true>)
     {
-		return new GLShader(device, desc);
+		return new GLShader(device, desc, async);
 	}
 
     Program* CreateProgram(GLDevice* /*device*/,
@@ -819,6 +2187,55 @@ namespace {
 		return 0;
 	}
 
+    Query* CreateQuery(GLDevice* device, const Query::DESC& desc)
+    {
+    #ifdef SIMPLE_GL_ES
+        sglSetError(SGLERR_UNSUPPORTED, "Queries are not supported");
+        return 0;
+    #else
+        if ( !GLQuery::SupportsType(desc.type) )
+        {
+            sglSetError(SGLERR_UNSUPPORTED, "Query type is not supported");
+            return 0;
+        }
+
+        return new GLQuery(device, desc);
+    #endif
+    }
+
+    StreamingBuffer* CreateStreamingBuffer(GLDevice* device, Buffer* buffer, const StreamingBuffer::DESC& desc)
+    {
+        if ( BufferHandle(buffer) == 0 )
+        {
+            sglSetError(SGLERR_INVALID_CALL, "Buffer is not created by the device");
+            return 0;
+        }
+
+        if (buffer->UpdatePolicy() != Buffer::UPDATE_IN_PLACE)
+        {
+            sglSetError(SGLERR_INVALID_CALL, "Streaming buffer requires buffer updated in place");
+            return 0;
+        }
+
+        return new GLStreamingBuffer(device, buffer, desc);
+    }
+
+    StreamOut* CreateStreamOut(GLDevice* device)
+    {
+    #ifdef SIMPLE_GL_ES
+        sglSetError(SGLERR_UNSUPPORTED, "Stream output is not supported");
+        return 0;
+    #else
+        if ( !GLStreamOut::Supported() )
+        {
+            sglSetError(SGLERR_UNSUPPORTED, "Stream output is not supported");
+            return 0;
+        }
+
+        return new GLStreamOut(device);
+    #endif
+    }
+
 	sgl::Font* CreateFont(GLDevice* device,
 						  support_programmable_pipeline<true>)
 	{
@@ -873,6 +2290,29 @@ namespace {
     #endif
 	}
 
+	TextureBuffer* CreateTextureBuffer(GLDevice* device, const TextureBuffer::DESC& desc)
+	{
+    #ifdef SIMPLE_GL_ES
+        sglSetError(SGLERR_UNSUPPORTED, "Texture buffers are not supported");
+        return 0;
+    #else
+        if ( !GLTextureBuffer::Supported() )
+        {
+            sglSetError(SGLERR_UNSUPPORTED, "Texture buffers are not supported");
+            return 0;
+        }
+
+        GLTextureBuffer* texture = new GLTextureBuffer(device);
+        if ( desc.buffer && texture->SetBuffer(desc.buffer, desc.format, desc.offset, desc.size) != SGL_OK )
+        {
+            delete texture;
+            return 0;
+        }
+
+        return texture;
+    #endif
+	}
+
 	Texture3D* CreateTexture3D(GLDevice* device, const Texture3D::DESC& desc)
 	{
     #ifdef SIMPLE_GL_ES
@@ -898,11 +2338,59 @@ namespace {
 
 	// ============================ BUFFERS ============================ //
 
+    bool CheckVertexElements(unsigned int numElements, const VertexLayout::ELEMENT* elements)
+    {
+        for (unsigned int i = 0; i<numElements; ++i)
+        {
+            const VertexLayout::ELEMENT& element = elements[i];
+
+            bool packed   = (element.type == INT_2_10_10_10_REV || element.type == UINT_2_10_10_10_REV);
+            bool floating = (element.type == FLOAT || element.type == DOUBLE || element.type == HALF);
+            if (packed && element.size != 4)
+            {
+                sglSetError(SGLERR_INVALID_CALL, "GLDevice::CreateVertexLayout failed. Packed attributes must have 4 components.");
+                return false;
+            }
+
+            if ( element.integer && (packed || floating) )
+            {
+                sglSetError(SGLERR_INVALID_CALL, "GLDevice::CreateVertexLayout failed. Integer attributes must have integer type.");
+                return false;
+            }
+
+#ifdef SIMPLE_GL_ES
+            if ( element.integer || packed || (element.type == HALF && BIND_SCALAR_TYPE[HALF] == 0) )
+            {
+                sglSetError(SGLERR_UNSUPPORTED, "GLDevice::CreateVertexLayout failed. Vertex attribute format is not supported.");
+                return false;
+            }
+#else
+            if (element.integer && !GLEW_VERSION_3_0)
+            {
+                sglSetError(SGLERR_UNSUPPORTED, "GLDevice::CreateVertexLayout failed. Integer attributes are not supported.");
+                return false;
+            }
+
+            if (element.type == HALF && !GLEW_VERSION_3_0 && !GLEW_ARB_half_float_vertex)
+            {
+                sglSetError(SGLERR_UNSUPPORTED, "GLDevice::CreateVertexLayout failed. Half float attributes are not supported.");
+                return false;
+            }
+#endif
+        }
+
+        return true;
+    }
+
 	VertexLayout* CreateVertexLayout(GLDevice*					  device, 
 									 unsigned int                 numElements,
 									 const VertexLayout::ELEMENT* elements,
 									 support_fixed_attributes<true>)
 	{
+        if ( !CheckVertexElements(numElements, elements) ) {
+            return 0;
+        }
+
 		return new GLVertexLayoutMixed(device, numElements, elements);
 	}
 
@@ -911,50 +2399,96 @@ namespace {
 									 const VertexLayout::ELEMENT*	elements,
 									 support_fixed_attributes<false>)
 	{
+        if ( !CheckVertexElements(numElements, elements) ) {
+            return 0;
+        }
+
 		return new GLVertexLayoutAttribute(device, numElements, elements);
 	}
 
 #ifdef SIMPLE_GL_ES
-    VertexBuffer* CreateVertexBuffer(GLDevice* device,
+    VertexBuffer* CreateVertexBuffer(GLDevice*              device,
+                                     Buffer::UPDATE_POLICY  policy,
+                                     unsigned               numBuffers,
                                      support_buffer_copies<false>)
     {
-        return new GLVertexBuffer<GLBufferDefault<VertexBuffer> >(device);
+        GLVertexBuffer<GLBufferDefault<VertexBuffer> >* buffer = new GLVertexBuffer<GLBufferDefault<VertexBuffer> >(device);
+        buffer->SetUpdatePolicy(policy, numBuffers);
+        return buffer;
     }
 
-    IndexBuffer* CreateIndexBuffer(GLDevice* device,
+    IndexBuffer* CreateIndexBuffer(GLDevice*                device,
+                                   Buffer::UPDATE_POLICY    policy,
+                                   unsigned                 numBuffers,
                                    support_buffer_copies<false>)
     {
-        return new GLIndexBuffer<GLBufferDefault<IndexBuffer> >(device);
+        GLIndexBuffer<GLBufferDefault<IndexBuffer> >* buffer = new GLIndexBuffer<GLBufferDefault<IndexBuffer> >(device);
+        buffer->SetUpdatePolicy(policy, numBuffers);
+        return buffer;
     }
 #else // !defined(SIMPLE_GL_ES)
     template<bool BufferCopies>
-	VertexBuffer* CreateVertexBuffer(GLDevice* device,
+	VertexBuffer* CreateVertexBuffer(GLDevice*              device,
+                                     Buffer::UPDATE_POLICY  policy,
+                                     unsigned               numBuffers,
                                      support_buffer_copies<BufferCopies>)
 	{
         typedef typename if_then_else< BufferCopies,
                                        GLBufferModern<VertexBuffer>,
                                        GLBufferDefault<VertexBuffer> >::type buffer_impl;
 
-		return new GLVertexBuffer<buffer_impl>(device);
+		GLVertexBuffer<buffer_impl>* buffer = new GLVertexBuffer<buffer_impl>(device);
+        buffer->SetUpdatePolicy(policy, numBuffers);
+        return buffer;
 	}
 
     template<bool BufferCopies>
-    IndexBuffer* CreateIndexBuffer(GLDevice* device,
+    IndexBuffer* CreateIndexBuffer(GLDevice*                device,
+                                   Buffer::UPDATE_POLICY    policy,
+                                   unsigned                 numBuffers,
                                    support_buffer_copies<BufferCopies>)
 	{
         typedef typename if_then_else< BufferCopies,
                                        GLBufferModern<IndexBuffer>,
                                        GLBufferDefault<IndexBuffer> >::type buffer_impl;
 
-		return new GLIndexBuffer<buffer_impl>(device);
+		GLIndexBuffer<buffer_impl>* buffer = new GLIndexBuffer<buffer_impl>(device);
+        buffer->SetUpdatePolicy(policy, numBuffers);
+        return buffer;
 	}
 #endif // !defined(SIMPLE_GL_ES)
-	/*
-	UniformBufferView* SGL_DLLCALL GLDevice::CreateUniformBuffer()
-	{
-		return new GLUniformBufferView( this, new GLBuffer(this) );
-	}
-	*/
+
+#ifdef SIMPLE_GL_ES
+    UniformBuffer* CreateUniformBuffer(GLDevice*                /*device*/,
+                                       Buffer::UPDATE_POLICY    /*policy*/,
+                                       unsigned                 /*numBuffers*/,
+                                       support_buffer_copies<false>)
+    {
+        sglSetError(SGLERR_UNSUPPORTED, "GLDevice::CreateUniformBuffer failed. Uniform buffers are not supported.");
+        return 0;
+    }
+#else // !defined(SIMPLE_GL_ES)
+    template<bool BufferCopies>
+    UniformBuffer* CreateUniformBuffer(GLDevice*                device,
+                                       Buffer::UPDATE_POLICY    policy,
+                                       unsigned                 numBuffers,
+                                       support_buffer_copies<BufferCopies>)
+    {
+        if ( !GLEW_VERSION_3_1 && !GLEW_ARB_uniform_buffer_object )
+        {
+            sglSetError(SGLERR_UNSUPPORTED, "GLDevice::CreateUniformBuffer failed. Uniform buffers are not supported.");
+            return 0;
+        }
+
+        typedef typename if_then_else< BufferCopies,
+                                       GLBufferModern<UniformBuffer>,
+                                       GLBufferDefault<UniformBuffer> >::type buffer_impl;
+
+        GLUniformBuffer<buffer_impl>* buffer = new GLUniformBuffer<buffer_impl>(device);
+        buffer->SetUpdatePolicy(policy, numBuffers);
+        return buffer;
+    }
+#endif // !defined(SIMPLE_GL_ES)
 	// ============================ STATES ============================ //
 
 #ifndef SIMPLE_GL_ES
@@ -1083,6 +2617,14 @@ GLDeviceConcrete<DeviceVersion>::GLDeviceConcrete()
 
     ffpProgram.reset( CreateFFPProgram( this, SUPPORT(fixed_pipeline, DeviceVersion) ) );
     assert( GL_NO_ERROR == glGetError() );
+
+    vertexArrayObjects = UseVertexArrayObjects( SUPPORT(fixed_attributes, DeviceVersion) );
+    multiDraw          = UseMultiDraw( SUPPORT(multi_draw, DeviceVersion) );
+    baseVertex         = UseBaseVertex( SUPPORT(base_vertex, DeviceVersion) );
+    instancing         = UseInstancing();
+    drawIndirect       = UseDrawIndirect( SUPPORT(draw_indirect, DeviceVersion) );
+    multiDrawIndirect  = drawIndirect && UseMultiDrawIndirect();
+    bufferCopies       = UseBufferCopies( SUPPORT(buffer_copies, DeviceVersion) );
 }
 
 #ifndef __ANDROID__
@@ -1126,6 +2668,14 @@ GLDeviceConcrete<DeviceVersion>::GLDeviceConcrete(const Device::VIDEO_DESC& desc
 
 	ffpProgram.reset( CreateFFPProgram( this, SUPPORT(fixed_pipeline, DeviceVersion) ) );
 	assert( GL_NO_ERROR == glGetError() );
+
+	vertexArrayObjects = UseVertexArrayObjects( SUPPORT(fixed_attributes, DeviceVersion) );
+	multiDraw          = UseMultiDraw( SUPPORT(multi_draw, DeviceVersion) );
+	baseVertex         = UseBaseVertex( SUPPORT(base_vertex, DeviceVersion) );
+	instancing         = UseInstancing();
+	drawIndirect       = UseDrawIndirect( SUPPORT(draw_indirect, DeviceVersion) );
+	multiDrawIndirect  = drawIndirect && UseMultiDrawIndirect();
+	bufferCopies       = UseBufferCopies( SUPPORT(buffer_copies, DeviceVersion) );
 }
 #endif // !defined(__ANDROID__)
 
@@ -1138,7 +2688,12 @@ Image* GLDeviceConcrete<DeviceVersion>::CreateImage()
 }
 
 //Texture1D*          SGL_DLLCALL CreateTexture1D(const Texture::TEXTURE_1D_DESC& desc);
-//TextureBuffer*      SGL_DLLCALL CreateTextureBuffer(const Texture::TEXTURE_BUFFER_DESC& desc);
+template<DEVICE_VERSION DeviceVersion>
+TextureBuffer* GLDeviceConcrete<DeviceVersion>::CreateTextureBuffer(const TextureBuffer::DESC& desc)
+{
+	return ::CreateTextureBuffer(this, desc);
+}
+
 template<DEVICE_VERSION DeviceVersion>
 Texture2D* GLDeviceConcrete<DeviceVersion>::CreateTexture2D(const Texture2D::DESC& desc)
 {
@@ -1179,15 +2734,21 @@ VertexLayout* GLDeviceConcrete<DeviceVersion>::CreateVertexLayout(unsigned int
 }
 
 template<DEVICE_VERSION DeviceVersion>
-VertexBuffer* GLDeviceConcrete<DeviceVersion>::CreateVertexBuffer()
+VertexBuffer* GLDeviceConcrete<DeviceVersion>::CreateVertexBuffer(Buffer::UPDATE_POLICY policy, unsigned numBuffers)
 {
-	return ::CreateVertexBuffer( this, SUPPORT(buffer_copies, DeviceVersion) );
+	return ::CreateVertexBuffer( this, policy, numBuffers, SUPPORT(buffer_copies, DeviceVersion) );
 }
 
 template<DEVICE_VERSION DeviceVersion>
-IndexBuffer* GLDeviceConcrete<DeviceVersion>::CreateIndexBuffer()
+IndexBuffer* GLDeviceConcrete<DeviceVersion>::CreateIndexBuffer(Buffer::UPDATE_POLICY policy, unsigned numBuffers)
 {
-	return ::CreateIndexBuffer( this, SUPPORT(buffer_copies, DeviceVersion) );
+	return ::CreateIndexBuffer( this, policy, numBuffers, SUPPORT(buffer_copies, DeviceVersion) );
+}
+
+template<DEVICE_VERSION DeviceVersion>
+UniformBuffer* GLDeviceConcrete<DeviceVersion>::CreateUniformBuffer(Buffer::UPDATE_POLICY policy, unsigned numBuffers)
+{
+	return ::CreateUniformBuffer( this, policy, numBuffers, SUPPORT(buffer_copies, DeviceVersion) );
 }
 
 // ============================ STATES ============================ //
@@ -1224,7 +2785,13 @@ SamplerState* GLDeviceConcrete<DeviceVersion>::CreateSamplerState(const SamplerS
 template<DEVICE_VERSION DeviceVersion>
 Shader* GLDeviceConcrete<DeviceVersion>::CreateShader(const Shader::DESC& desc)
 {
-    return ::CreateShader( this, desc, SUPPORT(programmable_pipeline, DeviceVersion) );
+    return ::CreateShader( this, desc, false, SUPPORT(programmable_pipeline, DeviceVersion) );
+}
+
+template<DEVICE_VERSION DeviceVersion>
+Shader* GLDeviceConcrete<DeviceVersion>::CreateShaderAsync(const Shader::DESC& desc)
+{
+    return ::CreateShader( this, desc, true, SUPPORT(programmable_pipeline, DeviceVersion) );
 }
 
 template<DEVICE_VERSION DeviceVersion>
@@ -1245,6 +2812,30 @@ RenderTarget* GLDeviceConcrete<DeviceVersion>::CreateRenderTarget()
 	return ::CreateRenderTarget( this, SUPPORT(render_target, DeviceVersion) );
 }
 
+template<DEVICE_VERSION DeviceVersion>
+CommandList* GLDeviceConcrete<DeviceVersion>::CreateCommandList()
+{
+	return new GLCommandList(this);
+}
+
+template<DEVICE_VERSION DeviceVersion>
+Query* GLDeviceConcrete<DeviceVersion>::CreateQuery(const Query::DESC& desc)
+{
+	return ::CreateQuery(this, desc);
+}
+
+template<DEVICE_VERSION DeviceVersion>
+StreamingBuffer* GLDeviceConcrete<DeviceVersion>::CreateStreamingBuffer(Buffer* buffer, const StreamingBuffer::DESC& desc)
+{
+	return ::CreateStreamingBuffer(this, buffer, desc);
+}
+
+template<DEVICE_VERSION DeviceVersion>
+StreamOut* GLDeviceConcrete<DeviceVersion>::CreateStreamOut()
+{
+	return ::CreateStreamOut(this);
+}
+
 #undef SUPPORT
 
 // explicit template instantiation
@@ -46,4 +46,47 @@ GLDeviceTraits::GLDeviceTraits(Device* _device) :
     supportsNPOT            = ( glewIsSupported("GL_ARB_texture_non_power_of_two") != 0);
     supportsHardwareMipmap  = ( glewIsSupported("GL_SGIS_generate_mipmap") != 0);
 #endif
+
+    // uniform buffers
+    numUniformBufferBindings     = 0;
+    uniformBufferOffsetAlignment = 1;
+#ifndef SIMPLE_GL_ES
+    if (GLEW_VERSION_3_1 || GLEW_ARB_uniform_buffer_object)
+    {
+        glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, (GLint*)&numUniformBufferBindings);
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, (GLint*)&uniformBufferOffsetAlignment);
+    }
+#endif
+
+    // stream output
+    numStreamOutBuffers = 0;
+#ifndef SIMPLE_GL_ES
+    if (GLEW_VERSION_3_0) {
+        glGetIntegerv(GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS, (GLint*)&numStreamOutBuffers);
+    }
+#endif
+
+    // texture buffers
+    maxTextureBufferSize         = 0;
+    textureBufferOffsetAlignment = 1;
+#ifndef SIMPLE_GL_ES
+    if (GLEW_VERSION_3_1 || GLEW_ARB_texture_buffer_object) {
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, (GLint*)&maxTextureBufferSize);
+    }
+#   ifdef GL_ARB_texture_buffer_range
+    if (GLEW_ARB_texture_buffer_range) {
+        glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, (GLint*)&textureBufferOffsetAlignment);
+    }
+#   endif
+#endif
+
+    // driver identity
+    const GLenum identityStrings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+    for (int i = 0; i<3; ++i)
+    {
+        if ( const GLubyte* str = glGetString(identityStrings[i]) ) {
+            driverIdentity += reinterpret_cast<const char*>(str);
+        }
+        driverIdentity += '\n';
+    }
 }
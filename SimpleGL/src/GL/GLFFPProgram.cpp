@@ -470,11 +470,35 @@ SGL_HRESULT GLFFPProgram::BindAttributeLocation(const char* /*name*/, unsigned /
     return EInvalidCall("Can't bind attribute location for ffp program.");
 }
 
+SGL_HRESULT GLFFPProgram::BindFragDataLocation(const char* /*name*/, unsigned /*colorNumber*/)
+{
+    return EInvalidCall("Can't bind fragment data location for ffp program.");
+}
+
+SGL_HRESULT GLFFPProgram::SetUniformBlockBinding(const char* /*name*/, unsigned /*bindingPoint*/)
+{
+    return EInvalidCall("Can't bind uniform block for ffp program.");
+}
+
+SGL_HRESULT GLFFPProgram::SetTransformFeedbackVaryings( unsigned                 /*numVaryings*/,
+                                                        const char**             /*varyings*/,
+                                                        TRANSFORM_FEEDBACK_MODE  /*mode*/ )
+{
+    return EInvalidCall("Can't capture varyings of the ffp program.");
+}
+
+SGL_HRESULT GLFFPProgram::LoadBinary(unsigned /*format*/, const void* /*data*/, unsigned /*size*/)
+{
+    return EInvalidCall("Can't load binary of the ffp program.");
+}
+
 SGL_HRESULT GLFFPProgram::Bind() const
 {
+    device->FlushUniforms();
     if (glUseProgram) {
         glUseProgram(0);
     }
+    SGL_FRAME_STATISTICS(device, numProgramBinds, 1);
     device->SetProgram(this);
 
 	return SGL_OK;
@@ -3,6 +3,7 @@
 #include "GL/GLFont.h"
 #include "Math/Containers.hpp"
 #include "Math/Matrix.hpp"
+#include <cstring>
 
 namespace {
 
@@ -35,12 +36,19 @@ namespace {
             gl_FragColor = color * texture2D(texture, fp_texcoord);\
         }";
 
+    // vertex is position(4) + texcoord(2)
+    const size_t VERTEX_SIZE = 6 * sizeof(float);
+
+    // vertices of the 1024 characters, strings are drawn by chunks of this size
+    const size_t CHUNK_SIZE = 1024 * 6;
+
 } // anonymous namespace
 
 namespace sgl {
 
 GLFont::GLFont(GLDevice* device_) :
-    device(device_)
+    device(device_),
+    frameIndex( device_->FrameIndex() )
 {
     {
         RasterizerState::DESC desc;
@@ -72,9 +80,12 @@ GLFont::GLFont(GLDevice* device_) :
 	    throw gl_error("Can't create vertex buffer for font rendering.");
     }
 
-    const size_t maxStrLength = 1024;
-    const size_t bufSize      = maxStrLength * 96 * sizeof(float);
-    if ( SGL_OK != vbo->SetData(bufSize, 0, Buffer::DYNAMIC_DRAW) ) {
+    // region per frame in flight, so printing doesn't wait for the previous frames
+    StreamingBuffer::DESC desc;
+    desc.size       = CHUNK_SIZE * VERTEX_SIZE * 3;
+    desc.numRegions = 3;
+    stream.reset( device->CreateStreamingBuffer(vbo.get(), desc) );
+    if (!stream) {
 	    throw gl_error("Can't allocate vertex buffer for font rendering.");
     }
 }
@@ -180,15 +191,30 @@ void GLFont::Print(float x, float y, const char* str) const
 	    }
     }
 
-    size_t bufSize = data.size() * sizeof(float);
-    if ( bufSize > vbo->Size() ) {
-        vbo->SetData(bufSize, &data[0], Buffer::DYNAMIC_DRAW);
-    }
-    else {
-        vbo->SetSubData(0, bufSize, &data[0]);
+    // first print of the frame fences text of the previous frame and switches to the next region
+    if ( frameIndex != device->FrameIndex() )
+    {
+        stream->EndFrame();
+        frameIndex = device->FrameIndex();
     }
 
-    device->Draw(TRIANGLES, 0, data.size() / 6);
+    size_t numVertices = data.size() / 6;
+    for (size_t first = 0; first < numVertices; first += CHUNK_SIZE)
+    {
+        size_t   count = std::min(CHUNK_SIZE, numVertices - first);
+        unsigned offset;
+        void*    chunk = stream->Allocate(count * VERTEX_SIZE, VERTEX_SIZE, offset);
+        if (!chunk) {
+            return;
+        }
+
+        memcpy(chunk, &data[first * 6], count * VERTEX_SIZE);
+        if ( SGL_OK != stream->Commit() ) {
+            return;
+        }
+
+        device->Draw(TRIANGLES, offset / VERTEX_SIZE, count);
+    }
 }
 
 sgl::Texture2D* GLFont::Texture() const
@@ -210,8 +236,8 @@ GLFontFixed::GLFontFixed(GLDevice* device) :
 	{
 		VertexLayout::ELEMENT elements[] =
 		{
-			{0, 4, 0,  24, sgl::FLOAT, VertexLayout::VERTEX},
-			{0, 2, 16, 24, sgl::FLOAT, VertexLayout::TEXCOORD}
+			{0, 4, 0,  24, sgl::FLOAT, VertexLayout::VERTEX, false, false},
+			{0, 2, 16, 24, sgl::FLOAT, VertexLayout::TEXCOORD, false, false}
 		};
 		vertexLayout.reset( device->CreateVertexLayout(2, elements) );
 	}
@@ -314,8 +340,8 @@ GLFontProgrammable::GLFontProgrammable(GLDevice* device) :
 
 		VertexLayout::ELEMENT elements[] =
 		{
-			{positionLoc, 4, 0,  24, sgl::FLOAT, VertexLayout::ATTRIBUTE},
-			{texcoordLoc, 2, 16, 24, sgl::FLOAT, VertexLayout::ATTRIBUTE},
+			{positionLoc, 4, 0,  24, sgl::FLOAT, VertexLayout::ATTRIBUTE, false, false},
+			{texcoordLoc, 2, 16, 24, sgl::FLOAT, VertexLayout::ATTRIBUTE, false, false},
 		};
 		vertexLayout.reset( device->CreateVertexLayout(2, elements) );
 	}
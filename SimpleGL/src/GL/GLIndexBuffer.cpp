@@ -17,8 +17,15 @@ GLIndexBuffer<BufferImpl>::~GLIndexBuffer()
 template<typename BufferImpl>
 void GLIndexBuffer<BufferImpl>::Bind(IndexBuffer::INDEX_TYPE format) const
 {   
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, BufferImpl::glBuffer);
+    // element array binding is a part of the vertex array object state
+    if ( BufferImpl::device->VertexArrayObjects() ) {
+        BufferImpl::device->SetVertexArrayIndexBuffer(BufferImpl::glBuffer);
+    }
+    else {
+        BufferImpl::device->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, BufferImpl::glBuffer);
+    }
     BufferImpl::device->SetIndexBuffer(this, format);
+    BufferImpl::MarkUsed();
 }
 
 template<typename BufferImpl>
@@ -26,7 +33,12 @@ void GLIndexBuffer<BufferImpl>::Unbind() const
 {
     if (BufferImpl::device->CurrentIndexBuffer() == this)
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        if ( BufferImpl::device->VertexArrayObjects() ) {
+            BufferImpl::device->SetVertexArrayIndexBuffer(0);
+        }
+        else {
+            BufferImpl::device->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
         BufferImpl::device->SetIndexBuffer(0, IndexBuffer::UINT_8);
     }
 }
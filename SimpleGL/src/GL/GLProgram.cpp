@@ -4,6 +4,7 @@
 #include "GL/GLUtility.h"
 #include "GL/GLVertexBuffer.h"
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <iterator>
 
@@ -31,11 +32,14 @@ namespace sgl {
 GLProgram::GLProgram(GLDevice* device_) :
     device(device_),
     uniforms(0),
+    feedbackMode(INTERLEAVED_ATTRIBS),
+    numActiveUniforms(0),
     numVerticesOut(3),
     inputType(TRIANGLES),
     outputType(TRIANGLE_STRIP),
     glProgram(0),
-    dirty(true)
+    dirty(true),
+    linking(false)
 {
     glProgram = glCreateProgram();
 }
@@ -43,6 +47,10 @@ GLProgram::GLProgram(GLDevice* device_) :
 
 GLProgram::~GLProgram()
 {
+    if (linking) {
+        device->RemoveLinkingProgram(this);
+    }
+
 	if ( device->Valid() )
 	{
 		Unbind();
@@ -107,6 +115,7 @@ AbstractUniform* GLProgram::CreateUniform( GLProgram*   program,
     typedef GLSamplerUniform<Texture2D>     sampler_uniform_2d;
     typedef GLSamplerUniform<Texture3D>     sampler_uniform_3d;
     typedef GLSamplerUniform<TextureCube>   sampler_uniform_cube;
+    typedef GLSamplerUniform<TextureBuffer> sampler_uniform_buffer;
 
     switch(glUniformType)
     {
@@ -296,6 +305,20 @@ AbstractUniform* GLProgram::CreateUniform( GLProgram*   program,
                                          glLocation );
     }
 
+#ifndef SIMPLE_GL_ES
+    case GL_INT_SAMPLER_BUFFER:
+    case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+    case GL_SAMPLER_BUFFER:
+    {
+        return new sampler_uniform_buffer( device,
+                                           program,
+                                           name,
+                                           glProgram,
+                                           glIndex,
+                                           glLocation );
+    }
+#endif
+
     default:
         return 0;
     }
@@ -307,6 +330,11 @@ AbstractUniform* GLProgram::CreateUniform( GLProgram*   program,
 
 SGL_HRESULT GLProgram::Dirty(bool force)
 {
+    // complete asynchronous linking
+    if ( !force && linking ) {
+        return FinishLink();
+    }
+
     if ( !force && !dirty ) {
         return SGL_OK;
     }
@@ -317,6 +345,60 @@ SGL_HRESULT GLProgram::Dirty(bool force)
     }
 #endif
 
+    SubmitLink();
+    return FinishLink();
+}
+
+SGL_HRESULT GLProgram::DirtyAsync(bool force)
+{
+    if ( !force && (!dirty || linking) ) {
+        return SGL_OK;
+    }
+
+#ifndef SGL_NO_STATUS_CHECK
+    if ( device->CurrentProgram() == this ) {
+        return EInvalidCall("GLProgram::DirtyAsync failed. Can't dirty program while it is binded.");
+    }
+#endif
+
+    SubmitLink();
+    if (!linking)
+    {
+        linking = true;
+        device->AddLinkingProgram(this);
+    }
+
+    return SGL_OK;
+}
+
+bool GLProgram::IsReady()
+{
+    if ( linking && LinkCompleted() ) {
+        FinishLink();
+    }
+
+    return !dirty;
+}
+
+bool GLProgram::LinkCompleted() const
+{
+#if !defined(SIMPLE_GL_ES) && defined(GL_KHR_parallel_shader_compile)
+    if ( device->ParallelShaderCompile() )
+    {
+        GLint completed;
+        glGetProgramiv(glProgram, GL_COMPLETION_STATUS_KHR, &completed);
+        return completed == GL_TRUE;
+    }
+#endif
+
+    return false;
+}
+
+void GLProgram::SubmitLink()
+{
+    // program is invalid until linking is completed
+    dirty = true;
+
     // attach/detach shaders
     {
         GLint numShaders;
@@ -372,24 +454,134 @@ SGL_HRESULT GLProgram::Dirty(bool force)
             glProgramParameteriEXT(glProgram, GL_GEOMETRY_OUTPUT_TYPE_EXT,  BIND_PRIMITIVE_TYPE[outputType]);
             glProgramParameteriEXT(glProgram, GL_GEOMETRY_VERTICES_OUT_EXT, numVerticesOut);
         }
+
+        // varyings are captured during linking, empty list resets previous ones
+        if (GLEW_VERSION_3_0)
+        {
+            std::vector<const GLchar*> varyings( feedbackVaryings.size() );
+            for (size_t i = 0; i<feedbackVaryings.size(); ++i) {
+                varyings[i] = feedbackVaryings[i].c_str();
+            }
+
+            glTransformFeedbackVaryings( glProgram,
+                                         varyings.size(),
+                                         varyings.empty() ? 0 : &varyings[0],
+                                         feedbackMode == SEPARATE_ATTRIBS ? GL_SEPARATE_ATTRIBS : GL_INTERLEAVED_ATTRIBS );
+        }
+
+    #   ifdef GL_ARB_get_program_binary
+        // let driver keep the binary, so GetBinary doesn't recompile the program
+        if (GLEW_ARB_get_program_binary) {
+            glProgramParameteri(glProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+    #   endif
     #endif
         glLinkProgram(glProgram);
+    }
+}
 
-        // error
-        GLsizei errLength;
-        glGetProgramiv(glProgram, GL_INFO_LOG_LENGTH, &errLength);
-        compilationLog.resize(errLength);
+SGL_HRESULT GLProgram::FinishLink()
+{
+    if (linking)
+    {
+        linking = false;
+        device->RemoveLinkingProgram(this);
+    }
+
+    // error
+    GLsizei errLength;
+    glGetProgramiv(glProgram, GL_INFO_LOG_LENGTH, &errLength);
+    compilationLog.resize(errLength);
+    if (errLength > 0)
+    {
         glGetProgramInfoLog(glProgram, errLength, &errLength, &compilationLog[0]);
         compilationLog.resize(errLength);
+    }
+
+    // check link status
+    GLint linkStatus;
+    glGetProgramiv(glProgram, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus != GL_TRUE)
+    {
+        // errors of the asynchronous shaders are reported only here
+        for (size_t i = 0; i<shaders.size(); ++i)
+        {
+            if ( !shaders[i]->QueryStatus() ) {
+                compilationLog += std::string("\n") + shaders[i]->CompilationLog();
+            }
+        }
+
+        return EInvalidCall( compilationLog.c_str() );
+    }
+
+    EnumerateInterface();
+
+    dirty = false;
+	return SGL_OK;
+}
+
+unsigned GLProgram::GetBinary( unsigned&  format,
+                               void*      data,
+                               unsigned   size ) const
+{
+#ifdef GL_ARB_get_program_binary
+    if ( !dirty && GLEW_ARB_get_program_binary )
+    {
+        GLint length;
+        glGetProgramiv(glProgram, GL_PROGRAM_BINARY_LENGTH, &length);
+        if ( data && size >= unsigned(length) )
+        {
+            GLenum glFormat;
+            glGetProgramBinary(glProgram, size, &length, &glFormat, data);
+            format = glFormat;
+        }
+
+        return length;
+    }
+#endif
+
+    return 0;
+}
+
+SGL_HRESULT GLProgram::LoadBinary( unsigned       format,
+                                   const void*    data,
+                                   unsigned       size )
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if ( device->CurrentProgram() == this ) {
+        return EInvalidCall("GLProgram::LoadBinary failed. Can't load program while it is binded.");
+    }
+#endif
+
+#ifdef GL_ARB_get_program_binary
+    if (GLEW_ARB_get_program_binary)
+    {
+        glProgramBinary(glProgram, format, data, size);
+
+        // unknown format raises an error, rejection is reported by the link status anyway
+        device->PollError();
 
-        // check link status
         GLint linkStatus;
         glGetProgramiv(glProgram, GL_LINK_STATUS, &linkStatus);
-        if (linkStatus != GL_TRUE) {
-            return EInvalidCall( compilationLog.c_str() );
+        if (linkStatus != GL_TRUE)
+        {
+            dirty = true;
+            return EInvalidCall("GLProgram::LoadBinary failed. Binary was rejected by the driver.");
         }
+
+        compilationLog.clear();
+        EnumerateInterface();
+
+        dirty = false;
+        return SGL_OK;
     }
+#endif
 
+    return EUnsupported("GLProgram::LoadBinary failed. ARB_get_program_binary is not supported.");
+}
+
+void GLProgram::EnumerateInterface()
+{
     // get uniform longest name and allocate space for it
     GLint uniformMaxNameLength;
     glGetProgramiv(glProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &uniformMaxNameLength);
@@ -420,17 +612,19 @@ SGL_HRESULT GLProgram::Dirty(bool force)
             uniformDescriptions[i].size     = uniformSize;
             uniformDescriptions[i].index    = i;
             uniformDescriptions[i].location = glGetUniformLocation( glProgram, uniformName.c_str() );
-            uniformDescriptions[i].name     = uniformName;
+            uniformDescriptions[i].name.assign(&uniformName[0], nameLength);
         }
     }
 
     // create uniforms
     {
+        dirtyUniforms.clear();
         if (uniforms) {
             delete[] uniforms;
         }
 
         uniforms = new uniform_ptr[ uniformDescriptions.size() ];
+        ResetUniformTable(numActiveUniforms);
         for(size_t i = 0; i<uniformDescriptions.size(); ++i)
         {
             // create uniform
@@ -440,10 +634,93 @@ SGL_HRESULT GLProgram::Dirty(bool force)
                                               uniformDescriptions[i].location,
                                               uniformDescriptions[i].type,
                                               uniformDescriptions[i].size ) );
+
+            // members of the uniform blocks don't have locations, they are set through the buffers
+            if ( uniforms[i] && uniformDescriptions[i].location != GLuint(-1) ) {
+                InsertUniform( uniforms[i].get() );
+            }
         }
     }
 
+    // enumerate uniform blocks
+    uniformBlocks.clear();
+    uniformBlockMembers.clear();
+#ifndef SIMPLE_GL_ES
+    if (GLEW_VERSION_3_1 || GLEW_ARB_uniform_buffer_object)
+    {
+        GLint numBlocks;
+        glGetProgramiv(glProgram, GL_ACTIVE_UNIFORM_BLOCKS, &numBlocks);
+
+        GLint maxNameLength;
+        glGetProgramiv(glProgram, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength);
+
+        for (GLint i = 0; i<numBlocks; ++i)
+        {
+            uniform_block block;
+            block.name.resize(maxNameLength + 1);
+
+            GLsizei nameLength;
+            glGetActiveUniformBlockName( glProgram,
+                                         i,
+                                         maxNameLength + 1,
+                                         &nameLength,
+                                         &block.name[0] );
+            block.name.resize(nameLength);
+
+            GLint size;
+            glGetActiveUniformBlockiv(glProgram, i, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+            block.index = i;
+            block.size  = size;
+
+            // linking resets bindings, restore requested one
+            block_binding_vector::const_iterator iter = blockBindings.begin();
+            while ( iter != blockBindings.end() && iter->first != block.name ) {
+                ++iter;
+            }
+
+            if ( iter != blockBindings.end() )
+            {
+                glUniformBlockBinding(glProgram, i, iter->second);
+                block.bindingPoint = iter->second;
+            }
+            else
+            {
+                GLint bindingPoint;
+                glGetActiveUniformBlockiv(glProgram, i, GL_UNIFORM_BLOCK_BINDING, &bindingPoint);
+                block.bindingPoint = bindingPoint;
+            }
+
+            uniformBlocks.push_back(block);
+        }
+
+        // offsets of the block members
+        if ( numBlocks > 0 && numActiveUniforms > 0 )
+        {
+            std::vector<GLuint> indices(numActiveUniforms);
+            std::vector<GLint>  blockIndices(numActiveUniforms);
+            std::vector<GLint>  offsets(numActiveUniforms);
+            for (unsigned int i = 0; i<numActiveUniforms; ++i) {
+                indices[i] = i;
+            }
+
+            glGetActiveUniformsiv(glProgram, numActiveUniforms, &indices[0], GL_UNIFORM_BLOCK_INDEX, &blockIndices[0]);
+            glGetActiveUniformsiv(glProgram, numActiveUniforms, &indices[0], GL_UNIFORM_OFFSET, &offsets[0]);
+            for (unsigned int i = 0; i<numActiveUniforms; ++i)
+            {
+                if (blockIndices[i] >= 0)
+                {
+                    uniform_block_member member;
+                    member.name   = uniformDescriptions[i].name.c_str();
+                    member.offset = offsets[i];
+                    uniformBlockMembers.push_back(member);
+                }
+            }
+        }
+    }
+#endif // !defined(SIMPLE_GL_ES)
+
     // enumerate attributes
+    attributes.clear();
     {
         int numAttributes;
         glGetProgramiv(glProgram, GL_ACTIVE_ATTRIBUTES, &numAttributes);
@@ -479,19 +756,30 @@ SGL_HRESULT GLProgram::Dirty(bool force)
         }
 	
     }
-
-    dirty = false;
-	return SGL_OK;
 }
 
 
 void GLProgram::Clear()
 {
+    if (linking)
+    {
+        linking = false;
+        device->RemoveLinkingProgram(this);
+    }
+
     dirty = true;
     shaders.clear();
+    dirtyUniforms.clear();
     if (uniforms) {
         delete[] uniforms;
     }
+    uniforms          = 0;
+    numActiveUniforms = 0;
+    uniformTable.clear();
+    uniformBlocks.clear();
+    uniformBlockMembers.clear();
+    blockBindings.clear();
+    feedbackVaryings.clear();
     compilationLog.clear();
 }
 
@@ -506,7 +794,9 @@ SGL_HRESULT GLProgram::Bind() const
 
     if (device->CurrentProgram() != this) 
     {
+        device->FlushUniforms();
         glUseProgram(glProgram);
+        SGL_FRAME_STATISTICS(device, numProgramBinds, 1);
         device->SetProgram(this);
     }
 
@@ -518,11 +808,28 @@ void GLProgram::Unbind() const
 {
     if (device->CurrentProgram() == this) 
     {
+        device->FlushUniforms();
         glUseProgram(0);
         device->SetProgram(0);
     }
 }
 
+void GLProgram::QueueUniform(GLShadowedUniform* uniform) const
+{
+    if ( dirtyUniforms.empty() ) {
+        device->SetUniformsDirty(this);
+    }
+    dirtyUniforms.push_back(uniform);
+}
+
+void GLProgram::FlushUniforms() const
+{
+    for (size_t i = 0; i<dirtyUniforms.size(); ++i) {
+        dirtyUniforms[i]->Flush();
+    }
+    dirtyUniforms.clear();
+}
+
 
 const char* GLProgram::CompilationLog() const
 {
@@ -571,9 +878,32 @@ SGL_HRESULT GLProgram::BindAttributeLocation(const char* name, unsigned index)
 }
 
 
+SGL_HRESULT GLProgram::BindFragDataLocation(const char* name, unsigned colorNumber)
+{
+#ifndef SIMPLE_GL_ES
+    if (GLEW_VERSION_3_0)
+    {
+        glBindFragDataLocation(glProgram, colorNumber, name);
+    #ifndef SGL_NO_STATUS_CHECK
+        GLuint err = glGetError();
+        if (GL_NO_ERROR != err) {
+            return EInvalidCall( (std::string("Can't bind fragment data location: ") + name).c_str() );
+        }
+    #endif
+        dirty = true;
+
+        return SGL_OK;
+    }
+#endif
+
+    return EUnsupported("GLProgram::BindFragDataLocation failed. Fragment data locations are not supported.");
+}
+
+
 int GLProgram::AttributeLocation(const char* name) const
 {
     int location = glGetAttribLocation(glProgram, name);
+    SGL_FRAME_STATISTICS(device, numGetQueries, 1);
     return location;
 }
 
@@ -591,7 +921,196 @@ Program::ATTRIBUTE GLProgram::Attribute(unsigned index) const
     return attributes[index].to_ATTRIBUTE();
 }
 
+// Uniform blocks
+
+SGL_HRESULT GLProgram::SetUniformBlockBinding(const char* name, unsigned bindingPoint)
+{
+#ifdef SIMPLE_GL_ES
+    return EUnsupported("GLProgram::SetUniformBlockBinding failed. Uniform buffers are not supported.");
+#else
+#ifndef SGL_NO_STATUS_CHECK
+    if (!name) {
+        return EInvalidCall("GLProgram::SetUniformBlockBinding failed. Block name is 0.");
+    }
+
+    if (!GLEW_VERSION_3_1 && !GLEW_ARB_uniform_buffer_object) {
+        return EUnsupported("GLProgram::SetUniformBlockBinding failed. Uniform buffers are not supported.");
+    }
+#endif
+
+    // block is validated once the program is linked
+    int blockIndex = -1;
+    if (!dirty)
+    {
+        blockIndex = UniformBlockIndex(name);
+        if (blockIndex < 0) {
+            return EInvalidCall( (std::string("GLProgram::SetUniformBlockBinding failed. Can't find uniform block: ") + name).c_str() );
+        }
+    }
+
+    // remember binding, linking resets it
+    block_binding_vector::iterator iter = blockBindings.begin();
+    while ( iter != blockBindings.end() && iter->first != name ) {
+        ++iter;
+    }
+
+    if ( iter != blockBindings.end() ) {
+        iter->second = bindingPoint;
+    }
+    else {
+        blockBindings.push_back( std::make_pair(std::string(name), bindingPoint) );
+    }
+
+    if (blockIndex >= 0)
+    {
+        glUniformBlockBinding(glProgram, blockIndex, bindingPoint);
+        uniformBlocks[blockIndex].bindingPoint = bindingPoint;
+    }
+
+#ifndef SGL_NO_STATUS_CHECK
+    return CheckGLError("GLProgram::SetUniformBlockBinding failed: ", device->PollError());
+#else
+    return SGL_OK;
+#endif
+#endif // !defined(SIMPLE_GL_ES)
+}
+
+
+int GLProgram::UniformBlockIndex(const char* name) const
+{
+    for (size_t i = 0; i<uniformBlocks.size(); ++i)
+    {
+        if (uniformBlocks[i].name == name) {
+            return uniformBlocks[i].index;
+        }
+    }
+
+    return -1;
+}
+
+
+Program::UNIFORM_BLOCK GLProgram::UniformBlock(unsigned index) const
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if ( index >= uniformBlocks.size() )
+    {
+        sglSetError(SGLERR_INVALID_CALL, "GLProgram::UniformBlock failed. Index is out of range.");
+        return UNIFORM_BLOCK();
+    }
+#endif
+
+    return uniformBlocks[index].to_UNIFORM_BLOCK();
+}
+
+
+int GLProgram::UniformBlockMemberOffset(const char* name) const
+{
+    for (size_t i = 0; i<uniformBlockMembers.size(); ++i)
+    {
+        if (uniformBlockMembers[i].name == name) {
+            return uniformBlockMembers[i].offset;
+        }
+    }
+
+    return -1;
+}
+
+// Stream output
+
+SGL_HRESULT GLProgram::SetTransformFeedbackVaryings( unsigned                 numVaryings,
+                                                     const char**             varyings,
+                                                     TRANSFORM_FEEDBACK_MODE  mode )
+{
+#ifdef SIMPLE_GL_ES
+    return EUnsupported("GLProgram::SetTransformFeedbackVaryings failed. Stream output is not supported.");
+#else
+#ifndef SGL_NO_STATUS_CHECK
+    if (!GLEW_VERSION_3_0) {
+        return EUnsupported("GLProgram::SetTransformFeedbackVaryings failed. Stream output is not supported.");
+    }
+
+    if ( mode == SEPARATE_ATTRIBS && numVaryings > device->Traits()->NumberOfStreamOutBuffers() ) {
+        return EInvalidCall("GLProgram::SetTransformFeedbackVaryings failed. Too many separate varyings.");
+    }
+
+    for (unsigned i = 0; i<numVaryings; ++i)
+    {
+        if (!varyings[i]) {
+            return EInvalidCall("GLProgram::SetTransformFeedbackVaryings failed. Varying name is 0.");
+        }
+    }
+#endif
+
+    feedbackVaryings.assign(varyings, varyings + numVaryings);
+    feedbackMode = mode;
+    dirty        = true;
+
+    return SGL_OK;
+#endif // !defined(SIMPLE_GL_ES)
+}
+
 // Uniforms
+void GLProgram::InsertUniform(AbstractUniform* uniform, unsigned nameLength)
+{
+    assert( !uniformTable.empty() );
+
+    uniform_slot slot;
+    slot.hash       = UniformName::Hash( std::string(uniform->Name(), nameLength).c_str() );
+    slot.nameLength = nameLength;
+    slot.uniform    = uniform;
+
+    // linear probing, table always has free slots
+    size_t mask = uniformTable.size() - 1;
+    size_t i    = slot.hash & mask;
+    while (uniformTable[i].uniform) {
+        i = (i + 1) & mask;
+    }
+    uniformTable[i] = slot;
+}
+
+void GLProgram::ResetUniformTable(unsigned numUniforms)
+{
+    // every uniform may be inserted twice: arrays are accessible with and without [0]
+    size_t tableSize = 8;
+    while ( tableSize < numUniforms * 4 ) {
+        tableSize *= 2;
+    }
+
+    uniform_slot emptySlot = {0, 0, 0};
+    uniformTable.assign(tableSize, emptySlot);
+}
+
+void GLProgram::InsertUniform(AbstractUniform* uniform)
+{
+    const char* name       = uniform->Name();
+    unsigned    nameLength = strlen(name);
+    InsertUniform(uniform, nameLength);
+    if ( nameLength > 3 && strcmp(name + nameLength - 3, "[0]") == 0 ) {
+        InsertUniform(uniform, nameLength - 3);
+    }
+}
+
+AbstractUniform* GLProgram::FindUniform(const char* name, unsigned hash) const
+{
+    if ( uniformTable.empty() ) {
+        return 0;
+    }
+
+    size_t mask = uniformTable.size() - 1;
+    for (size_t i = hash & mask; uniformTable[i].uniform; i = (i + 1) & mask)
+    {
+        const uniform_slot& slot = uniformTable[i];
+        if ( slot.hash == hash
+             && strncmp(slot.uniform->Name(), name, slot.nameLength) == 0
+             && name[slot.nameLength] == '\0' )
+        {
+            return slot.uniform;
+        }
+    }
+
+    return 0;
+}
+
 AbstractUniform* GLProgram::GetUniform(const char* name) const
 {
     if (dirty)
@@ -606,99 +1125,20 @@ AbstractUniform* GLProgram::GetUniform(const char* name) const
 		return 0;
 	}
 
-    GLint uniform = glGetUniformLocation(glProgram, name);
-    if (uniform == -1) {
-        return 0;
-    }
+    return FindUniform( name, UniformName::Hash(name) );
+}
 
-    // search for uniform in the uniform array
-    for(size_t i = 0; i<numActiveUniforms; ++i)
+AbstractUniform* GLProgram::GetUniform(const UniformName& name) const
+{
+    if (dirty)
     {
-        // hack
-        GLint location = -1;
-        switch ( uniforms[i]->Type() )
-        {
-        case AbstractUniform::INT:
-            location = static_cast< GLUniform<int>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::VEC2I:
-            location = static_cast< GLUniform<math::Vector2i>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::VEC3I:
-            location = static_cast< GLUniform<math::Vector3i>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::VEC4I:
-            location = static_cast< GLUniform<math::Vector4i>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::FLOAT:
-            location = static_cast< GLUniform<float>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::VEC2F:
-            location = static_cast< GLUniform<math::Vector2f>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::VEC3F:
-            location = static_cast< GLUniform<math::Vector3f>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::VEC4F:
-            location = static_cast< GLUniform<math::Vector4f>& >(*uniforms[i]).Location();
-            break;
-    #ifndef SIMPLE_GL_ES
-        case AbstractUniform::MAT2x2F:
-            location = static_cast< GLUniform<math::Matrix2x2f>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::MAT2x3F:
-            location = static_cast< GLUniform<math::Matrix2x3f>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::MAT2x4F:
-            location = static_cast< GLUniform<math::Matrix2x4f>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::MAT3x2F:
-            location = static_cast< GLUniform<math::Matrix3x2f>& >(*uniforms[i]).Location();
-            break;
-    #endif
-        case AbstractUniform::MAT3x3F:
-            location = static_cast< GLUniform<math::Matrix3x3f>& >(*uniforms[i]).Location();
-            break;
-    #ifndef SIMPLE_GL_ES
-        case AbstractUniform::MAT3x4F:
-            location = static_cast< GLUniform<math::Matrix3x4f>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::MAT4x2F:
-            location = static_cast< GLUniform<math::Matrix4x2f>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::MAT4x3F:
-            location = static_cast< GLUniform<math::Matrix4x3f>& >(*uniforms[i]).Location();
-            break;
-    #endif
-        case AbstractUniform::MAT4x4F:
-            location = static_cast< GLUniform<math::Matrix4x4f>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::SAMPLER_1D:
-            location = static_cast< GLSamplerUniform<Texture1D>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::SAMPLER_2D:
-            location = static_cast< GLSamplerUniform<Texture2D>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::SAMPLER_3D:
-            location = static_cast< GLSamplerUniform<Texture3D>& >(*uniforms[i]).Location();
-            break;
-        case AbstractUniform::SAMPLER_CUBE:
-            location = static_cast< GLSamplerUniform<TextureCube>& >(*uniforms[i]).Location();
-            break;
-        default:
-            assert(!"Can't get here");
-            break;
-        }
-
-        if (uniform == location) {
-            return uniforms[i].get();
-        }
+        sglSetError(SGLERR_INVALID_CALL, "GLProgram::GetUniform failed. Program is Dirty.");
+        return 0;
     }
 
-    return 0;
+    return FindUniform( name.Name(), name.Hash() );
 }
 
-
 UniformI* GLProgram::GetUniformI(const char* name) const
 {
     return GetUniform<int>(name);
@@ -788,4 +1228,10 @@ SamplerUniformCube* SGL_DLLCALL GLProgram::GetSamplerUniformCube(const char* nam
     return GetSamplerUniform<TextureCube>(name);
 }
 
+
+SamplerUniformBuffer* SGL_DLLCALL GLProgram::GetSamplerUniformBuffer(const char* name) const
+{
+    return GetSamplerUniform<TextureBuffer>(name);
+}
+
 } // namespace sgl
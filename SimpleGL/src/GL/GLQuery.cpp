@@ -0,0 +1,222 @@
+#include "GL/GLCommon.h"
+#include "GL/GLDevice.h"
+#include "GL/GLQuery.h"
+#include <algorithm>
+
+#ifndef SIMPLE_GL_ES
+
+namespace {
+
+    using namespace sgl;
+
+    // ANY_SAMPLES_PASSED falls back to SAMPLES_PASSED if ARB_occlusion_query2 is unavailable
+    GLenum QueryTarget(Query::TYPE type)
+    {
+        switch (type)
+        {
+            case Query::TIME_ELAPSED:
+                return GL_TIME_ELAPSED_EXT;
+
+            case Query::TIMESTAMP:
+            #ifdef GL_ARB_timer_query
+                return GL_TIMESTAMP;
+            #else
+                return 0;
+            #endif
+
+            case Query::SAMPLES_PASSED:
+                return GL_SAMPLES_PASSED;
+
+            case Query::ANY_SAMPLES_PASSED:
+            #ifdef GL_ARB_occlusion_query2
+                if (GLEW_ARB_occlusion_query2) {
+                    return GL_ANY_SAMPLES_PASSED;
+                }
+            #endif
+                return GL_SAMPLES_PASSED;
+
+            case Query::PRIMITIVES_GENERATED:
+                return GL_PRIMITIVES_GENERATED;
+
+            case Query::TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN:
+                return GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN;
+        }
+
+        return 0;
+    }
+
+} // anonymous namespace
+
+namespace sgl {
+
+GLQuery::GLQuery( GLDevice*     device_,
+                  const DESC&   desc ) :
+    device(device_),
+    type(desc.type),
+    glTarget( QueryTarget(desc.type) ),
+    queries( std::max(desc.numBuffers, 1u) ),
+    head(0),
+    numPending(0),
+    active(false)
+{
+    glGenQueries( queries.size(), &queries[0] );
+
+#ifndef SGL_NO_STATUS_CHECK
+    GLenum glError = glGetError();
+    if ( glError != GL_NO_ERROR )
+    {
+        CheckGLError("GLQuery::GLQuery failed: ", glError);
+        throw gl_error("GLQuery::GLQuery failed");
+    }
+#endif
+}
+
+GLQuery::~GLQuery()
+{
+    if ( device->Valid() )
+    {
+        if (active) {
+            glEndQuery(glTarget);
+        }
+        glDeleteQueries( queries.size(), &queries[0] );
+    }
+}
+
+bool GLQuery::SupportsType(TYPE type)
+{
+    switch (type)
+    {
+        case TIME_ELAPSED:
+            return GLEW_EXT_timer_query == GL_TRUE;
+
+        case TIMESTAMP:
+        #ifdef GL_ARB_timer_query
+            return GLEW_ARB_timer_query == GL_TRUE;
+        #else
+            return false;
+        #endif
+
+        case SAMPLES_PASSED:
+        case ANY_SAMPLES_PASSED:
+            return GLEW_VERSION_1_5 == GL_TRUE;
+
+        case PRIMITIVES_GENERATED:
+        case TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN:
+            return GLEW_VERSION_3_0 == GL_TRUE;
+    }
+
+    return false;
+}
+
+SGL_HRESULT GLQuery::Begin()
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if (type == TIMESTAMP) {
+        return EInvalidCall("GLQuery::Begin failed. Timestamp queries can't be started.");
+    }
+
+    if (active) {
+        return EInvalidCall("GLQuery::Begin failed. Query is already active.");
+    }
+#endif
+
+    if ( numPending == queries.size() ) {
+        return SGLERR_UNAVAILABLE;
+    }
+
+    glBeginQuery( glTarget, queries[(head + numPending) % queries.size()] );
+    active = true;
+
+#ifndef SGL_NO_STATUS_CHECK
+    return CheckGLError("GLQuery::Begin failed: ", device->PollError());
+#else
+    return SGL_OK;
+#endif
+}
+
+SGL_HRESULT GLQuery::End()
+{
+    if (type == TIMESTAMP)
+    {
+        if ( numPending == queries.size() ) {
+            return SGLERR_UNAVAILABLE;
+        }
+
+    #ifdef GL_ARB_timer_query
+        glQueryCounter(queries[(head + numPending) % queries.size()], GL_TIMESTAMP);
+    #endif
+    }
+    else
+    {
+    #ifndef SGL_NO_STATUS_CHECK
+        if (!active) {
+            return EInvalidCall("GLQuery::End failed. Query is not active.");
+        }
+    #endif
+
+        glEndQuery(glTarget);
+        active = false;
+    }
+    ++numPending;
+
+#ifndef SGL_NO_STATUS_CHECK
+    return CheckGLError("GLQuery::End failed: ", device->PollError());
+#else
+    return SGL_OK;
+#endif
+}
+
+bool GLQuery::ResultAvailable() const
+{
+    if (numPending == 0) {
+        return false;
+    }
+
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(queries[head], GL_QUERY_RESULT_AVAILABLE, &available);
+    return available == GL_TRUE;
+}
+
+SGL_HRESULT GLQuery::GetResult(unsigned long long& result, bool wait)
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if (numPending == 0) {
+        return EInvalidCall("GLQuery::GetResult failed. There are no pending queries.");
+    }
+#endif
+
+    if ( !wait && !ResultAvailable() ) {
+        return SGLERR_UNAVAILABLE;
+    }
+
+    // timer results may exceed 32 bits
+    if (GLEW_EXT_timer_query)
+    {
+        GLuint64EXT value;
+        glGetQueryObjectui64vEXT(queries[head], GL_QUERY_RESULT, &value);
+        result = value;
+    }
+    else
+    {
+        GLuint value;
+        glGetQueryObjectuiv(queries[head], GL_QUERY_RESULT, &value);
+        result = value;
+    }
+
+    if (type == ANY_SAMPLES_PASSED) {
+        result = (result > 0) ? 1 : 0;
+    }
+
+    head = (head + 1) % queries.size();
+    --numPending;
+
+#ifndef SGL_NO_STATUS_CHECK
+    return CheckGLError("GLQuery::GetResult failed: ", device->PollError());
+#else
+    return SGL_OK;
+#endif
+}
+
+} // namespace sgl
+
+#endif // !defined(SIMPLE_GL_ES)
@@ -43,22 +43,44 @@ GLRasterizerState::~GLRasterizerState()
 
 void GLRasterizerState::Bind() const
 {
-	if (desc.cullMode != NONE)
-	{
-		glEnable(GL_CULL_FACE);
-		glCullFace(glCullMode);
-	}
-	else {
-		glDisable(GL_CULL_FACE);
-	}
+    GLDevice::STATE_CACHE& cache = device->StateCache();
+
+    GLint cullEnable = (desc.cullMode != NONE);
+    if (cache.cullEnable != cullEnable)
+    {
+        if (cullEnable) {
+            glEnable(GL_CULL_FACE);
+        }
+        else {
+            glDisable(GL_CULL_FACE);
+        }
+        cache.cullEnable = cullEnable;
+    }
+
+    if ( cullEnable && cache.cullFace != GLint(glCullMode) )
+    {
+        glCullFace(glCullMode);
+        cache.cullFace = glCullMode;
+    }
 #ifndef SIMPLE_GL_ES
-	glPolygonMode(GL_FRONT_AND_BACK, glFillMode);
+    if ( cache.fillMode != GLint(glFillMode) )
+    {
+        glPolygonMode(GL_FRONT_AND_BACK, glFillMode);
+        cache.fillMode = glFillMode;
+    }
 #endif
-	glColorMask(desc.colorMask & RED,
-                desc.colorMask & GREEN,
-                desc.colorMask & BLUE,
-                desc.colorMask & ALPHA);
+    // colorMask is signed bitfield, so mask it to get nonnegative value
+    GLint colorMask = desc.colorMask & RGBA;
+    if (cache.colorMask != colorMask)
+    {
+        glColorMask(colorMask & RED,
+                    colorMask & GREEN,
+                    colorMask & BLUE,
+                    colorMask & ALPHA);
+        cache.colorMask = colorMask;
+    }
 
+	SGL_FRAME_STATISTICS(device, numStateBinds, 1);
 	device->SetRasterizerState(this);
 }
 
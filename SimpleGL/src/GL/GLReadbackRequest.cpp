@@ -0,0 +1,242 @@
+#include "GL/GLCommon.h"
+#include "GL/GLDevice.h"
+#include "GL/GLBuffer.h"
+#include "GL/GLReadbackRequest.h"
+#include "GL/GLTexture.h"
+#include "Image.h"
+
+#ifndef SIMPLE_GL_ES
+
+namespace sgl {
+
+GLReadbackRequest::GLReadbackRequest( GLDevice*  device_,
+                                      unsigned   size_ ) :
+    device(device_),
+    glBuffer(0),
+    fence(0),
+    size(size_),
+    mapped(false)
+{
+    glGenBuffers(1, &glBuffer);
+    {
+        guarded_buffer_binding binding(device, GL_PIXEL_PACK_BUFFER, glBuffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, 0, GL_STREAM_READ);
+    }
+
+#ifndef SGL_NO_STATUS_CHECK
+    GLenum glError = glGetError();
+    if ( glError != GL_NO_ERROR )
+    {
+        CheckGLError("GLReadbackRequest::GLReadbackRequest failed: ", glError);
+        throw gl_error("GLReadbackRequest::GLReadbackRequest failed");
+    }
+#endif
+}
+
+GLReadbackRequest::~GLReadbackRequest()
+{
+    if ( device->Valid() )
+    {
+        if (mapped) {
+            Unmap();
+        }
+
+        if (fence) {
+            glDeleteSync( static_cast<GLsync>(fence) );
+        }
+
+        device->ReleaseBuffer(glBuffer);
+        glDeleteBuffers(1, &glBuffer);
+    }
+}
+
+bool GLReadbackRequest::Supported()
+{
+    return GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object;
+}
+
+SGL_HRESULT GLReadbackRequest::Issue()
+{
+    // without fences mapping synchronizes with the copy
+    if (GLEW_ARB_sync) {
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+#ifndef SGL_NO_STATUS_CHECK
+    return CheckGLError("GLReadbackRequest::Issue failed: ", device->PollError());
+#else
+    return SGL_OK;
+#endif
+}
+
+bool GLReadbackRequest::IsReady() const
+{
+    if (!fence) {
+        return true;
+    }
+
+    GLenum status = glClientWaitSync(static_cast<GLsync>(fence), 0, 0);
+    if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+    {
+        glDeleteSync( static_cast<GLsync>(fence) );
+        fence = 0;
+        return true;
+    }
+
+    return false;
+}
+
+SGL_HRESULT GLReadbackRequest::Wait()
+{
+    if (!fence) {
+        return SGL_OK;
+    }
+
+    GLsync sync   = static_cast<GLsync>(fence);
+    GLenum status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    while (status == GL_TIMEOUT_EXPIRED) {
+        status = glClientWaitSync(sync, 0, 1000000000);
+    }
+
+    glDeleteSync(sync);
+    fence = 0;
+
+    if (status == GL_WAIT_FAILED) {
+        return CheckGLError("GLReadbackRequest::Wait failed: ", glGetError());
+    }
+
+    return SGL_OK;
+}
+
+SGL_HRESULT GLReadbackRequest::Map(const void** data)
+{
+    assert(data);
+#ifndef SGL_NO_STATUS_CHECK
+    if (mapped) {
+        return EInvalidCall("GLReadbackRequest::Map failed. Request is already mapped.");
+    }
+#endif
+
+    SGL_HRESULT result = Wait();
+    if (SGL_OK != result) {
+        return result;
+    }
+
+    {
+        guarded_buffer_binding binding(device, GL_PIXEL_PACK_BUFFER, glBuffer);
+        (*data) = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    }
+#ifndef SGL_NO_STATUS_CHECK
+    GLenum error = device->PollError();
+    if (error != GL_NO_ERROR) {
+        return CheckGLError("GLReadbackRequest::Map failed: ", error);
+    }
+#endif
+
+    mapped = true;
+    return SGL_OK;
+}
+
+SGL_HRESULT GLReadbackRequest::Unmap()
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if (!mapped) {
+        return EInvalidCall("GLReadbackRequest::Unmap failed. Request is not mapped.");
+    }
+#endif
+
+    {
+        guarded_buffer_binding binding(device, GL_PIXEL_PACK_BUFFER, glBuffer);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    mapped = false;
+
+#ifndef SGL_NO_STATUS_CHECK
+    return CheckGLError("GLReadbackRequest::Unmap failed: ", device->PollError());
+#else
+    return SGL_OK;
+#endif
+}
+
+GLReadbackRequest* GLReadbackRequest::ReadPixels( GLDevice*          device,
+                                                  const rectangle&   rect,
+                                                  Texture::FORMAT    format )
+{
+    if ( !Supported() )
+    {
+        sglSetError(SGLERR_UNSUPPORTED, "GLReadbackRequest::ReadPixels failed. Pixel buffer objects are not supported.");
+        return 0;
+    }
+
+    if ( Texture::FORMAT_TRAITS[format].compressed )
+    {
+        sglSetError(SGLERR_INVALID_CALL, "GLReadbackRequest::ReadPixels failed. Can't read pixels in compressed format.");
+        return 0;
+    }
+
+    GLReadbackRequest* request = new GLReadbackRequest( device, Image::SizeOfData(format, rect.width, rect.height, 1) );
+    {
+        // rows are tightly packed as in Image
+        guarded_buffer_binding binding(device, GL_PIXEL_PACK_BUFFER, request->glBuffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels( rect.x,
+                      rect.y,
+                      rect.width,
+                      rect.height,
+                      BIND_GL_FORMAT_USAGE[format],
+                      BIND_GL_FORMAT_PIXEL_TYPE[format],
+                      0 );
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    }
+
+    if ( SGL_OK != request->Issue() )
+    {
+        delete request;
+        return 0;
+    }
+
+    return request;
+}
+
+GLReadbackRequest* GLReadbackRequest::ReadTexImage( GLDevice*        device,
+                                                    unsigned         glTarget,
+                                                    unsigned         mipmap,
+                                                    Texture::FORMAT  format,
+                                                    unsigned         width,
+                                                    unsigned         height )
+{
+    if ( !Supported() )
+    {
+        sglSetError(SGLERR_UNSUPPORTED, "GLReadbackRequest::ReadTexImage failed. Pixel buffer objects are not supported.");
+        return 0;
+    }
+
+    width  = std::max(width >> mipmap, 1u);
+    height = std::max(height >> mipmap, 1u);
+
+    GLReadbackRequest* request = new GLReadbackRequest( device, Image::SizeOfData(format, width, height, 1) );
+    {
+        guarded_buffer_binding binding(device, GL_PIXEL_PACK_BUFFER, request->glBuffer);
+        if ( Texture::FORMAT_TRAITS[format].compressed ) {
+            glGetCompressedTexImage(glTarget, mipmap, 0);
+        }
+        else
+        {
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glGetTexImage(glTarget, mipmap, BIND_GL_FORMAT_USAGE[format], BIND_GL_FORMAT_PIXEL_TYPE[format], 0);
+            glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        }
+    }
+
+    if ( SGL_OK != request->Issue() )
+    {
+        delete request;
+        return 0;
+    }
+
+    return request;
+}
+
+} // namespace sgl
+
+#endif // !defined(SIMPLE_GL_ES)
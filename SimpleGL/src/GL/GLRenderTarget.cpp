@@ -1,4 +1,5 @@
 #include "GL/GLCommon.h"
+#include "GL/GLReadbackRequest.h"
 #include "GL/GLRenderTarget.h"
 #include <algorithm>
 #include <functional>
@@ -145,6 +146,17 @@ bool GLRenderTarget::IsDirty() const
     return dirty;
 }
 
+ReadbackRequest* GLRenderTarget::Readback(const rectangle& rect, Texture::FORMAT format) const
+{
+#ifdef SIMPLE_GL_ES
+    sglSetError(SGLERR_UNSUPPORTED, "GLRenderTarget::Readback failed. Not supported in GLES.");
+    return 0;
+#else
+    guarded_binding_ptr guardedTarget( new guarded_binding(device, this) );
+    return GLReadbackRequest::ReadPixels(device, rect, format);
+#endif
+}
+
 SGL_HRESULT GLRenderTarget::Dirty(bool force)
 {
     if (!dirty && !force) {
@@ -154,6 +166,7 @@ SGL_HRESULT GLRenderTarget::Dirty(bool force)
     // bind
     GLenum error;
     GLuint oldFBO               = GuardedBind(fbo);
+    SGL_FRAME_STATISTICS(device, numGetQueries, 1);
     GLuint maxAttachmentWidth   = 0;
     GLuint maxAttachmentHeight  = 0;
     bool   fillDrawBuffers      = drawBuffers.empty();
@@ -203,7 +216,7 @@ SGL_HRESULT GLRenderTarget::Dirty(bool force)
             }
 
 #ifndef SGL_NO_STATUS_CHECK
-            error = glGetError();
+            error = device->PollError();
             if ( error != GL_NO_ERROR )
             {
                 GuardedUnbind(oldFBO);
@@ -223,7 +236,7 @@ SGL_HRESULT GLRenderTarget::Dirty(bool force)
                                 dsAttachment.level );
 
 #ifndef SGL_NO_STATUS_CHECK
-        error = glGetError();
+        error = device->PollError();
         if ( error != GL_NO_ERROR )
         {
             GuardedUnbind(oldFBO);
@@ -255,7 +268,7 @@ SGL_HRESULT GLRenderTarget::Dirty(bool force)
         }
 
 #ifndef SGL_NO_STATUS_CHECK
-        error = glGetError();
+        error = device->PollError();
         if ( error != GL_NO_ERROR )
         {
             GuardedUnbind(oldFBO);
@@ -274,7 +287,7 @@ SGL_HRESULT GLRenderTarget::Dirty(bool force)
                                    dsRenderBuffer );
 
 #ifndef SGL_NO_STATUS_CHECK
-        error = glGetError();
+        error = device->PollError();
         if ( error != GL_NO_ERROR )
         {
             GuardedUnbind(oldFBO);
@@ -398,10 +411,11 @@ void GLRenderTarget::Unbind() const
 {
     if ( device->CurrentRenderTarget() == this )
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glBindFramebuffer( GL_FRAMEBUFFER, device->DefaultFramebuffer() );
     #ifndef SIMPLE_GL_ES
-        glDrawBuffer(GL_BACK);
-        glReadBuffer(GL_BACK);
+        GLenum glBuffer = device->DefaultFramebuffer() ? GL_COLOR_ATTACHMENT0 : GL_BACK;
+        glDrawBuffer(glBuffer);
+        glReadBuffer(glBuffer);
     #endif
         device->SetRenderTarget(0);
     }
@@ -22,7 +22,8 @@ namespace {
 namespace sgl {
 
 GLShader::GLShader( GLDevice*	device_, 
-                    const DESC& desc ) :
+                    const DESC& desc,
+                    bool        async ) :
     device(device_),
     type(desc.type)
 {
@@ -33,27 +34,39 @@ GLShader::GLShader( GLDevice*	device_,
     GLsizei size = strlen(desc.source);
     glShaderSource(shader, 1, (const char**)&desc.source, &size);
 
-    // compile
-    GLint compileStatus;
+    // compile, status of the asynchronous shaders is checked when the program is linked
     glCompileShader(shader);
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
 
     // error
-    if (compileStatus != GL_TRUE)
+    if ( !async && !QueryStatus() )
     {
-        GLsizei     errLength;
-        std::string log;
-
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &errLength);
-        log.resize(errLength);
-        glGetShaderInfoLog(shader, errLength, &errLength, &log[0]);
         glDeleteShader(shader);
-        sglSetError( SGLERR_INVALID_CALL, ("Shader compilation log: " + log).c_str() );
+        sglSetError( SGLERR_INVALID_CALL, ("Shader compilation log: " + compilationLog).c_str() );
 
         throw gl_error("Shader compilation error", SGLERR_INVALID_CALL);
     }
 }
 
+bool GLShader::QueryStatus()
+{
+    GLint compileStatus;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
+    if (compileStatus == GL_TRUE) {
+        return true;
+    }
+
+    GLsizei errLength;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &errLength);
+    compilationLog.resize(errLength);
+    if (errLength > 0)
+    {
+        glGetShaderInfoLog(shader, errLength, &errLength, &compilationLog[0]);
+        compilationLog.resize(errLength);
+    }
+
+    return false;
+}
+
 GLShader::~GLShader()
 {
 	if ( device->Valid() ) {
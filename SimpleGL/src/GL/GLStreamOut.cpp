@@ -1,94 +1,264 @@
+#include "GL/GLCommon.h"
+#include "GL/GLDevice.h"
+#include "GL/GLBuffer.h"
 #include "GL/GLStreamOut.h"
 
-using namespace sgl;
+#ifndef SIMPLE_GL_ES
 
-GLStreamOut::GLStreamOut(GLProgram* _program) :
-    program(_program),
-    dirty(true),
-    streamOutMode(INTERLEAVED),
-    primitiveType(TRIANGLES)
+namespace sgl {
+
+GLStreamOut::GLStreamOut(GLDevice* device_) :
+    device(device_),
+    primitiveType(TRIANGLES),
+    rasterizerDiscard(false),
+    active(false),
+    paused(false)
 {
 }
 
 GLStreamOut::~GLStreamOut()
 {
-    if (feedbackVaryings) 
-    {
-        for(size_t i = 0; i<declaration.size(); ++i) {
-            free(feedbackVaryings[i]);
-        }
-        free(feedbackVaryings);
+    if ( active && device->Valid() ) {
+        End();
     }
 }
 
-SGL_HRESULT SGL_DLLCALL GLStreamOut::SetPrimitiveType(PRIMITIVE_TYPE _primitiveType)
+bool GLStreamOut::Supported()
 {
-    #ifndef SGL_NO_STATUS_CHECK
-    if ( _primitiveType != POINTS
-         && _primitiveType != LINES
-         && _primitiveType != TRIANGLES ) 
+    return GLEW_VERSION_3_0 == GL_TRUE;
+}
+
+SGL_HRESULT GLStreamOut::SetPrimitiveType(PRIMITIVE_TYPE primitiveType_)
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if ( primitiveType_ != POINTS
+         && primitiveType_ != LINES
+         && primitiveType_ != TRIANGLES )
     {
         return EInvalidCall("GLStreamOut::SetPrimitiveType failed. Primitive type is not POINTS, LINES or TRIANGLES");
     }
-    #endif
 
-    primitiveType = _primitiveType;
+    if (active) {
+        return EInvalidCall("GLStreamOut::SetPrimitiveType failed. Stream output is active.");
+    }
+#endif
+
+    primitiveType = primitiveType_;
     return SGL_OK;
 }
 
-SGL_HRESULT SGL_DLLCALL GLStreamOut::SetStreamOutDecl(unsigned int numEntries, DeclarationEntry* soDecl)
+SGL_HRESULT GLStreamOut::SetTargets( unsigned int       numEntries,
+                                     VertexBuffer**     vbos,
+                                     const unsigned*    offsets )
 {
-    // copy declaration
-    declaration.resize(numEntries);
-    std::copy( soDecl, soDecl + numEntries, declaration.begin() );
+#ifndef SGL_NO_STATUS_CHECK
+    if (active) {
+        return EInvalidCall("GLStreamOut::SetTargets failed. Stream output is active.");
+    }
+
+    if ( numEntries > device->Traits()->NumberOfStreamOutBuffers() ) {
+        return EUnsupported("GLStreamOut::SetTargets failed. Too many stream output targets.");
+    }
 
-    // make utility structures
-    if (feedbackVaryings) 
+    for (unsigned int i = 0; i<numEntries; ++i)
     {
-        for(size_t i = 0; i<declaration.size(); ++i) {
-            free(feedbackVaryings[i]);
+        if (!vbos[i]) {
+            return EInvalidCall("GLStreamOut::SetTargets failed. Vertex buffer target can't be 0");
         }
-        free(feedbackVaryings);
-    }   
-    feedbackVaryings = (char**)malloc( declaration.size() * sizeof(char*) );
-    
+
+        if ( offsets && (offsets[i] % 4) != 0 ) {
+            return EInvalidCall("GLStreamOut::SetTargets failed. Target offset must be multiple of 4.");
+        }
+    }
+#endif
+
+    targets.resize(numEntries);
+    targetOffsets.resize(numEntries);
+    for (unsigned int i = 0; i<numEntries; ++i)
+    {
+        targets[i].reset(vbos[i]);
+        targetOffsets[i] = offsets ? offsets[i] : 0;
+    }
 
     return SGL_OK;
 }
 
-SGL_HRESULT SGL_DLLCALL GLStreamOut::SetTargets(unsigned int numEntries, VertexBuffer** vbos)
+SGL_HRESULT GLStreamOut::SetQuery(Query* query_)
 {
-    // check
-    for(unsigned int i = 0; i<numEntries; ++i) 
+#ifndef SGL_NO_STATUS_CHECK
+    if (active) {
+        return EInvalidCall("GLStreamOut::SetQuery failed. Stream output is active.");
+    }
+
+    if ( query_
+         && query_->Type() != Query::TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN
+         && query_->Type() != Query::PRIMITIVES_GENERATED )
     {
-        if (!vbos[i]) {
-            return EInvalidCall("GLStreamOut::SetTargets failed. Vertex buffer target can't be 0");
+        return EInvalidCall("GLStreamOut::SetQuery failed. Query doesn't count primitives.");
+    }
+#endif
+
+    query.reset(query_);
+    return SGL_OK;
+}
+
+SGL_HRESULT GLStreamOut::Begin()
+{
+    const Program* program = device->CurrentProgram();
+
+#ifndef SGL_NO_STATUS_CHECK
+    if (active) {
+        return EInvalidCall("GLStreamOut::Begin failed. Stream output is already active.");
+    }
+
+    if ( targets.empty() ) {
+        return EInvalidCall("GLStreamOut::Begin failed. Stream output doesn't have targets.");
+    }
+
+    if ( !program || program->NumTransformFeedbackVaryings() == 0 ) {
+        return EInvalidCall("GLStreamOut::Begin failed. Bound program doesn't capture varyings.");
+    }
+
+    if ( program->TransformFeedbackMode() == Program::SEPARATE_ATTRIBS
+         && targets.size() < program->NumTransformFeedbackVaryings() )
+    {
+        return EInvalidCall("GLStreamOut::Begin failed. Every separate varying requires its own target.");
+    }
+
+    for (size_t i = 0; i<targets.size(); ++i)
+    {
+        if ( BufferHandle( targets[i].get() ) == 0 || targetOffsets[i] >= targets[i]->Size() ) {
+            return EInvalidCall("GLStreamOut::Begin failed. Target offset is out of the buffer.");
         }
     }
+#endif
 
-    // copy
-    targets.resize(numEntries);
-    for(unsigned int i = 0; i<numEntries; ++i) {
-        targets[i].reset( static_cast<GLVertexBuffer*>(vbos[i]) );
+    // indexed bindings are used only during capture, so they are not cached
+    GLuint glBuffer = 0;
+    for (size_t i = 0; i<targets.size(); ++i)
+    {
+        glBuffer = BufferHandle( targets[i].get() );
+        if (targetOffsets[i] == 0) {
+            glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, i, glBuffer);
+        }
+        else
+        {
+            glBindBufferRange( GL_TRANSFORM_FEEDBACK_BUFFER,
+                               i,
+                               glBuffer,
+                               targetOffsets[i],
+                               targets[i]->Size() - targetOffsets[i] );
+        }
+    }
+
+    // indexed binding also replaces generic binding
+    device->StateCache().boundBuffer[GLDevice::TRANSFORM_FEEDBACK_BUFFER] = glBuffer;
+
+    if (rasterizerDiscard) {
+        glEnable(GL_RASTERIZER_DISCARD);
     }
 
+    if (query)
+    {
+        SGL_HRESULT result = query->Begin();
+        if (result != SGL_OK)
+        {
+            if (rasterizerDiscard) {
+                glDisable(GL_RASTERIZER_DISCARD);
+            }
+            return result;
+        }
+    }
+
+    glBeginTransformFeedback(BIND_PRIMITIVE_TYPE[primitiveType]);
+    active = true;
+    paused = false;
+
+#ifndef SGL_NO_STATUS_CHECK
+    return CheckGLError("GLStreamOut::Begin failed: ", device->PollError());
+#else
     return SGL_OK;
+#endif
 }
 
-SGL_HRESULT SGL_DLLCALL GLStreamOut::Dirty(bool force)
+SGL_HRESULT GLStreamOut::End()
 {
-    if (!force && !dirty) {
-        return SGL_OK;
+#ifndef SGL_NO_STATUS_CHECK
+    if (!active) {
+        return EInvalidCall("GLStreamOut::End failed. Stream output is not active.");
     }
+#endif
 
-    return SGL_OK;
+    glEndTransformFeedback();
+    if (rasterizerDiscard) {
+        glDisable(GL_RASTERIZER_DISCARD);
+    }
+
+    active = false;
+    paused = false;
+
+    // query is ended anyway, so it doesn't stay active after the failure
+    SGL_HRESULT result = query ? query->End() : SGL_OK;
+#ifndef SGL_NO_STATUS_CHECK
+    if (result == SGL_OK) {
+        result = CheckGLError("GLStreamOut::End failed: ", device->PollError());
+    }
+#endif
+
+    return result;
 }
 
-SGL_HRESULT SGL_DLLCALL GLStreamOut::Bind() const
+SGL_HRESULT GLStreamOut::Pause()
 {
-    return SGL_OK;
+#ifndef SGL_NO_STATUS_CHECK
+    if (!active || paused) {
+        return EInvalidCall("GLStreamOut::Pause failed. Stream output is not active or already paused.");
+    }
+#endif
+
+#ifdef GL_ARB_transform_feedback2
+    if (GLEW_ARB_transform_feedback2)
+    {
+        glPauseTransformFeedback();
+        if (rasterizerDiscard) {
+            glDisable(GL_RASTERIZER_DISCARD);
+        }
+        paused = true;
+
+    #ifndef SGL_NO_STATUS_CHECK
+        return CheckGLError("GLStreamOut::Pause failed: ", device->PollError());
+    #else
+        return SGL_OK;
+    #endif
+    }
+#endif
+
+    return EUnsupported("GLStreamOut::Pause failed. ARB_transform_feedback2 is not supported.");
 }
 
-void SGL_DLLCALL GLStreamOut::Unbind() const
+SGL_HRESULT GLStreamOut::Resume()
 {
+#ifndef SGL_NO_STATUS_CHECK
+    if (!paused) {
+        return EInvalidCall("GLStreamOut::Resume failed. Stream output is not paused.");
+    }
+#endif
+
+#ifdef GL_ARB_transform_feedback2
+    if (rasterizerDiscard) {
+        glEnable(GL_RASTERIZER_DISCARD);
+    }
+    glResumeTransformFeedback();
+    paused = false;
+#endif
+
+#ifndef SGL_NO_STATUS_CHECK
+    return CheckGLError("GLStreamOut::Resume failed: ", device->PollError());
+#else
+    return SGL_OK;
+#endif
 }
+
+} // namespace sgl
+
+#endif // !defined(SIMPLE_GL_ES)
@@ -0,0 +1,241 @@
+#include "GL/GLCommon.h"
+#include "GL/GLDevice.h"
+#include "GL/GLBuffer.h"
+#include "GL/GLStreamingBuffer.h"
+#include <algorithm>
+
+namespace {
+
+    inline unsigned align(unsigned offset, unsigned alignment)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+} // anonymous namespace
+
+namespace sgl {
+
+GLStreamingBuffer::GLStreamingBuffer( GLDevice*      device_,
+                                      sgl::Buffer*   buffer_,
+                                      const DESC&    desc ) :
+    device(device_),
+    buffer(buffer_),
+    mode(STAGING),
+    fenced(false),
+    numRegions( std::max(desc.numRegions, 1u) ),
+    regionSize(desc.size / numRegions),
+    region(0),
+    regionOffset(0),
+    pendingOffset(0),
+    pendingSize(0),
+    persistentData(0),
+    fences(numRegions, 0)
+{
+    const unsigned size = regionSize * numRegions;
+    if ( SGL_OK != buffer->SetData(size, 0, Buffer::STREAM_DRAW) ) {
+        throw gl_error("GLStreamingBuffer::GLStreamingBuffer failed. Can't allocate buffer.");
+    }
+
+#ifndef SIMPLE_GL_ES
+    fenced = (GLEW_ARB_sync == GL_TRUE);
+
+#ifdef GL_ARB_buffer_storage
+    // whole buffer stays mapped, coherent writes need no flushes
+    if (GLEW_ARB_buffer_storage && fenced)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        guarded_buffer_binding binding( device, GL_COPY_WRITE_BUFFER, BufferHandle(buffer_) );
+        glBufferStorage(GL_COPY_WRITE_BUFFER, size, 0, flags);
+        persistentData = static_cast<char*>( glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags) );
+        if (persistentData) {
+            mode = PERSISTENT;
+        }
+    }
+#endif
+
+    if ( mode != PERSISTENT && (GLEW_VERSION_3_0 || GLEW_ARB_map_buffer_range) ) {
+        mode = MAP_RANGE;
+    }
+#endif // !defined(SIMPLE_GL_ES)
+
+    if (mode == STAGING) {
+        staging.resize(size);
+    }
+
+#ifndef SGL_NO_STATUS_CHECK
+    GLenum glError = glGetError();
+    if ( glError != GL_NO_ERROR )
+    {
+        CheckGLError("GLStreamingBuffer::GLStreamingBuffer failed: ", glError);
+        throw gl_error("GLStreamingBuffer::GLStreamingBuffer failed");
+    }
+#endif
+}
+
+GLStreamingBuffer::~GLStreamingBuffer()
+{
+    if ( !device->Valid() ) {
+        return;
+    }
+
+#ifndef SIMPLE_GL_ES
+    if (pendingSize > 0 && mode == MAP_RANGE) {
+        buffer->Unmap();
+    }
+
+    if (mode == PERSISTENT)
+    {
+        guarded_buffer_binding binding( device, GL_COPY_WRITE_BUFFER, BufferHandle(buffer.get()) );
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    }
+
+    for (size_t i = 0; i < fences.size(); ++i)
+    {
+        if (fences[i]) {
+            glDeleteSync( static_cast<GLsync>(fences[i]) );
+        }
+    }
+#endif
+}
+
+void* GLStreamingBuffer::Allocate(unsigned size, unsigned alignment, unsigned& offset)
+{
+    if (size > regionSize)
+    {
+        sglSetError(SGLERR_INVALID_CALL, "GLStreamingBuffer::Allocate failed. Size of the chunk exceeds size of the region.");
+        return 0;
+    }
+
+    // only one range can be mapped at once
+    if ( pendingSize > 0 && SGL_OK != Commit() ) {
+        return 0;
+    }
+
+    alignment = std::max(alignment, 1u);
+
+    unsigned base   = region * regionSize;
+    unsigned cursor = align(base + regionOffset, alignment);
+    if (cursor + size > base + regionSize)
+    {
+        if ( SGL_OK != NextRegion() ) {
+            return 0;
+        }
+
+        base   = region * regionSize;
+        cursor = align(base, alignment);
+        if (cursor + size > base + regionSize)
+        {
+            sglSetError(SGLERR_INVALID_CALL, "GLStreamingBuffer::Allocate failed. Aligned chunk exceeds size of the region.");
+            return 0;
+        }
+    }
+
+    regionOffset = cursor + size - base;
+    offset       = cursor;
+
+    switch (mode)
+    {
+        case PERSISTENT:
+            return persistentData + cursor;
+
+    #ifndef SIMPLE_GL_ES
+        case MAP_RANGE:
+        {
+            // region is released by the fence, so driver needn't synchronize
+            int hint = Buffer::MAP_WRITE_BIT | Buffer::MAP_INVALIDATE_RANGE_BIT;
+            if (fenced) {
+                hint |= Buffer::MAP_UNSYNCHRONIZED_BIT;
+            }
+
+            void* data = 0;
+            if ( SGL_OK != buffer->MapRange(cursor, size, hint, &data) ) {
+                return 0;
+            }
+
+            pendingOffset = cursor;
+            pendingSize   = size;
+            return data;
+        }
+    #endif
+
+        default:
+            pendingOffset = cursor;
+            pendingSize   = size;
+            return &staging[cursor];
+    }
+}
+
+SGL_HRESULT GLStreamingBuffer::Commit()
+{
+    if (pendingSize == 0) {
+        return SGL_OK;
+    }
+
+    SGL_HRESULT result = SGL_OK;
+#ifndef SIMPLE_GL_ES
+    if (mode == MAP_RANGE) {
+        result = buffer->Unmap();
+    }
+    else
+#endif
+    if (mode == STAGING) {
+        result = buffer->SetSubData(pendingOffset, pendingSize, &staging[pendingOffset]);
+    }
+
+    pendingSize = 0;
+    return result;
+}
+
+SGL_HRESULT GLStreamingBuffer::EndFrame()
+{
+    SGL_HRESULT result = Commit();
+    if (SGL_OK != result) {
+        return result;
+    }
+
+    // nothing to guard
+    if (regionOffset == 0) {
+        return SGL_OK;
+    }
+
+    return NextRegion();
+}
+
+SGL_HRESULT GLStreamingBuffer::NextRegion()
+{
+#ifndef SIMPLE_GL_ES
+    if (fenced)
+    {
+        if (fences[region]) {
+            glDeleteSync( static_cast<GLsync>(fences[region]) );
+        }
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#endif
+
+    region       = (region + 1) % numRegions;
+    regionOffset = 0;
+
+#ifndef SIMPLE_GL_ES
+    if (fenced && fences[region])
+    {
+        GLsync fence  = static_cast<GLsync>(fences[region]);
+        GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        while (status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(fence, 0, 1000000000);
+        }
+
+        glDeleteSync(fence);
+        fences[region] = 0;
+
+        if (status == GL_WAIT_FAILED) {
+            return CheckGLError("GLStreamingBuffer::NextRegion failed: ", glGetError());
+        }
+    }
+#endif
+
+    return SGL_OK;
+}
+
+} // namespace sgl
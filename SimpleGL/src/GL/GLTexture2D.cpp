@@ -1,4 +1,5 @@
 #include "GL/GLCommon.h"
+#include "GL/GLReadbackRequest.h"
 #include "GL/GLTexture2D.h"
 
 namespace sgl {
@@ -122,7 +123,7 @@ SGL_HRESULT GLTexture2D::SetSubImage( unsigned int  mipmap,
     // save previous state & bind texture
     guarded_binding_ptr guardedTexture( new guarded_binding(device, this, 0) );
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture2D<DeviceVersion>::SetSubImage failed: ", glError );
     }
@@ -153,9 +154,10 @@ SGL_HRESULT GLTexture2D::SetSubImage( unsigned int  mipmap,
                          glPixelType,
                          data );
     }
+    SGL_FRAME_STATISTICS(device, numBytesUploaded, Image::SizeOfData(format, regionWidth, regionHeight, 1));
 
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture2D<DeviceVersion>::SetSubImage failed: ", glError );
     }
@@ -186,7 +188,7 @@ SGL_HRESULT GLTexture2D::GetImage( unsigned int  mipmap,
     // save previous state & bind texture
     guarded_binding_ptr guardedTexture( new guarded_binding(device, this, 0) );
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture2D<DeviceVersion>::GetImage failed: ", glError );
     }
@@ -207,9 +209,10 @@ SGL_HRESULT GLTexture2D::GetImage( unsigned int  mipmap,
                       glPixelType,
                       data);
     }
+    SGL_FRAME_STATISTICS(device, numGetQueries, 1);
 
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture2D<DeviceVersion>::GetImage failed: ", glError );
     }
@@ -219,12 +222,29 @@ SGL_HRESULT GLTexture2D::GetImage( unsigned int  mipmap,
 }
 #endif
 
+ReadbackRequest* GLTexture2D::Readback(unsigned int mipmap)
+{
+#ifdef SIMPLE_GL_ES
+    sglSetError(SGLERR_UNSUPPORTED, "GLTexture2D::Readback failed. Unsupported in GLES.");
+    return 0;
+#else
+    if (numSamples > 0)
+    {
+        sglSetError(SGLERR_INVALID_CALL, "GLTexture2D::Readback failed. Can't read multisample texture.");
+        return 0;
+    }
+
+    guarded_binding_ptr guardedTexture( new guarded_binding(device, this, 0) );
+    return GLReadbackRequest::ReadTexImage(device, glTarget, mipmap, format, width, height);
+#endif
+}
+
 SGL_HRESULT GLTexture2D::GenerateMipmap()
 {
     guarded_binding_ptr guardedTexture( new guarded_binding(device, this, 0) );
 
 #ifndef SGL_NO_STATUS_CHECK
-    GLenum glError = glGetError();
+    GLenum glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture2D<DeviceVersion>::GenerateMipmap failed: ", glError );
     }
@@ -265,7 +285,7 @@ SGL_HRESULT GLTexture2D::GenerateMipmap()
 #endif
 
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture2D<DeviceVersion>::GenerateMipmap failed: ", glError );
     }
@@ -312,6 +332,7 @@ SGL_HRESULT GLTexture2D::Bind(unsigned int stage_) const
     glEnable(glTarget);
     glBindTexture(glTarget, glTexture);
 
+    SGL_FRAME_STATISTICS(device, numTextureBinds, 1);
     device->SetTexture(stage, this);
     return SGL_OK;
 }
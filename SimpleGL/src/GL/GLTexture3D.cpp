@@ -135,7 +135,7 @@ SGL_HRESULT GLTexture3D::SetSubImage( unsigned int  mipmap,
     // save previous state & bind texture
     guarded_binding_ptr guardedTexture( new guarded_binding(device, this, 0) );
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture3D<DeviceVersion>::SetSubImage failed: ", glError );
     }
@@ -170,9 +170,10 @@ SGL_HRESULT GLTexture3D::SetSubImage( unsigned int  mipmap,
                          glPixelType,
                          data );
     }
+    SGL_FRAME_STATISTICS(device, numBytesUploaded, Image::SizeOfData(format, regionWidth, regionHeight, regionDepth));
 
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture3D<DeviceVersion>::SetSubImage failed: ", glError );
     }
@@ -196,7 +197,7 @@ SGL_HRESULT GLTexture3D::GetImage( unsigned int  mipmap,
     // save previous state & bind texture
     guarded_binding_ptr guardedTexture( new guarded_binding(device, this, 0) );
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture3D<DeviceVersion>::GetImage failed: ", glError );
     }
@@ -217,9 +218,10 @@ SGL_HRESULT GLTexture3D::GetImage( unsigned int  mipmap,
                       glPixelType,
                       data);
     }
+    SGL_FRAME_STATISTICS(device, numGetQueries, 1);
 
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture3D<DeviceVersion>::GetImage failed: ", glError );
     }
@@ -233,7 +235,7 @@ SGL_HRESULT GLTexture3D::GenerateMipmap()
     guarded_binding_ptr guardedTexture( new guarded_binding(device, this, 0) );
 
 #ifndef SGL_NO_STATUS_CHECK
-    GLenum glError = glGetError();
+    GLenum glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture3D<DeviceVersion>::GenerateMipmap failed: ", glError );
     }
@@ -247,7 +249,7 @@ SGL_HRESULT GLTexture3D::GenerateMipmap()
     }
 
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTexture3D<DeviceVersion>::GenerateMipmap failed: ", glError );
     }
@@ -267,6 +269,7 @@ SGL_HRESULT GLTexture3D::Bind(unsigned int stage_) const
     stage = stage_;
     glActiveTexture(GL_TEXTURE0 + stage);
     glBindTexture(glTarget, glTexture);
+    SGL_FRAME_STATISTICS(device, numTextureBinds, 1);
     device->SetTexture(stage, this);
 
     return SGL_OK;
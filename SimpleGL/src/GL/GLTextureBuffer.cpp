@@ -1,80 +1,167 @@
-#include "GL/GLTexture1D.h"
-#include <string>
+#include "GL/GLCommon.h"
+#include "GL/GLBuffer.h"
+#include "GL/GLTextureBuffer.h"
 
-using namespace sgl;
+#ifndef SIMPLE_GL_ES
 
-GLTexture1D::GLTexture1D(Device* _pDevice) :
-    GLTexture<Texture1D>(_pDevice, GL_TEXTURE_1D, GL_TEXTURE_1D, 0),
+namespace sgl {
+
+GLTextureBuffer::GLTextureBuffer(GLDevice* device_) :
+    GLTexture<TextureBuffer>(device_, GL_TEXTURE_BUFFER),
+    format(UNKNOWN),
+    offset(0),
     size(0),
-    format(RGBA8),
-    resizeNonPowerOfTwo(true)
+    attachedBuffer(0),
+    attachedSize(0)
 {
 }
 
-GLTexture1D::~GLTexture1D()
+GLTextureBuffer::~GLTextureBuffer()
 {
-    if (glTarget == GL_TEXTURE_1D && glTexture) {
-        glDeleteTextures(1, &glTexture);
+    if (device->Valid()) {
+        Unbind();
     }
 }
 
-void SGL_DLLCALL GLTexture1D::Clear()
+bool GLTextureBuffer::Supported()
 {
-    size = 0;
+    return GLEW_VERSION_3_1 || GLEW_ARB_texture_buffer_object;
+}
 
-    if (glTexture) {
-        glDeleteTextures(1, &glTexture);
+unsigned int GLTextureBuffer::Size() const
+{
+    if (size > 0) {
+        return size;
     }
-    glTexture = 0;
+
+    return (buffer && buffer->Size() > offset) ? buffer->Size() - offset : 0;
 }
 
-// creation
-SGL_HRESULT GLTexture1D::SetImage(FORMAT _format, unsigned int _size, const void* data)
+unsigned int GLTextureBuffer::NumTexels() const
 {
-    // clear error flags
-    glGetError();
+    unsigned int texelSize = Texture::FORMAT_TRAITS[format].sizeInBits / 8;
+    return texelSize > 0 ? Size() / texelSize : 0;
+}
+
+SGL_HRESULT GLTextureBuffer::SetBuffer( Buffer*         buffer_,
+                                        FORMAT          format_,
+                                        unsigned int    offset_,
+                                        unsigned int    size_ )
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if ( format_ == UNKNOWN
+         || Texture::FORMAT_TRAITS[format_].depth
+         || Texture::FORMAT_TRAITS[format_].compressed )
+    {
+        return EInvalidCall("GLTextureBuffer::SetBuffer failed. Texture buffer can't have depth or compressed format.");
+    }
 
-    if ( !glTexture ) {
-        glGenTextures(1, &glTexture);
+    if ( BIND_GL_FORMAT[format_] == 0 ) {
+        return EUnsupported("GLTextureBuffer::SetBuffer failed. Format is not supported.");
     }
 
-    // copy glTexture
-    size = _size;
-    format = _format;
+    if (buffer_)
+    {
+        if ( BufferHandle(buffer_) == 0 ) {
+            return EInvalidCall("GLTextureBuffer::SetBuffer failed. Buffer doesn't have storage.");
+        }
 
-    // image settings
-	GLenum glUsage = BIND_GL_FORMAT_USAGE[format];
-	GLenum glPixelType = BIND_GL_FORMAT_PIXEL_TYPE[format];
-    GLenum glFormat = BIND_GL_FORMAT[format];
+        if ( offset_ >= buffer_->Size() || offset_ + size_ > buffer_->Size() ) {
+            return EInvalidCall("GLTextureBuffer::SetBuffer failed. Texel range is out of the buffer.");
+        }
 
-    // save previous state & bind texture
-    texture_value oldTexValue;
-    GuardedBind(oldTexValue);
+        if ( (offset_ % device->Traits()->TextureBufferOffsetAlignment()) != 0 ) {
+            return EInvalidCall("GLTextureBuffer::SetBuffer failed. Offset is not aligned to DeviceTraits::TextureBufferOffsetAlignment.");
+        }
 
-    // copy image
-    glTexImage1D(glTarget, 0, glFormat, size, 0, glUsage, glPixelType, data);
+        unsigned int rangeSize = (size_ > 0) ? size_ : buffer_->Size() - offset_;
+        if ( rangeSize / (Texture::FORMAT_TRAITS[format_].sizeInBits / 8) > device->Traits()->MaxTextureBufferSize() ) {
+            return EUnsupported("GLTextureBuffer::SetBuffer failed. Texel range exceeds DeviceTraits::MaxTextureBufferSize.");
+        }
 
-	// check error
-    GLenum error = glGetError();
-    if ( error != GL_NO_ERROR )
-    {
-		glDeleteTextures(1, &glTexture);
-        glTexture = 0;
-        return CheckGLError( "GLTexture1D::SetImage failed: ", error );
+    #ifdef GL_ARB_texture_buffer_range
+        if ( (offset_ > 0 || size_ > 0) && !GLEW_ARB_texture_buffer_range )
+    #else
+        if (offset_ > 0 || size_ > 0)
+    #endif
+        {
+            return EUnsupported("GLTextureBuffer::SetBuffer failed. Texel range requires ARB_texture_buffer_range.");
+        }
+    }
+#endif
+
+    buffer.reset(buffer_);
+    format         = format_;
+    offset         = offset_;
+    size           = size_;
+    attachedBuffer = GLuint(-1); // force attachment, even if buffer is detached
+    attachedSize   = 0;
+
+    // rebind immediately if bound, so the uniforms set before are still valid
+    if ( stage >= 0 && device->CurrentTexture(stage) == this ) {
+        return Bind(stage);
     }
 
-    // return binding
-    GuardedUnbind(oldTexValue);
     return SGL_OK;
 }
 
-void GLTexture1D::SetResizeNonPowerOfTwoHint(bool toggle)
+void GLTextureBuffer::AttachBuffer() const
+{
+    // buffer objects may be recreated by SetData, so the handle is compared each bind
+    GLuint       glBuffer = BufferHandle( buffer.get() );
+    unsigned int glSize   = Size();
+    if (glBuffer == attachedBuffer && glSize == attachedSize) {
+        return;
+    }
+
+#ifdef GL_ARB_texture_buffer_range
+    if (glBuffer && (offset > 0 || size > 0)) {
+        glTexBufferRange(glTarget, BIND_GL_FORMAT[format], glBuffer, offset, glSize);
+    }
+    else
+#endif
+    {
+        glTexBuffer(glTarget, BIND_GL_FORMAT[format], glBuffer);
+    }
+
+    attachedBuffer = glBuffer;
+    attachedSize   = glSize;
+}
+
+SGL_HRESULT GLTextureBuffer::Bind(unsigned int stage_) const
 {
-    resizeNonPowerOfTwo = toggle;
+#ifndef SGL_NO_STATUS_CHECK
+    if ( stage_ >= Device::NUM_TEXTURE_STAGES ) {
+        return EInvalidCall("GLTextureBuffer::Bind failed. Stage is too large.");
+    }
+#endif
+
+    stage = stage_;
+    glActiveTexture(GL_TEXTURE0 + stage);
+    glBindTexture(glTarget, glTexture);
+    AttachBuffer();
+
+    SGL_FRAME_STATISTICS(device, numTextureBinds, 1);
+    device->SetTexture(stage, this);
+
+#ifndef SGL_NO_STATUS_CHECK
+    return CheckGLError("GLTextureBuffer::Bind failed: ", device->PollError());
+#else
+    return SGL_OK;
+#endif
 }
 
-// work
-GLenum SGL_DLLCALL GLTexture1D::GLFormat() const
+void GLTextureBuffer::Unbind() const
 {
-    return BIND_GL_FORMAT[format];
+    if ( stage >= 0 && device->CurrentTexture(stage) == this )
+    {
+        glActiveTexture(GL_TEXTURE0 + stage);
+        glBindTexture(glTarget, 0);
+        device->SetTexture(stage, 0);
+        stage = -1;
+    }
 }
+
+} // namespace sgl
+
+#endif // !defined(SIMPLE_GL_ES)
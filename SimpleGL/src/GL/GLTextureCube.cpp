@@ -1,4 +1,5 @@
 #include "GL/GLCommon.h"
+#include "GL/GLReadbackRequest.h"
 #include "GL/GLTextureCube.h"
 
 namespace sgl {
@@ -81,7 +82,7 @@ SGL_HRESULT GLTextureCubeSide::SetSubImage( unsigned int  mipmap,
     // save previous state & bind texture
     guarded_binding_ptr guardedTexture( new guarded_binding(device, texture, 0) );
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTextureCubeSide<DeviceVersion>::SetSubImage failed: ", glError );
     }
@@ -112,9 +113,10 @@ SGL_HRESULT GLTextureCubeSide::SetSubImage( unsigned int  mipmap,
                          glPixelType,
                          data );
     }
+    SGL_FRAME_STATISTICS(device, numBytesUploaded, Image::SizeOfData(format, regionWidth, regionHeight, 1));
 
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTextureCubeSide<DeviceVersion>::SetSubImage failed: ", glError );
     }
@@ -144,7 +146,7 @@ SGL_HRESULT GLTextureCubeSide::GetImage( unsigned int  mipmap,
     // save previous state & bind texture
     guarded_binding_ptr guardedTexture( new guarded_binding(device, texture, 0) );
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTextureCubeSide<DeviceVersion>::GetImage failed: ", glError );
     }
@@ -165,9 +167,10 @@ SGL_HRESULT GLTextureCubeSide::GetImage( unsigned int  mipmap,
                       glPixelType,
                       data);
     }
+    SGL_FRAME_STATISTICS(device, numGetQueries, 1);
 
 #ifndef SGL_NO_STATUS_CHECK
-    glError = glGetError();
+    glError = device->PollError();
     if ( glError != GL_NO_ERROR ) {
         return CheckGLError( "GLTextureCubeSide::GetImage failed: ", glError );
     }
@@ -177,6 +180,17 @@ SGL_HRESULT GLTextureCubeSide::GetImage( unsigned int  mipmap,
 }
 #endif
 
+ReadbackRequest* GLTextureCubeSide::Readback(unsigned int mipmap)
+{
+#ifdef SIMPLE_GL_ES
+    sglSetError(SGLERR_UNSUPPORTED, "GLTextureCubeSide::Readback failed. Not supported in GLES.");
+    return 0;
+#else
+    guarded_binding_ptr guardedTexture( new guarded_binding(device, texture, 0) );
+    return GLReadbackRequest::ReadTexImage(device, GL_TEXTURE_CUBE_MAP_POSITIVE_X + side, mipmap, format, width, height);
+#endif
+}
+
 //================================= GLTextureCube =================================//
 
 GLTextureCube::GLTextureCube( GLDevice*  device_,
@@ -200,7 +214,7 @@ SGL_HRESULT GLTextureCube::GenerateMipmap()
     {
         glGenerateMipmapEXT(glTarget);
     #ifndef SGL_NO_STATUS_CHECK
-        GLenum glError = glGetError();
+        GLenum glError = device->PollError();
         if ( glError != GL_NO_ERROR ) {
             return CheckGLError( "GLTextureCube::GenerateMipmap failed: ", glError );
         }
@@ -285,6 +299,7 @@ SGL_HRESULT GLTextureCube::Bind(unsigned int stage_) const
     glEnable(glTarget);
     glBindTexture(glTarget, glTexture);
 
+    SGL_FRAME_STATISTICS(device, numTextureBinds, 1);
     device->SetTexture(stage, this);
     return SGL_OK;
 }
@@ -1,10 +1,53 @@
 #include "GL/GLUniform.h"
+#include "GL/GLProgram.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+    // array elements are not guaranteed to have consecutive locations, so look them up by name
+    GLint element_location(GLuint glProgram, GLint glLocation, const std::string& name, size_t index)
+    {
+        if (index == 0) {
+            return glLocation;
+        }
+
+        // active uniform name of the array can end with [0]
+        std::string arrayName = name;
+        if ( arrayName.size() > 3 && arrayName.compare(arrayName.size() - 3, 3, "[0]") == 0 ) {
+            arrayName.resize(arrayName.size() - 3);
+        }
+
+        char subscript[16];
+        sprintf(subscript, "[%u]", unsigned(index));
+        return glGetUniformLocation( glProgram, (arrayName + subscript).c_str() );
+    }
+
+} // anonymous namespace
 
 // uniforms
 namespace sgl {
 
 using namespace math;
 
+template<typename T>
+void GLUniform<T>::Store(const T* newValues, size_t count)
+{
+    assert( base_type::device->CurrentProgram() == base_type::program );
+    count = std::min(count, numValues);
+    if ( count <= numValidValues && memcmp(&values[0], newValues, count * sizeof(T)) == 0 ) {
+        return;
+    }
+
+    std::copy(newValues, newValues + count, values.begin());
+    if (numDirtyValues == 0) {
+        static_cast<const GLProgram*>(base_type::program)->QueueUniform(this);
+    }
+    numValidValues = std::max(numValidValues, count);
+    numDirtyValues = std::max(numDirtyValues, count);
+}
+
 #define DEFINE_UNIFORM(UTYPE, CTYPE, CAST_TYPE, setFunction, getFunction)\
     template<>\
     AbstractUniform::TYPE GLUniform<CTYPE>::Type() const\
@@ -14,30 +57,39 @@ using namespace math;
     template<>\
     void GLUniform<CTYPE>::Set(const CTYPE& value)\
     {\
-        assert( device->CurrentProgram() == program );\
-        setFunction(glLocation, 1, (CAST_TYPE*)&value);\
+        Store(&value, 1);\
     }\
     template<>\
-    void GLUniform<CTYPE>::Set(const CTYPE*  values,\
+    void GLUniform<CTYPE>::Set(const CTYPE*  newValues,\
                                unsigned int  count)\
     {\
-        assert( device->CurrentProgram() == program );\
-        setFunction(glLocation, count, (CAST_TYPE*)values);\
+        Store(newValues, count);\
+    }\
+    template<>\
+    void GLUniform<CTYPE>::Flush()\
+    {\
+        setFunction(glLocation, numDirtyValues, (CAST_TYPE*)&values[0]);\
+        SGL_FRAME_STATISTICS(device, numUniformCalls, 1);\
+        numDirtyValues = 0;\
     }\
     template<>\
     CTYPE GLUniform<CTYPE>::Value() const\
     {\
-        assert( device->CurrentProgram() == program );\
+        if (numValidValues > 0) {\
+            return values[0];\
+        }\
         CTYPE v;\
         getFunction(glProgram, glLocation, (CAST_TYPE*)&v);\
+        SGL_FRAME_STATISTICS(device, numGetQueries, 1);\
         return v;\
     }\
     template<>\
-    void GLUniform<CTYPE>::QueryValues(CTYPE* values) const\
+    void GLUniform<CTYPE>::QueryValues(CTYPE* values_) const\
     {\
-        assert( device->CurrentProgram() == program );\
-        for(size_t i = 0; i<numValues; ++i)\
-            getFunction(glProgram, glLocation, (CAST_TYPE*)&values[i]);\
+        std::copy(values.begin(), values.begin() + numValidValues, values_);\
+        for(size_t i = numValidValues; i<numValues; ++i)\
+            getFunction(glProgram, element_location(glProgram, glLocation, name, i), (CAST_TYPE*)&values_[i]);\
+        SGL_FRAME_STATISTICS(device, numGetQueries, numValues - numValidValues);\
     }
 
     DEFINE_UNIFORM(INT,   int,      int,   glUniform1iv, glGetUniformiv)
@@ -66,29 +118,39 @@ using namespace math;
     template<>\
     void GLUniform<CTYPE>::Set(const CTYPE& value)\
     {\
-        assert( device->CurrentProgram() == program );\
-        setFunction(glLocation, 1, TRANSPOSE_MATRIX, (CAST_TYPE*)&value);\
+        Store(&value, 1);\
     }\
     template<>\
-    void GLUniform<CTYPE>::Set(const CTYPE* values,\
-                               unsigned int count)\
+    void GLUniform<CTYPE>::Set(const CTYPE*  newValues,\
+                               unsigned int  count)\
     {\
-        assert( device->CurrentProgram() == program );\
-        setFunction(glLocation, count, TRANSPOSE_MATRIX, (CAST_TYPE*)values);\
+        Store(newValues, count);\
+    }\
+    template<>\
+    void GLUniform<CTYPE>::Flush()\
+    {\
+        setFunction(glLocation, numDirtyValues, TRANSPOSE_MATRIX, (CAST_TYPE*)&values[0]);\
+        SGL_FRAME_STATISTICS(device, numUniformCalls, 1);\
+        numDirtyValues = 0;\
     }\
     template<>\
     CTYPE GLUniform<CTYPE>::Value() const\
     {\
-        assert( device->CurrentProgram() == program );\
+        if (numValidValues > 0) {\
+            return values[0];\
+        }\
         CTYPE v;\
         getFunction(glProgram, glLocation, (CAST_TYPE*)&v);\
+        SGL_FRAME_STATISTICS(device, numGetQueries, 1);\
         return v;\
     }\
     template<>\
-    void GLUniform<CTYPE>::QueryValues(CTYPE* values) const\
+    void GLUniform<CTYPE>::QueryValues(CTYPE* values_) const\
     {\
-        for(size_t i = 0; i<numValues; ++i)\
-            getFunction(glProgram, glLocation, (CAST_TYPE*)&values[i]);\
+        std::copy(values.begin(), values.begin() + numValidValues, values_);\
+        for(size_t i = numValidValues; i<numValues; ++i)\
+            getFunction(glProgram, element_location(glProgram, glLocation, name, i), (CAST_TYPE*)&values_[i]);\
+        SGL_FRAME_STATISTICS(device, numGetQueries, numValues - numValidValues);\
     }
 
     DEFINE_MATRIX_UNIFORM(MAT2x2F,  Matrix2x2f, float, glUniformMatrix2fv,      glGetUniformfv)
@@ -131,4 +193,10 @@ AbstractUniform::TYPE GLSamplerUniform<TextureCube>::Type() const
     return AbstractUniform::SAMPLER_CUBE;
 }
 
+template<>
+AbstractUniform::TYPE GLSamplerUniform<TextureBuffer>::Type() const
+{
+    return AbstractUniform::SAMPLER_BUFFER;
+}
+
 } // namespace sgl
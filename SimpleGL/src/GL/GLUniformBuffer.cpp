@@ -1,8 +1,72 @@
-#include "GL/GLConstantBuffer.h"
+#include "GL/GLUniformBuffer.h"
+#include "GL/GLCommon.h"
 
-using namespace sgl;
+#ifndef SIMPLE_GL_ES
 
-GLConstantBuffer::GLConstantBuffer(Device* _device) :
-    GLBuffer<ConstantBuffer>(_device, GL_UNIFORM_BUFFER_EXT, GL_STATIC_READ)
+namespace sgl {
+
+template<typename BufferImpl>
+GLUniformBuffer<BufferImpl>::GLUniformBuffer(GLDevice* device) :
+    BufferImpl(device, GL_UNIFORM_BUFFER)
+{
+}
+
+template<typename BufferImpl>
+GLUniformBuffer<BufferImpl>::~GLUniformBuffer()
+{
+    // indexed bindings are forgotten by the GLBuffer destructor
+}
+
+template<typename BufferImpl>
+SGL_HRESULT GLUniformBuffer<BufferImpl>::Bind(unsigned bindingPoint) const
+{
+#ifndef SGL_NO_STATUS_CHECK
+    if ( bindingPoint >= BufferImpl::device->Traits()->NumberOfUniformBufferBindings() ) {
+        return EInvalidCall("GLUniformBuffer::Bind failed. Binding point is out of range.");
+    }
+#endif
+
+    BufferImpl::device->BindUniformBuffer(bindingPoint, BufferImpl::glBuffer, 0, 0);
+    BufferImpl::MarkUsed();
+
+    return SGL_OK;
+}
+
+template<typename BufferImpl>
+SGL_HRESULT GLUniformBuffer<BufferImpl>::BindRange(unsigned bindingPoint, unsigned offset, unsigned size) const
 {
+#ifndef SGL_NO_STATUS_CHECK
+    const DeviceTraits* traits = BufferImpl::device->Traits();
+    if ( bindingPoint >= traits->NumberOfUniformBufferBindings() ) {
+        return EInvalidCall("GLUniformBuffer::BindRange failed. Binding point is out of range.");
+    }
+
+    if ( size == 0 || offset + size > BufferImpl::Size() ) {
+        return EInvalidCall("GLUniformBuffer::BindRange failed. Range is out of the buffer.");
+    }
+
+    if ( offset % traits->UniformBufferOffsetAlignment() != 0 ) {
+        return EInvalidCall("GLUniformBuffer::BindRange failed. Offset doesn't satisfy uniform buffer offset alignment.");
+    }
+#endif
+
+    BufferImpl::device->BindUniformBuffer(bindingPoint, BufferImpl::glBuffer, offset, size);
+    BufferImpl::MarkUsed();
+
+    return SGL_OK;
 }
+
+template<typename BufferImpl>
+void GLUniformBuffer<BufferImpl>::Unbind(unsigned bindingPoint) const
+{
+    if ( BufferImpl::device->BoundUniformBuffer(bindingPoint) == BufferImpl::glBuffer ) {
+        BufferImpl::device->BindUniformBuffer(bindingPoint, 0, 0, 0);
+    }
+}
+
+template class GLUniformBuffer< GLBufferDefault<UniformBuffer> >;
+template class GLUniformBuffer< GLBufferModern<UniformBuffer> >;
+
+} // namespace sgl
+
+#endif // !defined(SIMPLE_GL_ES)
@@ -25,8 +25,9 @@ GLVertexBuffer<BufferImpl>::~GLVertexBuffer()
 template<typename BufferImpl>
 void GLVertexBuffer<BufferImpl>::Bind(const VertexLayout* layout) const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, BufferImpl::glBuffer);
+    BufferImpl::device->BindBuffer(GL_ARRAY_BUFFER, BufferImpl::glBuffer);
     BufferImpl::device->SetVertexBuffer(this);
+    BufferImpl::MarkUsed();
 
     if (layout) {
         layout->Bind();
@@ -38,7 +39,7 @@ void GLVertexBuffer<BufferImpl>::Unbind() const
 {
     if (BufferImpl::device->CurrentVertexBuffer() == this)
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        BufferImpl::device->BindBuffer(GL_ARRAY_BUFFER, 0);
         BufferImpl::device->SetVertexBuffer(0);
     }
 }
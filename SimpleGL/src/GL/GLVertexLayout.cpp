@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <vector>
 
+#ifndef GL_INT_2_10_10_10_REV
+#   define GL_INT_2_10_10_10_REV 0x8D9F
+#endif
+
 namespace {
 
     using namespace sgl;
@@ -17,6 +21,28 @@ namespace {
 		}
 	};
 
+    /* Setup pointer of the enabled attribute */
+    void setup_attribute_pointer(const VertexLayout::ELEMENT& element)
+    {
+#ifndef SIMPLE_GL_ES
+        if (element.integer)
+        {
+            glVertexAttribIPointer( element.index,
+                                    element.size,
+                                    BIND_SCALAR_TYPE[element.type],
+                                    element.stride,
+                                    (GLvoid*)element.offset );
+            return;
+        }
+#endif
+        glVertexAttribPointer( element.index,
+                               element.size,
+                               BIND_SCALAR_TYPE[element.type],
+                               element.normalized,
+                               element.stride,
+                               (GLvoid*)element.offset );
+    }
+
 } // anonymous namespace
 
 namespace sgl {
@@ -38,9 +64,19 @@ const unsigned BIND_SCALAR_TYPE[__NUMBER_OF_SCALAR_TYPES__] =
 	GL_UNSIGNED_INT,
 	GL_FLOAT,
 #ifdef SIMPLE_GL_ES
+    0,
+#   ifdef GL_HALF_FLOAT_OES
+    GL_HALF_FLOAT_OES,
+#   else
+    0,
+#   endif
+    0,
     0
 #else
-    GL_DOUBLE
+    GL_DOUBLE,
+    GL_HALF_FLOAT,
+    GL_INT_2_10_10_10_REV,
+    GL_UNSIGNED_INT_2_10_10_10_REV
 #endif
 };
 
@@ -106,12 +142,7 @@ void GLVertexLayoutMixed::Bind() const
 
         case ATTRIBUTE:
             glEnableVertexAttribArray(elements[i].index);
-            glVertexAttribPointer( elements[i].index, 
-                                   elements[i].size, 
-                                   BIND_SCALAR_TYPE[ elements[i].type ], 
-                                   false, 
-                                   elements[i].stride, 
-                                   (GLvoid*)elements[i].offset );
+            setup_attribute_pointer(elements[i]);
             break;
 
         default:
@@ -172,10 +203,30 @@ GLVertexLayoutAttribute::GLVertexLayoutAttribute( GLDevice*    device_,
 GLVertexLayoutAttribute::~GLVertexLayoutAttribute()
 {
     Unbind();
+    if ( device->Valid() && device->VertexArrayObjects() ) {
+        device->ReleaseVertexArrays(this);
+    }
+}
+
+void GLVertexLayoutAttribute::SetupAttributes() const
+{
+    for (size_t i = 0; i<elements.size(); ++i)
+    {
+        glEnableVertexAttribArray(elements[i].index);
+        setup_attribute_pointer(elements[i]);
+    }
 }
 
 void GLVertexLayoutAttribute::Bind() const
 {
+    if ( device->VertexArrayObjects() )
+    {
+        // attributes are captured by the cached vertex array object on draw
+        device->SetVertexArrayLayout(this);
+        device->SetVertexLayout(this);
+        return;
+    }
+
     if ( const GLVertexLayoutAttribute* vertexLayout = static_cast<const GLVertexLayoutAttribute*>( device->CurrentVertexLayout() ) ) 
     {
         if (vertexLayout != this) 
@@ -198,12 +249,7 @@ void GLVertexLayoutAttribute::Bind() const
                         glEnableVertexAttribArray(index1);
                     }
 
-                    glVertexAttribPointer( index1,
-                                           elements[j].size,
-                                           BIND_SCALAR_TYPE[ elements[j].type ],
-                                           false,
-                                           elements[j].stride,
-                                           (GLvoid*)elements[j].offset );
+                    setup_attribute_pointer(elements[j]);
                     ++i; ++j;
                 }
             }
@@ -215,14 +261,7 @@ void GLVertexLayoutAttribute::Bind() const
             for (; j<elements.size(); ++j)
             {
                 glEnableVertexAttribArray(elements[j].index);
-
-                glVertexAttribPointer( elements[j].index,
-                                       elements[j].size,
-                                       BIND_SCALAR_TYPE[ elements[j].type ],
-                                       false,
-                                       elements[j].stride,
-                                       (GLvoid*)elements[j].offset );
-
+                setup_attribute_pointer(elements[j]);
             }
 
             device->SetVertexLayout(this);
@@ -231,17 +270,7 @@ void GLVertexLayoutAttribute::Bind() const
     else
     {
         // setup vertex layout
-        for (size_t i = 0; i<elements.size(); ++i)
-        {
-            glEnableVertexAttribArray(elements[i].index);
-            glVertexAttribPointer( elements[i].index, 
-                                   elements[i].size, 
-                                   BIND_SCALAR_TYPE[ elements[i].type ], 
-                                   false, 
-                                   elements[i].stride, 
-								   (GLvoid*)elements[i].offset );
-		}
-
+        SetupAttributes();
 		device->SetVertexLayout(this);
 	}
 }
@@ -250,6 +279,13 @@ void GLVertexLayoutAttribute::Unbind() const
 {
 	if ( device->CurrentVertexLayout() == this )
 	{
+        if ( device->VertexArrayObjects() )
+        {
+            device->SetVertexArrayLayout(0);
+            device->SetVertexLayout(0);
+            return;
+        }
+
 		for (size_t i = 0; i<elements.size(); ++i) {
 			glDisableVertexAttribArray(elements[i].index);
 		}
@@ -0,0 +1,553 @@
+#include "Utility/BufferArena.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+    // second level subdivides every power of two into 2^SL_LOG2 classes
+    const unsigned SL_LOG2  = 4;
+    const unsigned SL_COUNT = 1 << SL_LOG2;
+    const unsigned FL_COUNT = 32;
+
+    inline unsigned align(unsigned size, unsigned alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    // index of the most significant bit, x != 0
+    inline unsigned highest_bit(unsigned x)
+    {
+        unsigned bit = 0;
+        while (x >>= 1) {
+            ++bit;
+        }
+        return bit;
+    }
+
+    // index of the least significant bit, x != 0
+    inline unsigned lowest_bit(unsigned x)
+    {
+        unsigned bit = 0;
+        while ( !(x & 1) )
+        {
+            x >>= 1;
+            ++bit;
+        }
+        return bit;
+    }
+
+    // size class containing the size
+    inline void mapping_insert(unsigned size, unsigned& fl, unsigned& sl)
+    {
+        if (size < SL_COUNT)
+        {
+            fl = 0;
+            sl = size;
+        }
+        else
+        {
+            unsigned bit = highest_bit(size);
+            fl = bit - SL_LOG2 + 1;
+            sl = (size >> (bit - SL_LOG2)) - SL_COUNT;
+        }
+    }
+
+    // first size class whose every segment fits the size
+    inline void mapping_search(unsigned size, unsigned& fl, unsigned& sl)
+    {
+        if (size >= SL_COUNT) {
+            size += (1 << (highest_bit(size) - SL_LOG2)) - 1;
+        }
+        mapping_insert(size, fl, sl);
+    }
+
+} // anonymous namespace
+
+namespace sgl {
+
+/* Buffer with the TLSF allocator of its space */
+struct BufferArena::arena_block
+{
+    struct segment
+    {
+        unsigned    offset;
+        unsigned    size;
+        unsigned    handle;     // 0 if segment is free
+        int         prevPhys;   // neighbour segments in the buffer
+        int         nextPhys;
+        int         prevFree;   // neighbour segments in the free list
+        int         nextFree;
+    };
+
+    typedef std::vector<segment>    segment_vector;
+    typedef std::vector<int>        index_vector;
+
+    // segment at the beginning of the buffer is never merged into another one
+    static const int FIRST_SEGMENT = 0;
+
+    ref_ptr<VertexBuffer>   vertexBuffer;
+    ref_ptr<IndexBuffer>    indexBuffer;
+    unsigned                size;
+    unsigned                allocatedSize;
+
+    // TLSF free lists
+    unsigned                flBitmap;
+    unsigned                slBitmap[FL_COUNT];
+    int                     freeHeads[FL_COUNT][SL_COUNT];
+
+    segment_vector          segments;
+    index_vector            unusedSegments;
+
+    explicit arena_block(unsigned size_) :
+        size(size_),
+        allocatedSize(0),
+        flBitmap(0)
+    {
+        std::fill(slBitmap, slBitmap + FL_COUNT, 0u);
+        std::fill(&freeHeads[0][0], &freeHeads[0][0] + FL_COUNT * SL_COUNT, -1);
+        InsertFree( NewSegment(0, size, -1, -1) );
+    }
+
+    Buffer* GetBuffer() const
+    {
+        return vertexBuffer ? static_cast<Buffer*>( vertexBuffer.get() ) : static_cast<Buffer*>( indexBuffer.get() );
+    }
+
+    int NewSegment(unsigned offset, unsigned segmentSize, int prevPhys, int nextPhys)
+    {
+        segment seg;
+        seg.offset   = offset;
+        seg.size     = segmentSize;
+        seg.handle   = 0;
+        seg.prevPhys = prevPhys;
+        seg.nextPhys = nextPhys;
+        seg.prevFree = -1;
+        seg.nextFree = -1;
+
+        if ( !unusedSegments.empty() )
+        {
+            int index = unusedSegments.back();
+            unusedSegments.pop_back();
+            segments[index] = seg;
+            return index;
+        }
+
+        segments.push_back(seg);
+        return segments.size() - 1;
+    }
+
+    void InsertFree(int index)
+    {
+        segment& seg = segments[index];
+
+        unsigned fl, sl;
+        mapping_insert(seg.size, fl, sl);
+
+        seg.prevFree = -1;
+        seg.nextFree = freeHeads[fl][sl];
+        if (seg.nextFree >= 0) {
+            segments[seg.nextFree].prevFree = index;
+        }
+
+        freeHeads[fl][sl] = index;
+        flBitmap         |= 1u << fl;
+        slBitmap[fl]     |= 1u << sl;
+    }
+
+    void RemoveFree(int index)
+    {
+        segment& seg = segments[index];
+
+        unsigned fl, sl;
+        mapping_insert(seg.size, fl, sl);
+
+        if (seg.prevFree >= 0) {
+            segments[seg.prevFree].nextFree = seg.nextFree;
+        }
+        else {
+            freeHeads[fl][sl] = seg.nextFree;
+        }
+
+        if (seg.nextFree >= 0) {
+            segments[seg.nextFree].prevFree = seg.prevFree;
+        }
+
+        if (freeHeads[fl][sl] < 0)
+        {
+            slBitmap[fl] &= ~(1u << sl);
+            if (slBitmap[fl] == 0) {
+                flBitmap &= ~(1u << fl);
+            }
+        }
+    }
+
+    int FindFree(unsigned segmentSize) const
+    {
+        unsigned fl, sl;
+        mapping_search(segmentSize, fl, sl);
+
+        // any segment of the classes above fits
+        unsigned slMap = (sl < SL_COUNT) ? slBitmap[fl] & (~0u << sl) : 0;
+        if (!slMap)
+        {
+            unsigned flMap = (fl + 1 < FL_COUNT) ? flBitmap & (~0u << (fl + 1)) : 0;
+            if (flMap)
+            {
+                fl    = lowest_bit(flMap);
+                slMap = slBitmap[fl];
+            }
+        }
+
+        if (slMap) {
+            return freeHeads[fl][ lowest_bit(slMap) ];
+        }
+
+        // segments of the class containing the size may fit as well
+        mapping_insert(segmentSize, fl, sl);
+        for (int index = freeHeads[fl][sl]; index >= 0; index = segments[index].nextFree)
+        {
+            if (segments[index].size >= segmentSize) {
+                return index;
+            }
+        }
+
+        return -1;
+    }
+
+    int Allocate(unsigned segmentSize, unsigned handle)
+    {
+        int index = FindFree(segmentSize);
+        if (index < 0) {
+            return -1;
+        }
+
+        RemoveFree(index);
+
+        // return remainder to the free lists
+        segment& seg = segments[index];
+        if (seg.size > segmentSize)
+        {
+            int rest = NewSegment(seg.offset + segmentSize, seg.size - segmentSize, index, seg.nextPhys);
+            segment& allocated = segments[index];   // reference could be invalidated by NewSegment
+            if (allocated.nextPhys >= 0) {
+                segments[allocated.nextPhys].prevPhys = rest;
+            }
+            allocated.nextPhys = rest;
+            allocated.size     = segmentSize;
+            InsertFree(rest);
+        }
+
+        segments[index].handle = handle;
+        allocatedSize         += segmentSize;
+        return index;
+    }
+
+    void Free(int index)
+    {
+        segment& seg = segments[index];
+        assert(seg.handle != 0);
+
+        allocatedSize -= seg.size;
+        seg.handle     = 0;
+
+        // merge with free neighbours
+        int prev = seg.prevPhys;
+        if (prev >= 0 && segments[prev].handle == 0)
+        {
+            RemoveFree(prev);
+            Merge(prev, index);
+            index = prev;
+        }
+
+        int next = segments[index].nextPhys;
+        if (next >= 0 && segments[next].handle == 0)
+        {
+            RemoveFree(next);
+            Merge(index, next);
+        }
+
+        InsertFree(index);
+    }
+
+    // append segment to its previous neighbour
+    void Merge(int index, int next)
+    {
+        segment& seg     = segments[index];
+        segment& nextSeg = segments[next];
+
+        seg.size    += nextSeg.size;
+        seg.nextPhys = nextSeg.nextPhys;
+        if (seg.nextPhys >= 0) {
+            segments[seg.nextPhys].prevPhys = index;
+        }
+        unusedSegments.push_back(next);
+    }
+
+    unsigned LargestFree() const
+    {
+        if (flBitmap == 0) {
+            return 0;
+        }
+
+        unsigned fl = highest_bit(flBitmap);
+        unsigned sl = highest_bit(slBitmap[fl]);
+
+        unsigned largest = 0;
+        for (int index = freeHeads[fl][sl]; index >= 0; index = segments[index].nextFree) {
+            largest = std::max(largest, segments[index].size);
+        }
+        return largest;
+    }
+
+    unsigned NumFree() const
+    {
+        unsigned numFree = 0;
+        for (int index = FIRST_SEGMENT; index >= 0; index = segments[index].nextPhys)
+        {
+            if (segments[index].handle == 0) {
+                ++numFree;
+            }
+        }
+        return numFree;
+    }
+};
+
+BufferArena::BufferArena(Device* device_, const DESC& desc_) :
+    device(device_),
+    desc(desc_)
+{
+    desc.alignment = std::max(desc.alignment, 1u);
+}
+
+BufferArena::~BufferArena()
+{
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        delete blocks[i];
+    }
+}
+
+BufferArena::arena_block* BufferArena::CreateBlock(unsigned size)
+{
+    arena_block* block = new arena_block(size);
+    if (desc.type == VERTEX_ARENA) {
+        block->vertexBuffer.reset( device->CreateVertexBuffer() );
+    }
+    else {
+        block->indexBuffer.reset( device->CreateIndexBuffer() );
+    }
+
+    Buffer* buffer = block->GetBuffer();
+    if ( !buffer || SGL_OK != buffer->SetData(size, 0, desc.usage) )
+    {
+        delete block;
+        return 0;
+    }
+
+    return block;
+}
+
+void BufferArena::BindRange(unsigned handle, unsigned blockIndex, int segment)
+{
+    const arena_block* block = blocks[blockIndex];
+    range_entry&       entry = ranges[handle - 1];
+
+    entry.segment            = segment;
+    entry.range.vertexBuffer = block->vertexBuffer.get();
+    entry.range.indexBuffer  = block->indexBuffer.get();
+    entry.range.block        = blockIndex;
+    entry.range.offset       = block->segments[segment].offset;
+    entry.range.size         = block->segments[segment].size;
+}
+
+unsigned BufferArena::Allocate(unsigned size, const void* data)
+{
+    if (size == 0)
+    {
+        sglSetError(SGLERR_INVALID_CALL, "BufferArena::Allocate failed. Size of the range is 0.");
+        return 0;
+    }
+
+    // reserve handle
+    unsigned handle;
+    if ( freeHandles.empty() )
+    {
+        ranges.push_back( range_entry() );
+        handle = ranges.size();
+    }
+    else
+    {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+
+    // data covers only the requested size, padding is left undefined
+    unsigned alignedSize = align(size, desc.alignment);
+
+    unsigned blockIndex = 0;
+    int      segment    = -1;
+    for (; blockIndex < blocks.size() && segment < 0; ++blockIndex) {
+        segment = blocks[blockIndex]->Allocate(alignedSize, handle);
+    }
+
+    if (segment < 0)
+    {
+        // ranges larger than block get dedicated buffer
+        arena_block* block = CreateBlock( std::max(align(desc.blockSize, desc.alignment), alignedSize) );
+        if (!block)
+        {
+            freeHandles.push_back(handle);
+            return 0;
+        }
+
+        blocks.push_back(block);
+        blockIndex = blocks.size();
+        segment    = block->Allocate(alignedSize, handle);
+    }
+
+    BindRange(handle, blockIndex - 1, segment);
+    if (data && SGL_OK != SetData(handle, 0, size, data))
+    {
+        Free(handle);
+        return 0;
+    }
+
+    return handle;
+}
+
+void BufferArena::Free(unsigned handle)
+{
+    assert( handle > 0 && handle <= ranges.size() && ranges[handle - 1].segment >= 0 );
+
+    range_entry& entry = ranges[handle - 1];
+    blocks[entry.range.block]->Free(entry.segment);
+    entry.segment = -1;
+    freeHandles.push_back(handle);
+}
+
+SGL_HRESULT BufferArena::SetData( unsigned       handle,
+                                  unsigned       offset,
+                                  unsigned       size,
+                                  const void*    data )
+{
+    const BufferRange& range = Range(handle);
+#ifndef SGL_NO_STATUS_CHECK
+    if (offset + size > range.size) {
+        return EInvalidCall("BufferArena::SetData failed. Data is out of the range.");
+    }
+#endif
+
+    return blocks[range.block]->GetBuffer()->SetSubData(range.offset + offset, size, data);
+}
+
+const BufferArena::BufferRange& BufferArena::Range(unsigned handle) const
+{
+    assert( handle > 0 && handle <= ranges.size() && ranges[handle - 1].segment >= 0 );
+    return ranges[handle - 1].range;
+}
+
+SGL_HRESULT BufferArena::Defragment()
+{
+#ifdef SIMPLE_GL_ES
+    return EUnsupported("BufferArena::Defragment failed. Buffer copies are not supported.");
+#else
+    // release empty blocks
+    {
+        block_vector usedBlocks;
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            if (blocks[i]->allocatedSize > 0) {
+                usedBlocks.push_back(blocks[i]);
+            }
+            else {
+                delete blocks[i];
+            }
+        }
+        blocks.swap(usedBlocks);
+
+        // update block indices shifted by the release, so failed packing leaves ranges valid
+        for (unsigned i = 0; i < blocks.size(); ++i)
+        {
+            const arena_block* block = blocks[i];
+            for (int index = arena_block::FIRST_SEGMENT; index >= 0; index = block->segments[index].nextPhys)
+            {
+                if (block->segments[index].handle) {
+                    BindRange(block->segments[index].handle, i, index);
+                }
+            }
+        }
+    }
+
+    for (unsigned i = 0; i < blocks.size(); ++i)
+    {
+        // single free segment can't be enlarged by compaction
+        arena_block* block = blocks[i];
+        if (block->NumFree() <= 1) {
+            continue;
+        }
+
+        // pack ranges into the new buffer preserving their order
+        arena_block* packed = CreateBlock(block->size);
+        if (!packed) {
+            return EOutOfMemory("BufferArena::Defragment failed. Can't create buffer for the packed ranges.");
+        }
+
+        for (int index = arena_block::FIRST_SEGMENT; index >= 0; index = block->segments[index].nextPhys)
+        {
+            const arena_block::segment& seg = block->segments[index];
+            if (seg.handle == 0) {
+                continue;
+            }
+
+            int packedSegment = packed->Allocate(seg.size, seg.handle);
+            assert(packedSegment >= 0);
+
+            SGL_HRESULT result = block->GetBuffer()->CopyTo( packed->GetBuffer(),
+                                                             seg.offset,
+                                                             packed->segments[packedSegment].offset,
+                                                             seg.size );
+            if (SGL_OK != result)
+            {
+                // ranges still reference the old block
+                delete packed;
+                return result;
+            }
+        }
+
+        blocks[i] = packed;
+        delete block;
+
+        for (int index = arena_block::FIRST_SEGMENT; index >= 0; index = packed->segments[index].nextPhys)
+        {
+            if (packed->segments[index].handle) {
+                BindRange(packed->segments[index].handle, i, index);
+            }
+        }
+    }
+
+    return SGL_OK;
+#endif
+}
+
+BufferArena::STATISTICS BufferArena::Statistics() const
+{
+    STATISTICS stats;
+    stats.numBlocks        = blocks.size();
+    stats.numRanges        = ranges.size() - freeHandles.size();
+    stats.capacity         = 0;
+    stats.allocatedSize    = 0;
+    stats.largestFreeRange = 0;
+
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        stats.capacity        += blocks[i]->size;
+        stats.allocatedSize   += blocks[i]->allocatedSize;
+        stats.largestFreeRange = std::max( stats.largestFreeRange, blocks[i]->LargestFree() );
+    }
+
+    unsigned freeSize   = stats.capacity - stats.allocatedSize;
+    stats.utilisation   = stats.capacity > 0 ? float(stats.allocatedSize) / stats.capacity : 0.0f;
+    stats.fragmentation = freeSize > 0 ? 1.0f - float(stats.largestFreeRange) / freeSize : 0.0f;
+    return stats;
+}
+
+} // namespace sgl
@@ -0,0 +1,627 @@
+#include "Utility/MeshOptimizer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    using namespace sgl;
+
+    typedef std::vector<unsigned>   uint_vector;
+    typedef std::vector<int>        int_vector;
+
+    /* Triangles adjacent to every vertex in compressed form */
+    struct vertex_adjacency
+    {
+        uint_vector offsets;    // first triangle of the vertex in the triangles
+        uint_vector counts;     // number of triangles of the vertex
+        uint_vector triangles;
+
+        vertex_adjacency( const unsigned*  indices,
+                          unsigned         numIndices,
+                          unsigned         numVertices ) :
+            offsets(numVertices, 0),
+            counts(numVertices, 0),
+            triangles(numIndices)
+        {
+            for (unsigned i = 0; i < numIndices; ++i) {
+                ++counts[ indices[i] ];
+            }
+
+            unsigned offset = 0;
+            for (unsigned i = 0; i < numVertices; ++i)
+            {
+                offsets[i] = offset;
+                offset    += counts[i];
+            }
+
+            uint_vector fill(offsets);
+            for (unsigned i = 0; i < numIndices; ++i) {
+                triangles[ fill[ indices[i] ]++ ] = i / 3;
+            }
+        }
+    };
+
+    // Forsyth's scoring, see http://home.comcast.net/~tom_forsyth/papers/fast_vert_cache_opt.html
+    const int   FORSYTH_CACHE_SIZE        = 32;
+    const float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+    const float FORSYTH_LAST_TRI_SCORE    = 0.75f;
+    const float FORSYTH_VALENCE_SCALE     = 2.0f;
+    const float FORSYTH_VALENCE_POWER     = 0.5f;
+
+    float forsyth_score(int cachePosition, unsigned numLiveTriangles)
+    {
+        if (numLiveTriangles == 0) {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            // vertices of the last triangle get fixed score, so the order of its edges doesn't matter
+            if (cachePosition < 3) {
+                score = FORSYTH_LAST_TRI_SCORE;
+            }
+            else
+            {
+                float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+                score = powf(1.0f - (cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+            }
+        }
+
+        // prefer vertices with few triangles left, so lonely triangles are not left behind
+        return score + FORSYTH_VALENCE_SCALE * powf(float(numLiveTriangles), -FORSYTH_VALENCE_POWER);
+    }
+
+    void copy_triangles( unsigned*          destination,
+                         const unsigned*    indices,
+                         const uint_vector& order )
+    {
+        std::vector<unsigned> result( order.size() * 3 );
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            result[i * 3 + 0] = indices[ order[i] * 3 + 0 ];
+            result[i * 3 + 1] = indices[ order[i] * 3 + 1 ];
+            result[i * 3 + 2] = indices[ order[i] * 3 + 2 ];
+        }
+
+        if ( !result.empty() ) {
+            std::copy(result.begin(), result.end(), destination);
+        }
+    }
+
+    // Tipsify: next fanning vertex among the candidates or from the dead end stack
+    int tipsify_next_vertex( const uint_vector&  candidates,
+                             const uint_vector&  liveTriangles,
+                             const uint_vector&  timeStamps,
+                             unsigned            timeStamp,
+                             unsigned            cacheSize,
+                             uint_vector&        deadEnd,
+                             unsigned&           cursor )
+    {
+        // best candidate stays in cache after its fan is emitted
+        int      bestVertex   = -1;
+        unsigned bestPriority = 0;
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            unsigned vertex = candidates[i];
+            if (liveTriangles[vertex] == 0) {
+                continue;
+            }
+
+            unsigned priority = 0;
+            if (timeStamp - timeStamps[vertex] + 2 * liveTriangles[vertex] <= cacheSize) {
+                priority = timeStamp - timeStamps[vertex];
+            }
+
+            if (bestVertex < 0 || priority > bestPriority)
+            {
+                bestVertex   = vertex;
+                bestPriority = priority;
+            }
+        }
+
+        if (bestVertex >= 0) {
+            return bestVertex;
+        }
+
+        // recently referenced vertices with live triangles
+        while ( !deadEnd.empty() )
+        {
+            unsigned vertex = deadEnd.back();
+            deadEnd.pop_back();
+            if (liveTriangles[vertex] > 0) {
+                return vertex;
+            }
+        }
+
+        // any vertex with live triangles
+        while ( cursor < liveTriangles.size() )
+        {
+            if (liveTriangles[cursor] > 0) {
+                return cursor;
+            }
+            ++cursor;
+        }
+
+        return -1;
+    }
+
+    struct cluster_desc
+    {
+        unsigned    first;      // first triangle
+        unsigned    count;      // number of triangles
+        float       sortKey;
+
+        bool operator < (const cluster_desc& rhs) const
+        {
+            return sortKey > rhs.sortKey;
+        }
+    };
+
+    inline const float* vertex_position(const float* positions, unsigned stride, unsigned vertex)
+    {
+        return reinterpret_cast<const float*>( reinterpret_cast<const char*>(positions) + vertex * stride );
+    }
+
+    unsigned element_size(const VertexLayout::ELEMENT& element)
+    {
+        return element.size * SCALAR_TYPE_TRAITS[element.type].sizeInBits / 8;
+    }
+
+} // anonymous namespace
+
+namespace sgl {
+
+VERTEX_CACHE_STATISTICS AnalyzeVertexCache( const unsigned*    indices,
+                                            unsigned           numIndices,
+                                            unsigned           numVertices,
+                                            unsigned           cacheSize )
+{
+    assert(numIndices % 3 == 0);
+
+    // FIFO cache: vertex is in cache if it was transformed during last cacheSize misses
+    uint_vector timeStamps(numVertices, 0);
+    uint_vector referenced(numVertices, 0);
+    unsigned    timeStamp      = cacheSize + 1;
+    unsigned    numTransformed = 0;
+    unsigned    numReferenced  = 0;
+    for (unsigned i = 0; i < numIndices; ++i)
+    {
+        unsigned vertex = indices[i];
+        if (timeStamp - timeStamps[vertex] > cacheSize)
+        {
+            timeStamps[vertex] = timeStamp++;
+            ++numTransformed;
+        }
+
+        if (!referenced[vertex])
+        {
+            referenced[vertex] = 1;
+            ++numReferenced;
+        }
+    }
+
+    VERTEX_CACHE_STATISTICS stats;
+    stats.numTransformed = numTransformed;
+    stats.acmr           = numIndices > 0 ? float(numTransformed) / (numIndices / 3) : 0.0f;
+    stats.atvr           = numReferenced > 0 ? float(numTransformed) / numReferenced : 0.0f;
+    return stats;
+}
+
+void OptimizeVertexCache( unsigned*          destination,
+                          const unsigned*    indices,
+                          unsigned           numIndices,
+                          unsigned           numVertices )
+{
+    assert(numIndices % 3 == 0);
+
+    const unsigned   numTriangles = numIndices / 3;
+    if (numTriangles == 0) {
+        return;
+    }
+
+    vertex_adjacency adjacency(indices, numIndices, numVertices);
+
+    // vertex state
+    uint_vector             liveTriangles(adjacency.counts);
+    int_vector              cachePosition(numVertices, -1);
+    std::vector<float>      vertexScore(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i) {
+        vertexScore[i] = forsyth_score(-1, liveTriangles[i]);
+    }
+
+    // triangle state
+    std::vector<float>  triangleScore(numTriangles);
+    std::vector<char>   emitted(numTriangles, 0);
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        triangleScore[i] = vertexScore[ indices[i * 3 + 0] ]
+                         + vertexScore[ indices[i * 3 + 1] ]
+                         + vertexScore[ indices[i * 3 + 2] ];
+    }
+
+    uint_vector order;
+    order.reserve(numTriangles);
+
+    int_vector cache, newCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    unsigned cursor       = 0;
+    int      bestTriangle = -1;
+    while ( order.size() < numTriangles )
+    {
+        // no triangles touch the cache, take the best of the remaining ones
+        if (bestTriangle < 0)
+        {
+            while (emitted[cursor]) {
+                ++cursor;
+            }
+
+            bestTriangle = cursor;
+            for (unsigned i = cursor + 1; i < numTriangles; ++i)
+            {
+                if ( !emitted[i] && triangleScore[i] > triangleScore[bestTriangle] ) {
+                    bestTriangle = i;
+                }
+            }
+        }
+
+        emitted[bestTriangle] = 1;
+        order.push_back(bestTriangle);
+
+        // move vertices of the triangle to the top of the LRU cache
+        newCache.clear();
+        for (int i = 0; i < 3; ++i)
+        {
+            unsigned vertex = indices[bestTriangle * 3 + i];
+            newCache.push_back(vertex);
+
+            // remove triangle from the live triangles of the vertex
+            unsigned* first = &adjacency.triangles[ adjacency.offsets[vertex] ];
+            unsigned* last  = first + liveTriangles[vertex];
+            std::swap( *std::find(first, last, unsigned(bestTriangle)), *(last - 1) );
+            --liveTriangles[vertex];
+        }
+
+        for (size_t i = 0; i < cache.size(); ++i)
+        {
+            if ( std::find(newCache.begin(), newCache.begin() + 3, cache[i]) == newCache.begin() + 3 ) {
+                newCache.push_back(cache[i]);
+            }
+        }
+
+        // rescore vertices of the cache and their triangles
+        for (size_t i = 0; i < newCache.size(); ++i)
+        {
+            unsigned vertex = newCache[i];
+            int      position = (i < size_t(FORSYTH_CACHE_SIZE)) ? int(i) : -1;
+            cachePosition[vertex] = position;
+
+            float score = forsyth_score(position, liveTriangles[vertex]);
+            float delta = score - vertexScore[vertex];
+            vertexScore[vertex] = score;
+
+            const unsigned* triangles = &adjacency.triangles[0] + adjacency.offsets[vertex];
+            for (unsigned j = 0; j < liveTriangles[vertex]; ++j) {
+                triangleScore[ triangles[j] ] += delta;
+            }
+        }
+
+        if ( newCache.size() > size_t(FORSYTH_CACHE_SIZE) ) {
+            newCache.resize(FORSYTH_CACHE_SIZE);
+        }
+        cache.swap(newCache);
+
+        // best triangle adjacent to the cached vertices
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (size_t i = 0; i < cache.size(); ++i)
+        {
+            unsigned        vertex    = cache[i];
+            const unsigned* triangles = &adjacency.triangles[0] + adjacency.offsets[vertex];
+            for (unsigned j = 0; j < liveTriangles[vertex]; ++j)
+            {
+                if (triangleScore[ triangles[j] ] > bestScore)
+                {
+                    bestTriangle = triangles[j];
+                    bestScore    = triangleScore[ triangles[j] ];
+                }
+            }
+        }
+    }
+
+    copy_triangles(destination, indices, order);
+}
+
+void OptimizeVertexCacheTipsify( unsigned*          destination,
+                                 const unsigned*    indices,
+                                 unsigned           numIndices,
+                                 unsigned           numVertices,
+                                 unsigned           cacheSize )
+{
+    assert(numIndices % 3 == 0);
+
+    const unsigned   numTriangles = numIndices / 3;
+    if (numTriangles == 0) {
+        return;
+    }
+
+    vertex_adjacency adjacency(indices, numIndices, numVertices);
+
+    uint_vector         liveTriangles(adjacency.counts);
+    uint_vector         timeStamps(numVertices, 0);
+    std::vector<char>   emitted(numTriangles, 0);
+    uint_vector         deadEnd;
+    uint_vector         candidates;
+    uint_vector         order;
+    order.reserve(numTriangles);
+
+    unsigned timeStamp = cacheSize + 1;
+    unsigned cursor    = 0;
+    int      fanning   = numVertices > 0 ? 0 : -1;
+    while (fanning >= 0)
+    {
+        candidates.clear();
+
+        // emit all triangles around the fanning vertex
+        const unsigned* triangles = &adjacency.triangles[0] + adjacency.offsets[fanning];
+        for (unsigned i = 0; i < adjacency.counts[fanning]; ++i)
+        {
+            unsigned triangle = triangles[i];
+            if (emitted[triangle]) {
+                continue;
+            }
+
+            for (int j = 0; j < 3; ++j)
+            {
+                unsigned vertex = indices[triangle * 3 + j];
+                deadEnd.push_back(vertex);
+                candidates.push_back(vertex);
+                --liveTriangles[vertex];
+
+                if (timeStamp - timeStamps[vertex] > cacheSize) {
+                    timeStamps[vertex] = timeStamp++;
+                }
+            }
+
+            emitted[triangle] = 1;
+            order.push_back(triangle);
+        }
+
+        fanning = tipsify_next_vertex( candidates,
+                                       liveTriangles,
+                                       timeStamps,
+                                       timeStamp,
+                                       cacheSize,
+                                       deadEnd,
+                                       cursor );
+    }
+
+    assert( order.size() == numTriangles );
+    copy_triangles(destination, indices, order);
+}
+
+void OptimizeOverdraw( unsigned*          destination,
+                       const unsigned*    indices,
+                       unsigned           numIndices,
+                       const float*       positions,
+                       unsigned           positionStride,
+                       unsigned           numVertices,
+                       float              threshold )
+{
+    assert(numIndices % 3 == 0);
+
+    const unsigned numTriangles = numIndices / 3;
+    const unsigned cacheSize    = 16;
+    if (numTriangles == 0) {
+        return;
+    }
+
+    // hard boundaries: triangles missing cache with all vertices
+    uint_vector hardBoundaries;
+    {
+        uint_vector timeStamps(numVertices, 0);
+        unsigned    timeStamp = cacheSize + 1;
+        for (unsigned i = 0; i < numTriangles; ++i)
+        {
+            unsigned numMisses = 0;
+            for (int j = 0; j < 3; ++j)
+            {
+                unsigned vertex = indices[i * 3 + j];
+                if (timeStamp - timeStamps[vertex] > cacheSize)
+                {
+                    timeStamps[vertex] = timeStamp++;
+                    ++numMisses;
+                }
+            }
+
+            if (i == 0 || numMisses == 3) {
+                hardBoundaries.push_back(i);
+            }
+        }
+        hardBoundaries.push_back(numTriangles);
+    }
+
+    // soft boundaries: split hard clusters while cluster ACMR is within threshold of the whole cluster ACMR
+    std::vector<cluster_desc> clusters;
+    for (size_t i = 0; i + 1 < hardBoundaries.size(); ++i)
+    {
+        unsigned first = hardBoundaries[i];
+        unsigned last  = hardBoundaries[i + 1];
+
+        VERTEX_CACHE_STATISTICS stats   = AnalyzeVertexCache(indices + first * 3, (last - first) * 3, numVertices, cacheSize);
+        float                   maxACMR = stats.acmr * threshold;
+
+        uint_vector timeStamps(numVertices, 0);
+        unsigned    timeStamp = cacheSize + 1;
+        unsigned    start     = first;
+        unsigned    numMisses = 0;
+        for (unsigned j = first; j < last; ++j)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned vertex = indices[j * 3 + k];
+                if (timeStamp - timeStamps[vertex] > cacheSize)
+                {
+                    timeStamps[vertex] = timeStamp++;
+                    ++numMisses;
+                }
+            }
+
+            if ( j + 1 == last || float(numMisses) / (j + 1 - start) <= maxACMR )
+            {
+                cluster_desc cluster;
+                cluster.first   = start;
+                cluster.count   = j + 1 - start;
+                cluster.sortKey = 0.0f;
+                clusters.push_back(cluster);
+
+                // new cluster starts with cold cache
+                start     = j + 1;
+                numMisses = 0;
+                timeStamp += cacheSize + 1;
+            }
+        }
+    }
+
+    // mesh centroid
+    float meshCenter[3] = {0.0f, 0.0f, 0.0f};
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        const float* p = vertex_position(positions, positionStride, i);
+        meshCenter[0] += p[0];
+        meshCenter[1] += p[1];
+        meshCenter[2] += p[2];
+    }
+    for (int i = 0; i < 3; ++i) {
+        meshCenter[i] /= std::max(numVertices, 1u);
+    }
+
+    // clusters facing outwards of the mesh center are likely to occlude the rest
+    for (size_t i = 0; i < clusters.size(); ++i)
+    {
+        float center[3] = {0.0f, 0.0f, 0.0f};
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+        float area      = 0.0f;
+        for (unsigned j = clusters[i].first; j < clusters[i].first + clusters[i].count; ++j)
+        {
+            const float* a = vertex_position(positions, positionStride, indices[j * 3 + 0]);
+            const float* b = vertex_position(positions, positionStride, indices[j * 3 + 1]);
+            const float* c = vertex_position(positions, positionStride, indices[j * 3 + 2]);
+
+            float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+            float n[3]  = { ab[1] * ac[2] - ab[2] * ac[1],
+                            ab[2] * ac[0] - ab[0] * ac[2],
+                            ab[0] * ac[1] - ab[1] * ac[0] };
+            float triangleArea = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+            for (int k = 0; k < 3; ++k)
+            {
+                center[k] += (a[k] + b[k] + c[k]) / 3.0f * triangleArea;
+                normal[k] += n[k];
+            }
+            area += triangleArea;
+        }
+
+        float normalLength = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (area > 0.0f && normalLength > 0.0f)
+        {
+            float key = 0.0f;
+            for (int k = 0; k < 3; ++k) {
+                key += (center[k] / area - meshCenter[k]) * normal[k] / normalLength;
+            }
+            clusters[i].sortKey = key;
+        }
+    }
+
+    std::stable_sort( clusters.begin(), clusters.end() );
+
+    uint_vector order;
+    order.reserve(numTriangles);
+    for (size_t i = 0; i < clusters.size(); ++i)
+    {
+        for (unsigned j = 0; j < clusters[i].count; ++j) {
+            order.push_back(clusters[i].first + j);
+        }
+    }
+
+    copy_triangles(destination, indices, order);
+}
+
+unsigned OptimizeVertexFetch( void*                  vertexData,
+                              const VertexLayout*    layout,
+                              unsigned               numVertices,
+                              unsigned*              indices,
+                              unsigned               numIndices )
+{
+    assert(vertexData && layout);
+
+    // new positions of the vertices in the order of the first reference
+    const unsigned NOT_REFERENCED = ~0u;
+    uint_vector remap(numVertices, NOT_REFERENCED);
+    unsigned    numReferenced = 0;
+    for (unsigned i = 0; i < numIndices; ++i)
+    {
+        unsigned& position = remap[ indices[i] ];
+        if (position == NOT_REFERENCED) {
+            position = numReferenced++;
+        }
+        indices[i] = position;
+    }
+
+    unsigned numUnreferenced = numReferenced;
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        if (remap[i] == NOT_REFERENCED) {
+            remap[i] = numUnreferenced++;
+        }
+    }
+
+    // permute every element, they may be interleaved or stored in separate arrays
+    char*             data = static_cast<char*>(vertexData);
+    std::vector<char> scratch;
+    for (unsigned i = 0; i < layout->NumElements(); ++i)
+    {
+        VertexLayout::ELEMENT element = layout->Element(i);
+        unsigned              size    = element_size(element);
+        unsigned              stride  = element.stride ? element.stride : size;
+
+        scratch.resize(numVertices * size);
+        for (unsigned j = 0; j < numVertices; ++j) {
+            memcpy(&scratch[ remap[j] * size ], data + element.offset + j * stride, size);
+        }
+
+        for (unsigned j = 0; j < numVertices; ++j) {
+            memcpy(data + element.offset + j * stride, &scratch[j * size], size);
+        }
+    }
+
+    return numReferenced;
+}
+
+SGL_HRESULT SetOptimalIndexData( IndexBuffer*               buffer,
+                                 const unsigned*            indices,
+                                 unsigned                   numIndices,
+                                 unsigned                   numVertices,
+                                 IndexBuffer::INDEX_TYPE&   type,
+                                 Buffer::USAGE              usage )
+{
+    assert(buffer);
+
+    if (numVertices <= 0x10000)
+    {
+        std::vector<unsigned short> shortIndices(indices, indices + numIndices);
+        type = IndexBuffer::UINT_16;
+        return buffer->SetData( numIndices * sizeof(unsigned short), numIndices > 0 ? &shortIndices[0] : 0, usage );
+    }
+
+    type = IndexBuffer::UINT_32;
+    return buffer->SetData( numIndices * sizeof(unsigned), indices, usage );
+}
+
+} // namespace sgl
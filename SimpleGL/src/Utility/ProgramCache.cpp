@@ -0,0 +1,282 @@
+#include "Utility/ProgramCache.h"
+#include <cstdio>
+#ifdef WIN32
+#   include <windows.h>
+#else
+#   include <sys/time.h>
+#endif
+
+namespace {
+
+    using namespace sgl;
+
+    // first word of the binary file, "SGLB"
+    const unsigned BINARY_MAGIC = 0x424C4753;
+
+    // wall clock time in seconds
+    double current_time()
+    {
+    #ifdef WIN32
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER counter;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&counter);
+        return double(counter.QuadPart) / double(frequency.QuadPart);
+    #else
+        timeval tv;
+        gettimeofday(&tv, 0);
+        return tv.tv_sec + tv.tv_usec * 1e-6;
+    #endif
+    }
+
+    // FNV-1a hash of the key parts, different seeds give independent halves of the key
+    class key_hasher
+    {
+    public:
+        explicit key_hasher(unsigned seed) :
+            value(seed)
+        {}
+
+        void add(const char* str)
+        {
+            // terminating 0 separates the parts
+            do {
+                value = (value ^ static_cast<unsigned char>(*str)) * 16777619u;
+            } while (*str++);
+        }
+
+        void add(unsigned number)
+        {
+            for (int i = 0; i<4; ++i, number >>= 8) {
+                value = (value ^ (number & 0xFF)) * 16777619u;
+            }
+        }
+
+        unsigned result() const { return value; }
+
+    private:
+        unsigned value;
+    };
+
+    unsigned hash_program( unsigned                            seed,
+                           const char*                         driverIdentity,
+                           const ProgramCache::PROGRAM_DESC&   desc )
+    {
+        key_hasher hasher(seed);
+        hasher.add(driverIdentity);
+
+        hasher.add(desc.numShaders);
+        for (unsigned i = 0; i<desc.numShaders; ++i)
+        {
+            hasher.add(desc.shaders[i].type);
+            hasher.add(desc.shaders[i].source);
+        }
+
+        hasher.add(desc.numAttributes);
+        for (unsigned i = 0; i<desc.numAttributes; ++i)
+        {
+            hasher.add(desc.attributes[i]);
+            hasher.add(desc.attributeLocations[i]);
+        }
+
+        hasher.add(desc.numFragDatas);
+        for (unsigned i = 0; i<desc.numFragDatas; ++i)
+        {
+            hasher.add(desc.fragDatas[i]);
+            hasher.add(desc.fragDataLocations[i]);
+        }
+
+        hasher.add(desc.numVaryings);
+        for (unsigned i = 0; i<desc.numVaryings; ++i) {
+            hasher.add(desc.varyings[i]);
+        }
+        hasher.add(desc.feedbackMode);
+
+        return hasher.result();
+    }
+
+} // anonymous namespace
+
+namespace sgl {
+
+ProgramCache::ProgramCache(Device* device_, const char* directory_) :
+    device(device_),
+    directory(directory_ ? directory_ : ""),
+    numHits(0),
+    numMisses(0),
+    numRejected(0),
+    loadTime(0.0),
+    compileTime(0.0)
+{
+}
+
+ProgramCache::~ProgramCache()
+{
+}
+
+std::string ProgramCache::BinaryPath(const PROGRAM_DESC& desc) const
+{
+    if ( directory.empty() ) {
+        return std::string();
+    }
+
+    const char* driverIdentity = device->Traits()->DriverIdentity();
+
+    char fileName[32];
+    sprintf( fileName,
+             "%08x%08x.bin",
+             hash_program(2166136261u, driverIdentity, desc),
+             hash_program(3735928559u, driverIdentity, desc) );
+
+    char last = directory[directory.size() - 1];
+    if (last == '/' || last == '\\') {
+        return directory + fileName;
+    }
+
+    return directory + '/' + fileName;
+}
+
+SGL_HRESULT ProgramCache::LoadBinary(Program* program, const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return SGLERR_FILE_NOT_FOUND;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    // header: magic, format, size; truncated or corrupted file is a miss
+    unsigned header[3];
+    bool     valid = fread(header, sizeof(header), 1, file) == 1
+                     && header[0] == BINARY_MAGIC
+                     && header[2] > 0
+                     && fileSize >= long(sizeof(header))
+                     && header[2] == unsigned(fileSize - sizeof(header));
+    if (valid)
+    {
+        binary.resize(header[2]);
+        valid = fread(&binary[0], 1, header[2], file) == header[2];
+    }
+    fclose(file);
+
+    if (!valid) {
+        return SGLERR_IO;
+    }
+
+    return program->LoadBinary(header[1], &binary[0], header[2]);
+}
+
+void ProgramCache::StoreBinary(const Program* program, const std::string& path)
+{
+    unsigned format = 0;
+    unsigned size   = program->GetBinary(format, 0, 0);
+    if (size == 0) {
+        return;
+    }
+
+    binary.resize(size);
+    size = program->GetBinary(format, &binary[0], size);
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return;
+    }
+
+    // cache is optional, so failed write just removes incomplete binary
+    unsigned header[3] = { BINARY_MAGIC, format, size };
+    bool     written   = fwrite(header, sizeof(header), 1, file) == 1
+                         && fwrite(&binary[0], 1, size, file) == size;
+    fclose(file);
+
+    if (!written) {
+        remove( path.c_str() );
+    }
+}
+
+ref_ptr<Program> ProgramCache::CreateProgram(const PROGRAM_DESC& desc)
+{
+    double startTime = current_time();
+
+    ref_ptr<Program> program( device->CreateProgram() );
+    if (!program) {
+        return ref_ptr<Program>();
+    }
+
+    // settings are restored from the binary as well, but they are needed if it is rejected
+    for (unsigned i = 0; i<desc.numAttributes; ++i) {
+        program->BindAttributeLocation(desc.attributes[i], desc.attributeLocations[i]);
+    }
+
+    for (unsigned i = 0; i<desc.numFragDatas; ++i) {
+        program->BindFragDataLocation(desc.fragDatas[i], desc.fragDataLocations[i]);
+    }
+
+    if (desc.numVaryings > 0) {
+        program->SetTransformFeedbackVaryings(desc.numVaryings, desc.varyings, desc.feedbackMode);
+    }
+
+    // restore from the binary
+    std::string path     = BinaryPath(desc);
+    bool        rejected = false;
+    if ( !path.empty() )
+    {
+        SGL_HRESULT result = LoadBinary(program.get(), path);
+        if (result == SGL_OK)
+        {
+            ++numHits;
+            loadTime += current_time() - startTime;
+            return program;
+        }
+
+        // unreadable file is a miss, it is overwritten with the fresh binary
+        rejected = (result != SGLERR_FILE_NOT_FOUND && result != SGLERR_IO);
+    }
+
+    // compile, shader errors are reported by the linking
+    for (unsigned i = 0; i<desc.numShaders; ++i)
+    {
+        ref_ptr<Shader> shader( device->CreateShaderAsync(desc.shaders[i]) );
+        if (!shader) {
+            return ref_ptr<Program>();
+        }
+
+        program->AddShader( shader.get() );
+    }
+
+    if ( program->Dirty() != SGL_OK ) {
+        return ref_ptr<Program>();
+    }
+
+    if ( !path.empty() ) {
+        StoreBinary(program.get(), path);
+    }
+
+    if (rejected) {
+        ++numRejected;
+    }
+    else {
+        ++numMisses;
+    }
+    compileTime += current_time() - startTime;
+
+    return program;
+}
+
+ProgramCache::STATISTICS ProgramCache::Statistics() const
+{
+    STATISTICS statistics;
+    statistics.numHits     = numHits;
+    statistics.numMisses   = numMisses;
+    statistics.numRejected = numRejected;
+    statistics.loadTime    = loadTime;
+    statistics.compileTime = compileTime;
+
+    unsigned numPrograms = numHits + numMisses + numRejected;
+    statistics.hitRate   = numPrograms > 0 ? float(numHits) / numPrograms : 0.0f;
+
+    return statistics;
+}
+
+} // namespace sgl
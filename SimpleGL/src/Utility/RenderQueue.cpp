@@ -0,0 +1,243 @@
+#include "Utility/RenderQueue.h"
+#include <cstring>
+
+namespace {
+
+    using namespace sgl;
+
+    typedef unsigned long long uint64;
+
+    // number of bits used for object ids in the key
+    const unsigned int ID_BITS = 10;
+    const unsigned int ID_MASK = (1 << ID_BITS) - 1;
+
+    // bits of the key for translucent items
+    const uint64 TRANSLUCENT_BIT = 1ULL << 63;
+
+    template<typename Map, typename Key>
+    inline uint64 dense_id(Map& map, const Key& key)
+    {
+        unsigned int id = map.insert( std::make_pair(key, (unsigned int)map.size()) ).first->second;
+        return std::min(id, ID_MASK);
+    }
+
+    // Positive floats preserve order if treated as integers
+    inline unsigned int depth_bits(float depth)
+    {
+        if ( !(depth > 0.0f) ) {
+            return 0;
+        }
+
+        unsigned int bits;
+        memcpy( &bits, &depth, sizeof(float) );
+        return bits;
+    }
+
+} // anonymous namespace
+
+namespace sgl {
+
+RenderQueue::RenderQueue() :
+    numProgramBinds(0),
+    numStateBinds(0),
+    numTextureBinds(0)
+{
+}
+
+void RenderQueue::Push(const DRAW_ITEM& item)
+{
+    sort_entry entry;
+    entry.key   = MakeKey(item);
+    entry.index = items.size();
+
+    items.push_back(item);
+    entries.push_back(entry);
+}
+
+void RenderQueue::Clear()
+{
+    items.clear();
+    entries.clear();
+    programIds.clear();
+    textureIds.clear();
+    vertexBufferIds.clear();
+    stateIds.clear();
+}
+
+uint64 RenderQueue::MakeKey(const DRAW_ITEM& item)
+{
+    state_triple states;
+    states.blendState        = item.blendState;
+    states.depthStencilState = item.depthStencilState;
+    states.rasterizerState   = item.rasterizerState;
+
+    uint64 programId = dense_id(programIds, static_cast<const void*>(item.program));
+    uint64 stateId   = dense_id(stateIds, states);
+    uint64 textureId = dense_id(textureIds, static_cast<const void*>(item.textures[0]));
+    uint64 depth     = depth_bits(item.depth);
+
+    if (item.translucent)
+    {
+        // back to front, then by objects: 1 | depth(24) | program(10) | states(10) | texture(10) | 0(9)
+        uint64 invDepth = 0xFFFFFF - (depth >> 7);
+        return TRANSLUCENT_BIT
+             | (invDepth  << 39)
+             | (programId << 29)
+             | (stateId   << 19)
+             | (textureId << 9);
+    }
+
+    // by objects, then front to back: 0 | program(10) | states(10) | texture(10) | vertex buffer(10) | depth(23)
+    uint64 vertexBufferId = dense_id(vertexBufferIds, static_cast<const void*>(item.vertexBuffer));
+    return (programId      << 53)
+         | (stateId        << 43)
+         | (textureId      << 33)
+         | (vertexBufferId << 23)
+         | (depth >> 8);
+}
+
+void RenderQueue::Sort()
+{
+    // LSD radix sort with 8 bit digits, stable, so equal keys keep submission order
+    const size_t numEntries = entries.size();
+
+    unsigned int histogram[8][256];
+    std::fill(&histogram[0][0], &histogram[0][0] + 8 * 256, 0u);
+    for (size_t i = 0; i < numEntries; ++i)
+    {
+        uint64 key = entries[i].key;
+        for (int pass = 0; pass < 8; ++pass) {
+            ++histogram[pass][(key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    swapEntries.resize(numEntries);
+    for (int pass = 0; pass < 8; ++pass)
+    {
+        // skip digit if it is equal for every key
+        unsigned int* counts = histogram[pass];
+        if ( counts[(entries[0].key >> (pass * 8)) & 0xFF] == numEntries ) {
+            continue;
+        }
+
+        unsigned int offsets[256];
+        unsigned int offset = 0;
+        for (int i = 0; i < 256; ++i)
+        {
+            offsets[i] = offset;
+            offset    += counts[i];
+        }
+
+        for (size_t i = 0; i < numEntries; ++i) {
+            swapEntries[ offsets[(entries[i].key >> (pass * 8)) & 0xFF]++ ] = entries[i];
+        }
+        entries.swap(swapEntries);
+    }
+}
+
+SGL_HRESULT RenderQueue::Submit(Device* device)
+{
+    numProgramBinds = 0;
+    numStateBinds   = 0;
+    numTextureBinds = 0;
+    if ( items.empty() ) {
+        return SGL_OK;
+    }
+
+    Sort();
+
+    const DRAW_ITEM* prev = 0;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const DRAW_ITEM& item = items[entries[i].index];
+
+        #define CHANGED(member) ( item.member && (!prev || prev->member != item.member) )
+        if ( CHANGED(program) )
+        {
+            SGL_HRESULT result = item.program->Bind();
+            if (SGL_OK != result) {
+                return result;
+            }
+            ++numProgramBinds;
+        }
+
+        if ( CHANGED(blendState) )
+        {
+            item.blendState->Bind();
+            ++numStateBinds;
+        }
+
+        if ( CHANGED(depthStencilState) )
+        {
+            item.depthStencilState->Bind();
+            ++numStateBinds;
+        }
+
+        if ( CHANGED(rasterizerState) )
+        {
+            item.rasterizerState->Bind();
+            ++numStateBinds;
+        }
+
+        for (unsigned int stage = 0; stage < NUM_TEXTURES; ++stage)
+        {
+            if ( CHANGED(textures[stage]) )
+            {
+                SGL_HRESULT result = item.textures[stage]->Bind(stage);
+                if (SGL_OK != result) {
+                    return result;
+                }
+                ++numTextureBinds;
+            }
+        }
+
+        #undef CHANGED
+
+        if ( item.vertexBuffer
+             && (!prev || prev->vertexBuffer != item.vertexBuffer || prev->vertexLayout != item.vertexLayout) )
+        {
+            item.vertexBuffer->Bind(item.vertexLayout);
+        }
+
+        if ( item.indexBuffer
+             && (!prev || prev->indexBuffer != item.indexBuffer || prev->indexFormat != item.indexFormat) )
+        {
+            item.indexBuffer->Bind(item.indexFormat);
+        }
+
+        if (item.uniforms)
+        {
+            SGL_HRESULT result = device->Execute(item.uniforms);
+            if (SGL_OK != result) {
+                return result;
+            }
+        }
+
+        switch (item.drawType)
+        {
+            case DRAW:
+                device->Draw(item.primType, item.first, item.count);
+                break;
+
+            case DRAW_INDEXED:
+                device->DrawIndexed(item.primType, item.first, item.count);
+                break;
+
+        #ifndef SIMPLE_GL_ES
+            case DRAW_INSTANCED:
+                device->DrawInstanced(item.primType, item.first, item.count, item.numInstances);
+                break;
+
+            case DRAW_INDEXED_INSTANCED:
+                device->DrawIndexedInstanced(item.primType, item.first, item.count, item.numInstances);
+                break;
+        #endif
+        }
+
+        prev = &item;
+    }
+
+    return SGL_OK;
+}
+
+} // namespace sgl
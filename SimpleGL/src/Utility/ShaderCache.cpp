@@ -0,0 +1,83 @@
+#include "Utility/ShaderCache.h"
+#include <algorithm>
+
+namespace sgl {
+
+ShaderCache::ShaderCache(Device* device_, bool async_) :
+    device(device_),
+    async(async_),
+    numRequests(0)
+{
+}
+
+ShaderCache::~ShaderCache()
+{
+}
+
+Shader* ShaderCache::GetShader( Shader::TYPE                        type,
+                                const char*                         fileName,
+                                unsigned                            numDefines,
+                                const ShaderPreprocessor::DEFINE*   defines )
+{
+    ++numRequests;
+
+    // sorted defines make the key independent of their order
+    sortedDefines.resize(numDefines);
+    for (unsigned i = 0; i<numDefines; ++i)
+    {
+        sortedDefines[i].first  = defines[i].name;
+        sortedDefines[i].second = defines[i].value ? defines[i].value : "";
+    }
+    std::sort( sortedDefines.begin(), sortedDefines.end() );
+
+    std::string key(1, char('0' + type));
+    key += fileName;
+    for (unsigned i = 0; i<numDefines; ++i)
+    {
+        key += '\n';
+        key += sortedDefines[i].first;
+        key += '=';
+        key += sortedDefines[i].second;
+    }
+
+    shader_map::const_iterator iter = shaders.find(key);
+    if ( iter != shaders.end() ) {
+        return iter->second.get();
+    }
+
+    // preprocess with the sorted defines, so equal variants have equal sources
+    std::vector<ShaderPreprocessor::DEFINE> variantDefines(numDefines);
+    for (unsigned i = 0; i<numDefines; ++i)
+    {
+        variantDefines[i].name  = sortedDefines[i].first.c_str();
+        variantDefines[i].value = sortedDefines[i].second.empty() ? 0 : sortedDefines[i].second.c_str();
+    }
+
+    if ( preprocessor.Preprocess( fileName,
+                                  numDefines,
+                                  variantDefines.empty() ? 0 : &variantDefines[0],
+                                  source ) != SGL_OK )
+    {
+        return 0;
+    }
+
+    Shader::DESC desc;
+    desc.type   = type;
+    desc.source = source.c_str();
+
+    ref_ptr<Shader> shader( async ? device->CreateShaderAsync(desc) : device->CreateShader(desc) );
+    if (!shader) {
+        return 0;
+    }
+
+    shaders.insert( shader_map::value_type(key, shader) );
+    return shader.get();
+}
+
+void ShaderCache::Clear()
+{
+    shaders.clear();
+    preprocessor.ClearFileCache();
+}
+
+} // namespace sgl
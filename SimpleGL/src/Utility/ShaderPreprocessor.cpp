@@ -0,0 +1,340 @@
+#include "Utility/ShaderPreprocessor.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+    using namespace sgl;
+
+    std::string to_string(unsigned value)
+    {
+        char buffer[16];
+        sprintf(buffer, "%u", value);
+        return buffer;
+    }
+
+    // directory of the file including trailing separator, empty if there is no directory
+    std::string directory_of(const std::string& path)
+    {
+        std::string::size_type pos = path.find_last_of("/\\");
+        return (pos == std::string::npos) ? std::string() : path.substr(0, pos + 1);
+    }
+
+    // strip leading and trailing whitespace, collapse inner whitespace into single space
+    std::string normalise_line(const std::string& line)
+    {
+        std::string result;
+        result.reserve( line.size() );
+
+        bool space = false;
+        for (size_t i = 0; i<line.size(); ++i)
+        {
+            char c = line[i];
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v') {
+                space = true;
+            }
+            else
+            {
+                if (space && !result.empty()) {
+                    result += ' ';
+                }
+                result += c;
+                space   = false;
+            }
+        }
+
+        return result;
+    }
+
+    // remove comments from the line, inBlockComment carries /* */ state between the lines
+    std::string strip_comments(const std::string& line, bool& inBlockComment)
+    {
+        std::string result;
+        result.reserve( line.size() );
+
+        for (size_t i = 0; i<line.size(); ++i)
+        {
+            if (inBlockComment)
+            {
+                if ( line.compare(i, 2, "*/") == 0 )
+                {
+                    inBlockComment = false;
+                    result        += ' ';
+                    ++i;
+                }
+            }
+            else if ( line.compare(i, 2, "/*") == 0 )
+            {
+                inBlockComment = true;
+                ++i;
+            }
+            else if ( line.compare(i, 2, "//") == 0 ) {
+                break;
+            }
+            else {
+                result += line[i];
+            }
+        }
+
+        return result;
+    }
+
+    // check whether normalised line is a directive, e.g. "# include <file>", and get its argument
+    bool parse_directive( const std::string&  line,
+                          const char*         directive,
+                          std::string&        argument )
+    {
+        if ( line.empty() || line[0] != '#' ) {
+            return false;
+        }
+
+        size_t pos = (line.size() > 1 && line[1] == ' ') ? 2 : 1;
+        size_t len = strlen(directive);
+        if ( line.compare(pos, len, directive) != 0 ) {
+            return false;
+        }
+
+        pos += len;
+        if (pos == line.size())
+        {
+            argument.clear();
+            return true;
+        }
+        else if (line[pos] == ' ')
+        {
+            argument = line.substr(pos + 1);
+            return true;
+        }
+
+        return false;
+    }
+
+    // get file name of the "file" or <file> include argument
+    bool parse_include_name(const std::string& argument, std::string& name)
+    {
+        if (argument.size() < 3) {
+            return false;
+        }
+
+        char close = (argument[0] == '"') ? '"' : (argument[0] == '<') ? '>' : 0;
+        if ( !close || argument[argument.size() - 1] != close ) {
+            return false;
+        }
+
+        name = argument.substr(1, argument.size() - 2);
+        return true;
+    }
+
+    // number of the line with #version directive, 0 if there is no one
+    unsigned find_version_line(const std::string& contents)
+    {
+        unsigned    lineNumber     = 0;
+        size_t      lineStart      = 0;
+        bool        inBlockComment = false;
+        std::string argument;
+        while ( lineStart < contents.size() )
+        {
+            size_t lineEnd = contents.find('\n', lineStart);
+            if (lineEnd == std::string::npos) {
+                lineEnd = contents.size();
+            }
+
+            std::string line = normalise_line( strip_comments(contents.substr(lineStart, lineEnd - lineStart), inBlockComment) );
+            lineStart = lineEnd + 1;
+            ++lineNumber;
+
+            if ( parse_directive(line, "version", argument) ) {
+                return lineNumber;
+            }
+        }
+
+        return 0;
+    }
+
+    void append_defines( std::string&                         source,
+                         unsigned                             numDefines,
+                         const ShaderPreprocessor::DEFINE*    defines )
+    {
+        for (unsigned i = 0; i<numDefines; ++i)
+        {
+            source += "#define ";
+            source += defines[i].name;
+            if (defines[i].value)
+            {
+                source += ' ';
+                source += defines[i].value;
+            }
+            source += '\n';
+        }
+    }
+
+} // anonymous namespace
+
+namespace sgl {
+
+ShaderPreprocessor::ShaderPreprocessor()
+{
+}
+
+ShaderPreprocessor::~ShaderPreprocessor()
+{
+}
+
+void ShaderPreprocessor::AddIncludeDirectory(const char* directory)
+{
+    std::string dir(directory);
+    if ( !dir.empty() && dir[dir.size() - 1] != '/' && dir[dir.size() - 1] != '\\' ) {
+        dir += '/';
+    }
+
+    includeDirectories.push_back(dir);
+}
+
+const std::string* ShaderPreprocessor::ReadFile(const std::string& path)
+{
+    file_map::const_iterator iter = fileCache.find(path);
+    if ( iter != fileCache.end() ) {
+        return &iter->second;
+    }
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return 0;
+    }
+
+    std::string contents;
+    {
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        contents.resize(size);
+        fseek(file, 0, SEEK_SET);
+        size_t numRead = size > 0 ? fread(&contents[0], 1, size, file) : 0;
+        contents.resize(numRead);
+        fclose(file);
+    }
+
+    return &( fileCache[path] = contents );
+}
+
+std::string ShaderPreprocessor::ResolveInclude(const std::string& includingPath, const std::string& name)
+{
+    std::string path = directory_of(includingPath) + name;
+    if ( ReadFile(path) ) {
+        return path;
+    }
+
+    for (size_t i = 0; i<includeDirectories.size(); ++i)
+    {
+        path = includeDirectories[i] + name;
+        if ( ReadFile(path) ) {
+            return path;
+        }
+    }
+
+    return std::string();
+}
+
+SGL_HRESULT ShaderPreprocessor::Preprocess( const char*     fileName,
+                                            unsigned        numDefines,
+                                            const DEFINE*   defines,
+                                            std::string&    source )
+{
+    source.clear();
+    files.clear();
+    includeStack.clear();
+    onceFiles.clear();
+
+    return ProcessFile(fileName, numDefines, defines, source);
+}
+
+SGL_HRESULT ShaderPreprocessor::ProcessFile( const std::string&   path,
+                                             unsigned             numDefines,
+                                             const DEFINE*        defines,
+                                             std::string&         source )
+{
+    if ( onceFiles.count(path) > 0 ) {
+        return SGL_OK;
+    }
+
+    if ( std::find(includeStack.begin(), includeStack.end(), path) != includeStack.end() ) {
+        return EInvalidCall( ("ShaderPreprocessor::Preprocess failed. Recursive include of the file: " + path).c_str() );
+    }
+
+    const std::string* contents = ReadFile(path);
+    if (!contents) {
+        return EFileNotFound( ("ShaderPreprocessor::Preprocess failed. Can't open file: " + path).c_str() );
+    }
+
+    // file keeps its source string number if it is included several times
+    unsigned fileIndex = std::find(files.begin(), files.end(), path) - files.begin();
+    if ( fileIndex == files.size() ) {
+        files.push_back(path);
+    }
+
+    // defines are injected into the root file after the #version, which can be preceded only
+    // by comments, or at the beginning if there is no #version
+    unsigned versionLine = includeStack.empty() ? find_version_line(*contents) : 0;
+    if (versionLine == 0)
+    {
+        append_defines(source, numDefines, defines);
+        source += "#line 1 " + to_string(fileIndex) + '\n';
+    }
+    includeStack.push_back(path);
+
+    unsigned    lineNumber     = 0;
+    size_t      lineStart      = 0;
+    bool        inBlockComment = false;
+    std::string argument;
+    std::string includeName;
+    while ( lineStart < contents->size() )
+    {
+        size_t lineEnd = contents->find('\n', lineStart);
+        if (lineEnd == std::string::npos) {
+            lineEnd = contents->size();
+        }
+
+        std::string line = normalise_line( contents->substr(lineStart, lineEnd - lineStart) );
+        lineStart = lineEnd + 1;
+        ++lineNumber;
+
+        // directives are recognised only outside of the comments
+        std::string code = normalise_line( strip_comments(line, inBlockComment) );
+        if (lineNumber == versionLine)
+        {
+            source += line + '\n';
+            append_defines(source, numDefines, defines);
+            source += "#line " + to_string(lineNumber + 1) + ' ' + to_string(fileIndex) + '\n';
+        }
+        else if ( parse_directive(code, "pragma", argument) && argument == "once" )
+        {
+            onceFiles.insert(path);
+            source += '\n';
+        }
+        else if ( parse_directive(code, "include", argument) )
+        {
+            if ( !parse_include_name(argument, includeName) ) {
+                return EInvalidCall( ("ShaderPreprocessor::Preprocess failed. Malformed include in the file: " + path).c_str() );
+            }
+
+            std::string includePath = ResolveInclude(path, includeName);
+            if ( includePath.empty() ) {
+                return EFileNotFound( ("ShaderPreprocessor::Preprocess failed. Can't find included file: " + includeName).c_str() );
+            }
+
+            SGL_HRESULT result = ProcessFile(includePath, 0, 0, source);
+            if (result != SGL_OK) {
+                return result;
+            }
+            source += "#line " + to_string(lineNumber + 1) + ' ' + to_string(fileIndex) + '\n';
+        }
+        else {
+            source += line + '\n';
+        }
+    }
+
+    includeStack.pop_back();
+    return SGL_OK;
+}
+
+} // namespace sgl
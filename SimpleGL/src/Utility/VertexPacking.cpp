@@ -0,0 +1,267 @@
+#include "Utility/VertexPacking.h"
+#include <cassert>
+#ifdef SIMPLE_GL_USE_SSE
+#   include <emmintrin.h>
+#endif
+
+namespace {
+
+    union float_bits
+    {
+        float       f;
+        unsigned    u;
+    };
+
+    // see http://fgiesen.wordpress.com/2012/03/28/half-to-float-done-quic/
+    inline unsigned short float_to_half(float value)
+    {
+        const unsigned F32_INFINITY = 255 << 23;
+        const unsigned F16_INFINITY = 31 << 23;
+        const unsigned ROUND_MASK   = ~0xfffu;
+
+        float_bits magic;
+        magic.u = 15 << 23;
+
+        float_bits f;
+        f.f = value;
+
+        unsigned sign = f.u & 0x80000000u;
+        unsigned half = 0;
+        f.u ^= sign;
+        if (f.u >= F32_INFINITY) {
+            half = (f.u > F32_INFINITY) ? 0x7e00 : 0x7c00; // NaN and infinity
+        }
+        else
+        {
+            // rebias exponent with multiplication, so denormals are handled by FPU
+            f.u &= ROUND_MASK;
+            f.f *= magic.f;
+            f.u -= ROUND_MASK;
+            if (f.u > F16_INFINITY) {
+                f.u = F16_INFINITY;
+            }
+
+            half = f.u >> 13;
+        }
+
+        return static_cast<unsigned short>( half | (sign >> 16) );
+    }
+
+    inline int float_to_snorm(float value, float scale)
+    {
+        value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+        value *= scale;
+        return static_cast<int>(value < 0.0f ? value - 0.5f : value + 0.5f);
+    }
+
+    inline unsigned float_to_unorm(float value, float scale)
+    {
+        value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+        return static_cast<unsigned>(value * scale + 0.5f);
+    }
+
+    inline unsigned pack_snorm_2_10_10_10(float x, float y, float z, float w)
+    {
+        return  ( float_to_snorm(x, 511.0f) & 0x3ff )
+             | (( float_to_snorm(y, 511.0f) & 0x3ff ) << 10)
+             | (( float_to_snorm(z, 511.0f) & 0x3ff ) << 20)
+             | (( float_to_snorm(w, 1.0f) & 0x3 ) << 30);
+    }
+
+#ifdef SIMPLE_GL_USE_SSE
+    inline __m128i float_to_half_sse(__m128 value)
+    {
+        const __m128  SIGN_MASK    = _mm_castsi128_ps( _mm_set1_epi32(int(0x80000000u)) );
+        const __m128  ROUND_MASK   = _mm_castsi128_ps( _mm_set1_epi32(int(~0xfffu)) );
+        const __m128  MAGIC        = _mm_castsi128_ps( _mm_set1_epi32(15 << 23) );
+        const __m128  CLAMP        = _mm_castsi128_ps( _mm_set1_epi32((31 << 23) - 0x1000) );
+        const __m128i F32_INFINITY = _mm_set1_epi32(255 << 23);
+        const __m128i NAN_BIT      = _mm_set1_epi32(0x200);
+        const __m128i F16_INFINITY = _mm_set1_epi32(0x7c00);
+
+        __m128  sign     = _mm_and_ps(value, SIGN_MASK);
+        __m128i absolute = _mm_castps_si128( _mm_xor_ps(value, sign) );
+        __m128i isNaN    = _mm_cmpgt_epi32(absolute, F32_INFINITY);
+        __m128i isFinite = _mm_cmpgt_epi32(F32_INFINITY, absolute);
+        __m128i infOrNaN = _mm_or_si128( _mm_and_si128(isNaN, NAN_BIT), F16_INFINITY );
+
+        // same as scalar version, but clamp before rebias
+        __m128  rounded  = _mm_and_ps(_mm_castsi128_ps(absolute), ROUND_MASK);
+        __m128  scaled   = _mm_min_ps( _mm_mul_ps(rounded, MAGIC), CLAMP );
+        __m128i biased   = _mm_sub_epi32( _mm_castps_si128(scaled), _mm_castps_si128(ROUND_MASK) );
+        __m128i finite   = _mm_and_si128( _mm_srli_epi32(biased, 13), isFinite );
+        __m128i result   = _mm_or_si128( finite, _mm_andnot_si128(isFinite, infOrNaN) );
+
+        return _mm_or_si128( result, _mm_srli_epi32(_mm_castps_si128(sign), 16) );
+    }
+
+    /* Convert clamped and scaled values to int, rounding half away from zero as scalar version does */
+    inline __m128i float_to_norm_sse(__m128 value, __m128 minValue, __m128 scale)
+    {
+        const __m128 SIGN_MASK = _mm_castsi128_ps( _mm_set1_epi32(int(0x80000000u)) );
+
+        value = _mm_max_ps( _mm_min_ps(value, _mm_set1_ps(1.0f)), minValue );
+        value = _mm_mul_ps(value, scale);
+
+        __m128 half = _mm_or_ps( _mm_and_ps(value, SIGN_MASK), _mm_set1_ps(0.5f) );
+        return _mm_cvttps_epi32( _mm_add_ps(value, half) );
+    }
+
+    /* Pack 32 bit signed values into 16 bits, works for any input on SSE2 */
+    inline __m128i pack_signed_16_sse(__m128i low, __m128i high)
+    {
+        low  = _mm_srai_epi32( _mm_slli_epi32(low, 16), 16 );
+        high = _mm_srai_epi32( _mm_slli_epi32(high, 16), 16 );
+        return _mm_packs_epi32(low, high);
+    }
+#endif // SIMPLE_GL_USE_SSE
+
+} // anonymous namespace
+
+namespace sgl {
+
+void PackHalf( unsigned short*  destination,
+               const float*     source,
+               unsigned         count )
+{
+    unsigned i = 0;
+#ifdef SIMPLE_GL_USE_SSE
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i low  = float_to_half_sse( _mm_loadu_ps(source + i) );
+        __m128i high = float_to_half_sse( _mm_loadu_ps(source + i + 4) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(destination + i), pack_signed_16_sse(low, high) );
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = float_to_half(source[i]);
+    }
+}
+
+void PackSnorm8( signed char*   destination,
+                 const float*   source,
+                 unsigned       count )
+{
+    unsigned i = 0;
+#ifdef SIMPLE_GL_USE_SSE
+    const __m128 MIN_VALUE = _mm_set1_ps(-1.0f);
+    const __m128 SCALE     = _mm_set1_ps(127.0f);
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i a = float_to_norm_sse(_mm_loadu_ps(source + i),      MIN_VALUE, SCALE);
+        __m128i b = float_to_norm_sse(_mm_loadu_ps(source + i + 4),  MIN_VALUE, SCALE);
+        __m128i c = float_to_norm_sse(_mm_loadu_ps(source + i + 8),  MIN_VALUE, SCALE);
+        __m128i d = float_to_norm_sse(_mm_loadu_ps(source + i + 12), MIN_VALUE, SCALE);
+        __m128i packed = _mm_packs_epi16( _mm_packs_epi32(a, b), _mm_packs_epi32(c, d) );
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = static_cast<signed char>( float_to_snorm(source[i], 127.0f) );
+    }
+}
+
+void PackUnorm8( unsigned char*  destination,
+                 const float*    source,
+                 unsigned        count )
+{
+    unsigned i = 0;
+#ifdef SIMPLE_GL_USE_SSE
+    const __m128 MIN_VALUE = _mm_setzero_ps();
+    const __m128 SCALE     = _mm_set1_ps(255.0f);
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i a = float_to_norm_sse(_mm_loadu_ps(source + i),      MIN_VALUE, SCALE);
+        __m128i b = float_to_norm_sse(_mm_loadu_ps(source + i + 4),  MIN_VALUE, SCALE);
+        __m128i c = float_to_norm_sse(_mm_loadu_ps(source + i + 8),  MIN_VALUE, SCALE);
+        __m128i d = float_to_norm_sse(_mm_loadu_ps(source + i + 12), MIN_VALUE, SCALE);
+        __m128i packed = _mm_packus_epi16( _mm_packs_epi32(a, b), _mm_packs_epi32(c, d) );
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = static_cast<unsigned char>( float_to_unorm(source[i], 255.0f) );
+    }
+}
+
+void PackSnorm16( short*         destination,
+                  const float*   source,
+                  unsigned       count )
+{
+    unsigned i = 0;
+#ifdef SIMPLE_GL_USE_SSE
+    const __m128 MIN_VALUE = _mm_set1_ps(-1.0f);
+    const __m128 SCALE     = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i low  = float_to_norm_sse(_mm_loadu_ps(source + i),     MIN_VALUE, SCALE);
+        __m128i high = float_to_norm_sse(_mm_loadu_ps(source + i + 4), MIN_VALUE, SCALE);
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi32(low, high) );
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = static_cast<short>( float_to_snorm(source[i], 32767.0f) );
+    }
+}
+
+void PackUnorm16( unsigned short*  destination,
+                  const float*     source,
+                  unsigned         count )
+{
+    unsigned i = 0;
+#ifdef SIMPLE_GL_USE_SSE
+    const __m128 MIN_VALUE = _mm_setzero_ps();
+    const __m128 SCALE     = _mm_set1_ps(65535.0f);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i low  = float_to_norm_sse(_mm_loadu_ps(source + i),     MIN_VALUE, SCALE);
+        __m128i high = float_to_norm_sse(_mm_loadu_ps(source + i + 4), MIN_VALUE, SCALE);
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(destination + i), pack_signed_16_sse(low, high) );
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = static_cast<unsigned short>( float_to_unorm(source[i], 65535.0f) );
+    }
+}
+
+void PackSnorm2_10_10_10( unsigned*      destination,
+                          const float*   source,
+                          unsigned       numComponents,
+                          unsigned       count )
+{
+    assert(numComponents == 3 || numComponents == 4);
+
+    unsigned i = 0;
+#ifdef SIMPLE_GL_USE_SSE
+    if (numComponents == 4)
+    {
+        const __m128  MIN_VALUE = _mm_set1_ps(-1.0f);
+        const __m128  XYZ_SCALE = _mm_set1_ps(511.0f);
+        const __m128  W_SCALE   = _mm_set1_ps(1.0f);
+        const __m128i XYZ_MASK  = _mm_set1_epi32(0x3ff);
+        const __m128i W_MASK    = _mm_set1_epi32(0x3);
+        for (; i + 4 <= count; i += 4)
+        {
+            // transpose 4 vectors, so every register contains single component of them
+            __m128 x = _mm_loadu_ps(source + i * 4);
+            __m128 y = _mm_loadu_ps(source + i * 4 + 4);
+            __m128 z = _mm_loadu_ps(source + i * 4 + 8);
+            __m128 w = _mm_loadu_ps(source + i * 4 + 12);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+
+            __m128i packed = _mm_and_si128( float_to_norm_sse(x, MIN_VALUE, XYZ_SCALE), XYZ_MASK );
+            packed = _mm_or_si128( packed, _mm_slli_epi32(_mm_and_si128(float_to_norm_sse(y, MIN_VALUE, XYZ_SCALE), XYZ_MASK), 10) );
+            packed = _mm_or_si128( packed, _mm_slli_epi32(_mm_and_si128(float_to_norm_sse(z, MIN_VALUE, XYZ_SCALE), XYZ_MASK), 20) );
+            packed = _mm_or_si128( packed, _mm_slli_epi32(_mm_and_si128(float_to_norm_sse(w, MIN_VALUE, W_SCALE), W_MASK), 30) );
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const float* v = source + i * numComponents;
+        destination[i] = pack_snorm_2_10_10_10( v[0], v[1], v[2], numComponents == 4 ? v[3] : 0.0f );
+    }
+}
+
+} // namespace sgl